@@ -31,43 +31,112 @@
 
 #include "Common.hpp"
 #include <algorithm> // for remove_if
+#include <functional> // for hash
+#include <unordered_map>
+#include <type_traits>
+#include <memory> // for unique_ptr
+#include <utility> // for forward, move
+#if (__cplusplus >= 201703L) || (defined(_MSVC_LANG) && (_MSVC_LANG >= 201703L))
+#include <string_view>
+#define PLINTH_INDEXEDMAP_STRING_VIEW
+#endif
 
 namespace plinth
 {
 
-template <class KeyT, class T>
+// if isStableT is true, each value is allocated separately so its address never changes while it is in the map (references and pointers to it remain valid when other elements are added or removed)
+template <class KeyT, class T, bool isStableT = false>
 class IndexedMap
 {
 public:
+	// stays attached to its element when other elements are added or removed (unlike an index). becomes invalid when its element is removed
+	struct Handle
+	{
+		std::size_t slot{ static_cast<std::size_t>(-1) };
+		std::size_t generation{ 0_uz };
+	};
+
 	IndexedMap();
-	void add(const KeyT& key, const T& value);
-	void add(const T& value);
+	Handle add(const KeyT& key, const T& value);
+	Handle add(const T& value);
+	Handle add(const KeyT& key, T&& value);
+	Handle add(T&& value);
+	template <class... ArgsT>
+	Handle emplace(const KeyT& key, ArgsT&&... args); // value is constructed in place from args
+	void reserve(std::size_t size);
 	void remove(const KeyT& key);
 	void remove(std::size_t index);
 	T get(const KeyT& key) const;
 	T get(std::size_t index) const;
 	T& access(const KeyT& key);
 	T& access(std::size_t index);
+	const T& access(const KeyT& key) const;
+	const T& access(std::size_t index) const;
+	T* getPointer(const KeyT& key); // returns nullptr if not found
+	const T* getPointer(const KeyT& key) const; // returns nullptr if not found
 	bool valid(const KeyT& key) const;
 	bool valid(std::size_t index) const;
 	void set(const KeyT& key, const T& value);
 	void set(std::size_t index, const T& value);
+	void set(std::size_t index, T&& value);
 	void setKey(std::size_t index, const KeyT& key);
 	KeyT getKey(std::size_t index) const;
 	std::size_t getSize() const;
 	void clear();
 
+	// lookups by key are hashed. if multiple elements share a key, the one with the lowest index is used
+	std::size_t find(const KeyT& key) const; // returns index (or getSize() if not found)
+#ifdef PLINTH_INDEXEDMAP_STRING_VIEW
+	template <class LookupKeyT, class = typename std::enable_if<std::is_convertible<const LookupKeyT&, std::string_view>::value && !std::is_same<LookupKeyT, KeyT>::value && std::is_same<KeyT, std::string>::value>::type>
+	std::size_t find(const LookupKeyT& key) const; // heterogeneous lookup (e.g. string_view or string literal) without creating a key. returns index (or getSize() if not found)
+#endif
+
+	Handle getHandle(const KeyT& key) const;
+	Handle getHandle(std::size_t index) const;
+	T get(Handle handle) const;
+	T& access(Handle handle);
+	const T& access(Handle handle) const;
+	T* getPointer(Handle handle); // returns nullptr if handle is invalid
+	const T* getPointer(Handle handle) const; // returns nullptr if handle is invalid
+	bool valid(Handle handle) const;
+	std::size_t getIndex(Handle handle) const;
+
 private:
 	const std::string m_exceptionPrefix;
 
+	using StoredT = typename std::conditional<isStableT, std::unique_ptr<T>, T>::type;
 	struct Element
 	{
 		KeyT key;
-		T value;
+		StoredT value;
+		std::size_t slot;
+	};
+	struct Slot
+	{
+		std::size_t index;
+		std::size_t generation;
 	};
 	std::vector<Element> m_elements;
+	std::vector<Slot> m_slots;
+	std::vector<std::size_t> m_freeSlots;
+	std::unordered_multimap<std::size_t, std::size_t> m_keyIndices; // key hash -> element index
 
 	bool priv_indexIsValid(std::size_t index) const;
+	template <class LookupKeyT>
+	std::size_t priv_findIndex(std::size_t keyHash, const LookupKeyT& key) const;
+	Handle priv_makeHandle(std::size_t slot) const;
+	Handle priv_add(const KeyT& key, StoredT&& value);
+	template <class... ArgsT>
+	static StoredT priv_createValue(std::true_type isStable, ArgsT&&... args);
+	template <class... ArgsT>
+	static StoredT priv_createValue(std::false_type isStable, ArgsT&&... args);
+	static T& priv_value(T& value);
+	static const T& priv_value(const T& value);
+	static T& priv_value(std::unique_ptr<T>& value);
+	static const T& priv_value(const std::unique_ptr<T>& value);
+	std::size_t priv_acquireSlot(std::size_t index);
+	void priv_releaseSlot(std::size_t slot);
+	void priv_rebuildIndices();
 };
 
 } // namespace plinth
@@ -34,126 +34,203 @@
 namespace plinth
 {
 
-template <class KeyT, class T>
-inline IndexedMap<KeyT, T>::IndexedMap()
+template <class KeyT, class T, bool isStableT>
+inline IndexedMap<KeyT, T, isStableT>::IndexedMap()
 	: m_exceptionPrefix{ "Indexed Map: " }
 	, m_elements{}
+	, m_slots{}
+	, m_freeSlots{}
+	, m_keyIndices{}
 {
 }
 
-template <class KeyT, class T>
-inline void IndexedMap<KeyT, T>::add(const KeyT& key, const T& value)
+template <class KeyT, class T, bool isStableT>
+inline typename IndexedMap<KeyT, T, isStableT>::Handle IndexedMap<KeyT, T, isStableT>::add(const KeyT& key, const T& value)
 {
-	m_elements.push_back(Element{ key, value });
+	return priv_add(key, priv_createValue(std::integral_constant<bool, isStableT>{}, value));
 }
 
-template <class KeyT, class T>
-inline void IndexedMap<KeyT, T>::add(const T& value)
+template <class KeyT, class T, bool isStableT>
+inline typename IndexedMap<KeyT, T, isStableT>::Handle IndexedMap<KeyT, T, isStableT>::add(const T& value)
 {
-	add("", value);
+	return add("", value);
 }
 
-template <class KeyT, class T>
-inline void IndexedMap<KeyT, T>::remove(const KeyT& key)
+template <class KeyT, class T, bool isStableT>
+inline typename IndexedMap<KeyT, T, isStableT>::Handle IndexedMap<KeyT, T, isStableT>::add(const KeyT& key, T&& value)
 {
+	return priv_add(key, priv_createValue(std::integral_constant<bool, isStableT>{}, std::move(value)));
+}
+
+template <class KeyT, class T, bool isStableT>
+inline typename IndexedMap<KeyT, T, isStableT>::Handle IndexedMap<KeyT, T, isStableT>::add(T&& value)
+{
+	return add("", std::move(value));
+}
+
+template <class KeyT, class T, bool isStableT>
+template <class... ArgsT>
+inline typename IndexedMap<KeyT, T, isStableT>::Handle IndexedMap<KeyT, T, isStableT>::emplace(const KeyT& key, ArgsT&&... args)
+{
+	return priv_add(key, priv_createValue(std::integral_constant<bool, isStableT>{}, std::forward<ArgsT>(args)...));
+}
+
+template <class KeyT, class T, bool isStableT>
+inline void IndexedMap<KeyT, T, isStableT>::reserve(const std::size_t size)
+{
+	m_elements.reserve(size);
+	m_slots.reserve(size);
+	m_keyIndices.reserve(size);
+}
+
+template <class KeyT, class T, bool isStableT>
+inline void IndexedMap<KeyT, T, isStableT>::remove(const KeyT& key)
+{
+	if (find(key) == m_elements.size())
+		return;
+
 	m_elements.erase(std::remove_if(m_elements.begin(), m_elements.end(),
-		[&key](const Element& element)
+		[this, &key](const Element& element)
 		{
-			return element.key == key;
+			if (element.key != key)
+				return false;
+			priv_releaseSlot(element.slot);
+			return true;
 		}),
 		m_elements.end());
+	priv_rebuildIndices();
+}
+
+template <class KeyT, class T, bool isStableT>
+inline void IndexedMap<KeyT, T, isStableT>::remove(const std::size_t index)
+{
+	if (!priv_indexIsValid(index))
+		return;
+
+	priv_releaseSlot(m_elements[index].slot);
+	m_elements.erase(m_elements.begin() + index);
+	priv_rebuildIndices();
 }
 
-template <class KeyT, class T>
-inline void IndexedMap<KeyT, T>::remove(const std::size_t index)
+template <class KeyT, class T, bool isStableT>
+inline T IndexedMap<KeyT, T, isStableT>::get(const KeyT& key) const
 {
+	const std::size_t index{ find(key) };
 	if (priv_indexIsValid(index))
-		m_elements.erase(m_elements.begin() + index);
+		return priv_value(m_elements[index].value);
+	else
+		throw Exception(m_exceptionPrefix + "Key not found.");
 }
 
-template <class KeyT, class T>
-inline T IndexedMap<KeyT, T>::get(const KeyT& key) const
+template <class KeyT, class T, bool isStableT>
+inline T IndexedMap<KeyT, T, isStableT>::get(const std::size_t index) const
 {
-	for (auto& element : m_elements)
-	{
-		if (element.key == key)
-			return element.value;
-	}
-	throw Exception(m_exceptionPrefix + "Key not found.");
+	if (priv_indexIsValid(index))
+		return priv_value(m_elements[index].value);
+	else
+		throw Exception(m_exceptionPrefix + "Index out of range.");
 }
 
-template <class KeyT, class T>
-inline T IndexedMap<KeyT, T>::get(const std::size_t index) const
+template <class KeyT, class T, bool isStableT>
+inline T& IndexedMap<KeyT, T, isStableT>::access(const KeyT& key)
 {
+	const std::size_t index{ find(key) };
 	if (priv_indexIsValid(index))
-		return m_elements[index].value;
+		return priv_value(m_elements[index].value);
+	else
+		throw Exception(m_exceptionPrefix + "Key not found.");
+}
+
+template <class KeyT, class T, bool isStableT>
+inline T& IndexedMap<KeyT, T, isStableT>::access(const std::size_t index)
+{
+	if (priv_indexIsValid(index))
+		return priv_value(m_elements[index].value);
 	else
 		throw Exception(m_exceptionPrefix + "Index out of range.");
 }
 
-template <class KeyT, class T>
-inline T& IndexedMap<KeyT, T>::access(const KeyT& key)
+template <class KeyT, class T, bool isStableT>
+inline const T& IndexedMap<KeyT, T, isStableT>::access(const KeyT& key) const
 {
-	for (auto& element : m_elements)
-	{
-		if (element.key == key)
-			return element.value;
-	}
-	throw Exception(m_exceptionPrefix + "Key not found.");
+	const std::size_t index{ find(key) };
+	if (priv_indexIsValid(index))
+		return priv_value(m_elements[index].value);
+	else
+		throw Exception(m_exceptionPrefix + "Key not found.");
 }
 
-template <class KeyT, class T>
-inline T& IndexedMap<KeyT, T>::access(const std::size_t index)
+template <class KeyT, class T, bool isStableT>
+inline const T& IndexedMap<KeyT, T, isStableT>::access(const std::size_t index) const
 {
 	if (priv_indexIsValid(index))
-		return m_elements[index].value;
+		return priv_value(m_elements[index].value);
 	else
 		throw Exception(m_exceptionPrefix + "Index out of range.");
 }
 
-template <class KeyT, class T>
-inline bool IndexedMap<KeyT, T>::valid(const KeyT& key) const
+template <class KeyT, class T, bool isStableT>
+inline T* IndexedMap<KeyT, T, isStableT>::getPointer(const KeyT& key)
 {
-	for (auto& element : m_elements)
-	{
-		if (element.key == key)
-			return true;
-	}
-	return false;
+	const std::size_t index{ find(key) };
+	return priv_indexIsValid(index) ? &priv_value(m_elements[index].value) : nullptr;
 }
 
-template <class KeyT, class T>
-inline bool IndexedMap<KeyT, T>::valid(const std::size_t index) const
+template <class KeyT, class T, bool isStableT>
+inline const T* IndexedMap<KeyT, T, isStableT>::getPointer(const KeyT& key) const
+{
+	const std::size_t index{ find(key) };
+	return priv_indexIsValid(index) ? &priv_value(m_elements[index].value) : nullptr;
+}
+
+template <class KeyT, class T, bool isStableT>
+inline bool IndexedMap<KeyT, T, isStableT>::valid(const KeyT& key) const
+{
+	return priv_indexIsValid(find(key));
+}
+
+template <class KeyT, class T, bool isStableT>
+inline bool IndexedMap<KeyT, T, isStableT>::valid(const std::size_t index) const
 {
 	return priv_indexIsValid(index);
 }
 
-template <class KeyT, class T>
-inline void IndexedMap<KeyT, T>::set(const KeyT& key, const T& value)
+template <class KeyT, class T, bool isStableT>
+inline void IndexedMap<KeyT, T, isStableT>::set(const KeyT& key, const T& value)
 {
 	for (auto& element : m_elements)
 	{
 		if (element.key == key)
-			element.value = value;
+			priv_value(element.value) = value;
 	}
 }
 
-template <class KeyT, class T>
-inline void IndexedMap<KeyT, T>::set(const std::size_t index, const T& value)
+template <class KeyT, class T, bool isStableT>
+inline void IndexedMap<KeyT, T, isStableT>::set(const std::size_t index, const T& value)
 {
 	if (priv_indexIsValid(index))
-		m_elements[index].value = value;
+		priv_value(m_elements[index].value) = value;
 }
 
-template <class KeyT, class T>
-inline void IndexedMap<KeyT, T>::setKey(const std::size_t index, const KeyT& key)
+template <class KeyT, class T, bool isStableT>
+inline void IndexedMap<KeyT, T, isStableT>::set(const std::size_t index, T&& value)
 {
 	if (priv_indexIsValid(index))
-		m_elements[index].key = key;
+		priv_value(m_elements[index].value) = std::move(value);
+}
+
+template <class KeyT, class T, bool isStableT>
+inline void IndexedMap<KeyT, T, isStableT>::setKey(const std::size_t index, const KeyT& key)
+{
+	if (!priv_indexIsValid(index))
+		return;
+
+	m_elements[index].key = key;
+	priv_rebuildIndices();
 }
 
-template <class KeyT, class T>
-inline KeyT IndexedMap<KeyT, T>::getKey(const std::size_t index) const
+template <class KeyT, class T, bool isStableT>
+inline KeyT IndexedMap<KeyT, T, isStableT>::getKey(const std::size_t index) const
 {
 	if (priv_indexIsValid(index))
 		return m_elements[index].key;
@@ -161,23 +238,220 @@ inline KeyT IndexedMap<KeyT, T>::getKey(const std::size_t index) const
 		throw Exception(m_exceptionPrefix + "Index out of range.");
 }
 
-template <class KeyT, class T>
-inline std::size_t IndexedMap<KeyT, T>::getSize() const
+template <class KeyT, class T, bool isStableT>
+inline std::size_t IndexedMap<KeyT, T, isStableT>::getSize() const
 {
 	return m_elements.size();
 }
 
-template <class KeyT, class T>
-inline void IndexedMap<KeyT, T>::clear()
+template <class KeyT, class T, bool isStableT>
+inline void IndexedMap<KeyT, T, isStableT>::clear()
 {
+	for (auto& element : m_elements)
+		priv_releaseSlot(element.slot);
 	m_elements.clear();
+	m_keyIndices.clear();
+}
+
+template <class KeyT, class T, bool isStableT>
+inline std::size_t IndexedMap<KeyT, T, isStableT>::find(const KeyT& key) const
+{
+	return priv_findIndex(std::hash<KeyT>{}(key), key);
+}
+
+#ifdef PLINTH_INDEXEDMAP_STRING_VIEW
+template <class KeyT, class T, bool isStableT>
+template <class LookupKeyT, class>
+inline std::size_t IndexedMap<KeyT, T, isStableT>::find(const LookupKeyT& key) const
+{
+	const std::string_view keyView{ key };
+	return priv_findIndex(std::hash<std::string_view>{}(keyView), keyView); // hash of a string_view is equal to the hash of the equivalent string
+}
+#endif
+
+template <class KeyT, class T, bool isStableT>
+inline typename IndexedMap<KeyT, T, isStableT>::Handle IndexedMap<KeyT, T, isStableT>::getHandle(const KeyT& key) const
+{
+	const std::size_t index{ find(key) };
+	if (priv_indexIsValid(index))
+		return getHandle(index);
+	else
+		throw Exception(m_exceptionPrefix + "Key not found.");
+}
+
+template <class KeyT, class T, bool isStableT>
+inline typename IndexedMap<KeyT, T, isStableT>::Handle IndexedMap<KeyT, T, isStableT>::getHandle(const std::size_t index) const
+{
+	if (!priv_indexIsValid(index))
+		throw Exception(m_exceptionPrefix + "Index out of range.");
+	const std::size_t slot{ m_elements[index].slot };
+	return priv_makeHandle(slot);
+}
+
+template <class KeyT, class T, bool isStableT>
+inline T IndexedMap<KeyT, T, isStableT>::get(const Handle handle) const
+{
+	if (valid(handle))
+		return priv_value(m_elements[m_slots[handle.slot].index].value);
+	else
+		throw Exception(m_exceptionPrefix + "Invalid handle.");
+}
+
+template <class KeyT, class T, bool isStableT>
+inline T& IndexedMap<KeyT, T, isStableT>::access(const Handle handle)
+{
+	if (valid(handle))
+		return priv_value(m_elements[m_slots[handle.slot].index].value);
+	else
+		throw Exception(m_exceptionPrefix + "Invalid handle.");
+}
+
+template <class KeyT, class T, bool isStableT>
+inline const T& IndexedMap<KeyT, T, isStableT>::access(const Handle handle) const
+{
+	if (valid(handle))
+		return priv_value(m_elements[m_slots[handle.slot].index].value);
+	else
+		throw Exception(m_exceptionPrefix + "Invalid handle.");
+}
+
+template <class KeyT, class T, bool isStableT>
+inline T* IndexedMap<KeyT, T, isStableT>::getPointer(const Handle handle)
+{
+	return valid(handle) ? &priv_value(m_elements[m_slots[handle.slot].index].value) : nullptr;
+}
+
+template <class KeyT, class T, bool isStableT>
+inline const T* IndexedMap<KeyT, T, isStableT>::getPointer(const Handle handle) const
+{
+	return valid(handle) ? &priv_value(m_elements[m_slots[handle.slot].index].value) : nullptr;
+}
+
+template <class KeyT, class T, bool isStableT>
+inline bool IndexedMap<KeyT, T, isStableT>::valid(const Handle handle) const
+{
+	return (handle.slot < m_slots.size()) && (m_slots[handle.slot].generation == handle.generation) && priv_indexIsValid(m_slots[handle.slot].index);
+}
+
+template <class KeyT, class T, bool isStableT>
+inline std::size_t IndexedMap<KeyT, T, isStableT>::getIndex(const Handle handle) const
+{
+	if (valid(handle))
+		return m_slots[handle.slot].index;
+	else
+		throw Exception(m_exceptionPrefix + "Invalid handle.");
 }
 
 // PRIVATE
-template <class KeyT, class T>
-inline bool IndexedMap<KeyT, T>::priv_indexIsValid(const std::size_t index) const
+template <class KeyT, class T, bool isStableT>
+inline bool IndexedMap<KeyT, T, isStableT>::priv_indexIsValid(const std::size_t index) const
 {
 	return index < m_elements.size();
 }
 
+template <class KeyT, class T, bool isStableT>
+template <class LookupKeyT>
+inline std::size_t IndexedMap<KeyT, T, isStableT>::priv_findIndex(const std::size_t keyHash, const LookupKeyT& key) const
+{
+	std::size_t index{ m_elements.size() };
+	const auto range = m_keyIndices.equal_range(keyHash);
+	for (auto it{ range.first }; it != range.second; ++it)
+	{
+		if ((it->second < index) && (m_elements[it->second].key == key))
+			index = it->second;
+	}
+	return index;
+}
+
+template <class KeyT, class T, bool isStableT>
+inline typename IndexedMap<KeyT, T, isStableT>::Handle IndexedMap<KeyT, T, isStableT>::priv_makeHandle(const std::size_t slot) const
+{
+	Handle handle; // default member initialisers stop Handle being an aggregate in C++11
+	handle.slot = slot;
+	handle.generation = m_slots[slot].generation;
+	return handle;
+}
+
+template <class KeyT, class T, bool isStableT>
+inline typename IndexedMap<KeyT, T, isStableT>::Handle IndexedMap<KeyT, T, isStableT>::priv_add(const KeyT& key, StoredT&& value)
+{
+	const std::size_t index{ m_elements.size() };
+	const std::size_t slot{ priv_acquireSlot(index) };
+	m_elements.push_back(Element{ key, std::move(value), slot });
+	m_keyIndices.emplace(std::hash<KeyT>{}(key), index);
+	return priv_makeHandle(slot);
+}
+
+template <class KeyT, class T, bool isStableT>
+template <class... ArgsT>
+inline typename IndexedMap<KeyT, T, isStableT>::StoredT IndexedMap<KeyT, T, isStableT>::priv_createValue(std::true_type, ArgsT&&... args)
+{
+	return StoredT(new T(std::forward<ArgsT>(args)...));
+}
+
+template <class KeyT, class T, bool isStableT>
+template <class... ArgsT>
+inline typename IndexedMap<KeyT, T, isStableT>::StoredT IndexedMap<KeyT, T, isStableT>::priv_createValue(std::false_type, ArgsT&&... args)
+{
+	return StoredT(std::forward<ArgsT>(args)...);
+}
+
+template <class KeyT, class T, bool isStableT>
+inline T& IndexedMap<KeyT, T, isStableT>::priv_value(T& value)
+{
+	return value;
+}
+
+template <class KeyT, class T, bool isStableT>
+inline const T& IndexedMap<KeyT, T, isStableT>::priv_value(const T& value)
+{
+	return value;
+}
+
+template <class KeyT, class T, bool isStableT>
+inline T& IndexedMap<KeyT, T, isStableT>::priv_value(std::unique_ptr<T>& value)
+{
+	return *value;
+}
+
+template <class KeyT, class T, bool isStableT>
+inline const T& IndexedMap<KeyT, T, isStableT>::priv_value(const std::unique_ptr<T>& value)
+{
+	return *value;
+}
+
+template <class KeyT, class T, bool isStableT>
+inline std::size_t IndexedMap<KeyT, T, isStableT>::priv_acquireSlot(const std::size_t index)
+{
+	if (m_freeSlots.empty())
+	{
+		m_slots.push_back(Slot{ index, 0_uz });
+		return m_slots.size() - 1_uz;
+	}
+	const std::size_t slot{ m_freeSlots.back() };
+	m_freeSlots.pop_back();
+	m_slots[slot].index = index;
+	return slot;
+}
+
+template <class KeyT, class T, bool isStableT>
+inline void IndexedMap<KeyT, T, isStableT>::priv_releaseSlot(const std::size_t slot)
+{
+	++m_slots[slot].generation; // invalidates any handles to this slot
+	m_slots[slot].index = static_cast<std::size_t>(-1);
+	m_freeSlots.push_back(slot);
+}
+
+template <class KeyT, class T, bool isStableT>
+inline void IndexedMap<KeyT, T, isStableT>::priv_rebuildIndices()
+{
+	m_keyIndices.clear();
+	m_keyIndices.reserve(m_elements.size());
+	for (std::size_t i{ 0_uz }; i < m_elements.size(); ++i)
+	{
+		m_slots[m_elements[i].slot].index = i;
+		m_keyIndices.emplace(std::hash<KeyT>{}(m_elements[i].key), i);
+	}
+}
+
 } // namespace plinth
@@ -0,0 +1,112 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// Plinth
+//
+// Copyright(c) 2014-2025 M.J.Silk
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions :
+//
+// 1. The origin of this software must not be misrepresented; you must not
+// claim that you wrote the original software.If you use this software
+// in a product, an acknowledgment in the product documentation would be
+// appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not be
+// misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+// M.J.Silk
+// MJSilk2@gmail.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+
+// REQUIRES C++17
+
+#pragma once
+
+#include "Common.hpp"
+#include <unordered_map>
+#include <mutex>
+#include <memory>
+#include <utility> // for pair
+#include <cstdint>
+
+namespace plinth
+{
+
+// read-only archive of named files. opening memory-maps the pack so uncompressed entries are accessed directly (without copying).
+// format (little-endian): "PLPK", version (u32), number of entries (u32), table of contents size (u32), table of contents, data
+// table of contents entry: offset (u64), stored size (u64), size (u64), compression (u32), name length (u32), name
+// each entry's data is aligned to ResourcePack::dataAlignment bytes from the start of the pack
+class ResourcePack
+{
+public:
+	static constexpr std::size_t dataAlignment{ 16_uz };
+
+	enum class Compression
+	{
+		None,
+		Lz, // byte-oriented LZ77 (fast decompression). only used if it makes the entry smaller
+	};
+
+	struct Entry
+	{
+		std::string name;
+		std::size_t offset;
+		std::size_t storedSize;
+		std::size_t size;
+		Compression compression;
+	};
+
+	ResourcePack();
+	~ResourcePack();
+	ResourcePack(const ResourcePack&) = delete;
+	ResourcePack& operator=(const ResourcePack&) = delete;
+
+	bool open(const std::string& filename); // returns false if file cannot be mapped or is not a valid pack
+	void close(); // any data pointers previously returned become invalid
+	bool isOpen() const;
+
+	std::size_t getNumberOfEntries() const;
+	const Entry& getEntry(std::size_t index) const;
+	std::size_t find(const std::string& name) const; // returns index (or getNumberOfEntries() if not found)
+	bool has(const std::string& name) const;
+	const void* getData(std::size_t index, std::size_t& size); // compressed entries are decompressed once and kept until closed. thread-safe. returns nullptr if the index is invalid or the data is corrupt
+	const void* getData(const std::string& name, std::size_t& size); // returns nullptr if not found
+
+	// packer: creates a pack file. names are paths relative to the directory using '/' as separator
+	static bool create(const std::string& packFilename, const std::string& directory, Compression compression = Compression::None); // packs all files in directory (recursively)
+	static bool create(const std::string& packFilename, const std::vector<std::pair<std::string, std::string>>& files, Compression compression = Compression::None); // files are pairs of (name, filename)
+
+	static void compress(const unsigned char* data, std::size_t size, std::vector<unsigned char>& compressed);
+	static bool decompress(const unsigned char* compressed, std::size_t compressedSize, unsigned char* data, std::size_t size); // size must be the exact decompressed size. returns false if compressed data is invalid
+
+private:
+	const unsigned char* m_data;
+	std::size_t m_size;
+	void* m_fileHandle; // only used on Windows
+	void* m_mappingHandle; // only used on Windows
+	std::vector<Entry> m_entries;
+	std::unordered_map<std::string, std::size_t> m_indices;
+	std::unordered_map<std::size_t, std::unique_ptr<unsigned char[]>> m_decompressed;
+	std::mutex m_decompressedMutex;
+
+	bool priv_map(const std::string& filename);
+	void priv_unmap();
+	bool priv_readTableOfContents();
+	static std::uint32_t priv_readU32(const unsigned char* bytes);
+	static std::uint64_t priv_readU64(const unsigned char* bytes);
+	static void priv_writeU32(std::vector<unsigned char>& bytes, std::uint32_t value);
+	static void priv_writeU64(std::vector<unsigned char>& bytes, std::uint64_t value);
+};
+
+} // namespace plinth
+#include "ResourcePack.inl"
@@ -0,0 +1,489 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// Plinth
+//
+// Copyright(c) 2014-2025 M.J.Silk
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions :
+//
+// 1. The origin of this software must not be misrepresented; you must not
+// claim that you wrote the original software.If you use this software
+// in a product, an acknowledgment in the product documentation would be
+// appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not be
+// misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+// M.J.Silk
+// MJSilk2@gmail.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once
+
+#include "ResourcePack.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <algorithm> // for sort
+#include <cstring> // for memcpy
+
+#ifdef _WIN32
+#include <windows.h>
+#ifdef min
+#undef min
+#endif // min
+#ifdef max
+#undef max
+#endif // max
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif // _WIN32
+
+namespace plinth
+{
+
+inline ResourcePack::ResourcePack()
+	: m_data{ nullptr }
+	, m_size{ 0_uz }
+	, m_fileHandle{ nullptr }
+	, m_mappingHandle{ nullptr }
+	, m_entries{}
+	, m_indices{}
+	, m_decompressed{}
+	, m_decompressedMutex{}
+{
+}
+
+inline ResourcePack::~ResourcePack()
+{
+	close();
+}
+
+inline bool ResourcePack::open(const std::string& filename)
+{
+	close();
+	if (!priv_map(filename))
+		return false;
+	if (!priv_readTableOfContents())
+	{
+		close();
+		return false;
+	}
+	return true;
+}
+
+inline void ResourcePack::close()
+{
+	priv_unmap();
+	m_entries.clear();
+	m_indices.clear();
+	std::lock_guard<std::mutex> lock(m_decompressedMutex);
+	m_decompressed.clear();
+}
+
+inline bool ResourcePack::isOpen() const
+{
+	return m_data != nullptr;
+}
+
+inline std::size_t ResourcePack::getNumberOfEntries() const
+{
+	return m_entries.size();
+}
+
+inline const ResourcePack::Entry& ResourcePack::getEntry(const std::size_t index) const
+{
+	if (index < m_entries.size())
+		return m_entries[index];
+	else
+		throw Exception("Resource Pack: Index out of range.");
+}
+
+inline std::size_t ResourcePack::find(const std::string& name) const
+{
+	const auto it = m_indices.find(name);
+	return (it == m_indices.end()) ? m_entries.size() : it->second;
+}
+
+inline bool ResourcePack::has(const std::string& name) const
+{
+	return m_indices.find(name) != m_indices.end();
+}
+
+inline const void* ResourcePack::getData(const std::size_t index, std::size_t& size)
+{
+	size = 0_uz;
+	if (index >= m_entries.size())
+		return nullptr;
+
+	const Entry& entry{ m_entries[index] };
+	const unsigned char* stored{ m_data + entry.offset };
+	if (entry.compression == Compression::None)
+	{
+		size = entry.size;
+		return stored;
+	}
+
+	std::lock_guard<std::mutex> lock(m_decompressedMutex);
+	auto it = m_decompressed.find(index);
+	if (it == m_decompressed.end())
+	{
+		std::unique_ptr<unsigned char[]> data{ new unsigned char[std::max(entry.size, 1_uz)] };
+		if (!decompress(stored, entry.storedSize, data.get(), entry.size))
+			return nullptr;
+		it = m_decompressed.emplace(index, std::move(data)).first;
+	}
+	size = entry.size;
+	return it->second.get();
+}
+
+inline const void* ResourcePack::getData(const std::string& name, std::size_t& size)
+{
+	return getData(find(name), size);
+}
+
+inline bool ResourcePack::create(const std::string& packFilename, const std::string& directory, const Compression compression)
+{
+	std::vector<std::pair<std::string, std::string>> files;
+	std::error_code errorCode{};
+	for (std::filesystem::recursive_directory_iterator it{ directory, errorCode }, end{}; (it != end) && !errorCode; it.increment(errorCode))
+	{
+		if (it->is_regular_file())
+			files.emplace_back(it->path().lexically_relative(directory).generic_string(), it->path().string());
+	}
+	if (errorCode)
+		return false;
+	std::sort(files.begin(), files.end()); // consistent order regardless of file system
+	return create(packFilename, files, compression);
+}
+
+inline bool ResourcePack::create(const std::string& packFilename, const std::vector<std::pair<std::string, std::string>>& files, const Compression compression)
+{
+	struct PackedFile
+	{
+		std::vector<unsigned char> data;
+		std::size_t size;
+		Compression compression;
+	};
+	std::vector<PackedFile> packedFiles(files.size());
+	for (std::size_t i{ 0_uz }; i < files.size(); ++i)
+	{
+		std::ifstream file(files[i].second, std::ios::in | std::ios::binary);
+		if (!file.is_open())
+			return false;
+		PackedFile& packedFile{ packedFiles[i] };
+		packedFile.data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+		packedFile.size = packedFile.data.size();
+		packedFile.compression = Compression::None;
+		if (compression == Compression::Lz)
+		{
+			std::vector<unsigned char> compressed;
+			compress(packedFile.data.data(), packedFile.data.size(), compressed);
+			if (compressed.size() < packedFile.data.size())
+			{
+				packedFile.data.swap(compressed);
+				packedFile.compression = Compression::Lz;
+			}
+		}
+	}
+
+	// table of contents size is needed before offsets can be calculated
+	std::size_t tableOfContentsSize{ 0_uz };
+	for (const auto& file : files)
+		tableOfContentsSize += 32_uz + file.first.size();
+	const std::size_t headerSize{ 16_uz };
+	auto align = [](const std::size_t offset) { return (offset + dataAlignment - 1_uz) / dataAlignment * dataAlignment; };
+
+	std::vector<unsigned char> header;
+	header.insert(header.end(), { 'P', 'L', 'P', 'K' });
+	priv_writeU32(header, 1u);
+	priv_writeU32(header, static_cast<std::uint32_t>(files.size()));
+	priv_writeU32(header, static_cast<std::uint32_t>(tableOfContentsSize));
+	std::size_t offset{ align(headerSize + tableOfContentsSize) };
+	std::vector<std::size_t> offsets(files.size());
+	for (std::size_t i{ 0_uz }; i < files.size(); ++i)
+	{
+		offsets[i] = offset;
+		priv_writeU64(header, offset);
+		priv_writeU64(header, packedFiles[i].data.size());
+		priv_writeU64(header, packedFiles[i].size);
+		priv_writeU32(header, static_cast<std::uint32_t>(packedFiles[i].compression));
+		priv_writeU32(header, static_cast<std::uint32_t>(files[i].first.size()));
+		header.insert(header.end(), files[i].first.begin(), files[i].first.end());
+		offset = align(offset + packedFiles[i].data.size());
+	}
+
+	std::ofstream pack(packFilename, std::ios::out | std::ios::binary | std::ios::trunc);
+	if (!pack.is_open())
+		return false;
+	const char padding[dataAlignment]{};
+	pack.write(reinterpret_cast<const char*>(header.data()), static_cast<std::streamsize>(header.size()));
+	std::size_t position{ header.size() };
+	for (std::size_t i{ 0_uz }; i < files.size(); ++i)
+	{
+		pack.write(padding, static_cast<std::streamsize>(offsets[i] - position));
+		pack.write(reinterpret_cast<const char*>(packedFiles[i].data.data()), static_cast<std::streamsize>(packedFiles[i].data.size()));
+		position = offsets[i] + packedFiles[i].data.size();
+	}
+	return static_cast<bool>(pack);
+}
+
+// LZ format is a series of sequences. each sequence is:
+// token (high 4 bits: literal count, low 4 bits: match length - 4; 15 means more length bytes follow, each adding up to 255 until one is less than 255)
+// literal count extension bytes, literals, match offset (u16), match length extension bytes
+// the final sequence has literals only
+inline void ResourcePack::compress(const unsigned char* data, const std::size_t size, std::vector<unsigned char>& compressed)
+{
+	constexpr std::size_t minimumMatchLength{ 4_uz };
+	constexpr std::size_t maximumOffset{ 65535_uz };
+	constexpr std::size_t hashBits{ 16_uz };
+	constexpr std::size_t noPosition{ static_cast<std::size_t>(-1) };
+
+	compressed.clear();
+	compressed.reserve(size + (size / 255_uz) + 16_uz);
+	auto read32 = [data](const std::size_t position)
+	{
+		std::uint32_t value;
+		std::memcpy(&value, data + position, 4_uz);
+		return value;
+	};
+	auto writeLength = [&compressed](std::size_t length)
+	{
+		while (length >= 255_uz)
+		{
+			compressed.push_back(255_uc);
+			length -= 255_uz;
+		}
+		compressed.push_back(static_cast<unsigned char>(length));
+	};
+	auto writeSequence = [&](const std::size_t literalStart, const std::size_t literalCount, const std::size_t offset, const std::size_t matchLength)
+	{
+		const std::size_t matchCode{ (matchLength == 0_uz) ? 0_uz : matchLength - minimumMatchLength };
+		compressed.push_back(static_cast<unsigned char>((std::min(literalCount, 15_uz) << 4u) | std::min(matchCode, 15_uz)));
+		if (literalCount >= 15_uz)
+			writeLength(literalCount - 15_uz);
+		compressed.insert(compressed.end(), data + literalStart, data + literalStart + literalCount);
+		if (matchLength == 0_uz)
+			return;
+		compressed.push_back(static_cast<unsigned char>(offset & 0xFFu));
+		compressed.push_back(static_cast<unsigned char>((offset >> 8u) & 0xFFu));
+		if (matchCode >= 15_uz)
+			writeLength(matchCode - 15_uz);
+	};
+
+	std::vector<std::size_t> positions(1_uz << hashBits, noPosition);
+	std::size_t anchor{ 0_uz };
+	std::size_t position{ 0_uz };
+	while (position + minimumMatchLength <= size)
+	{
+		const std::uint32_t sequence{ read32(position) };
+		const std::size_t hash{ static_cast<std::size_t>((sequence * 2654435761u) >> (32u - hashBits)) };
+		const std::size_t candidate{ positions[hash] };
+		positions[hash] = position;
+		if ((candidate == noPosition) || (position - candidate > maximumOffset) || (read32(candidate) != sequence))
+		{
+			++position;
+			continue;
+		}
+		std::size_t matchLength{ minimumMatchLength };
+		while ((position + matchLength < size) && (data[candidate + matchLength] == data[position + matchLength]))
+			++matchLength;
+		writeSequence(anchor, position - anchor, position - candidate, matchLength);
+		position += matchLength;
+		anchor = position;
+	}
+	if (anchor < size)
+		writeSequence(anchor, size - anchor, 0_uz, 0_uz);
+}
+
+inline bool ResourcePack::decompress(const unsigned char* compressed, const std::size_t compressedSize, unsigned char* data, const std::size_t size)
+{
+	const unsigned char* input{ compressed };
+	const unsigned char* const inputEnd{ compressed + compressedSize };
+	std::size_t output{ 0_uz };
+	auto readLength = [&input, inputEnd](std::size_t& length)
+	{
+		unsigned char byte{ 255_uc };
+		while (byte == 255_uc)
+		{
+			if (input == inputEnd)
+				return false;
+			byte = *input++;
+			length += byte;
+		}
+		return true;
+	};
+
+	while (input < inputEnd)
+	{
+		const unsigned char token{ *input++ };
+		std::size_t literalCount{ static_cast<std::size_t>(token >> 4u) };
+		if ((literalCount == 15_uz) && !readLength(literalCount))
+			return false;
+		if ((literalCount > static_cast<std::size_t>(inputEnd - input)) || (literalCount > size - output))
+			return false;
+		std::memcpy(data + output, input, literalCount);
+		input += literalCount;
+		output += literalCount;
+		if (input == inputEnd)
+			break;
+
+		if (inputEnd - input < 2)
+			return false;
+		const std::size_t offset{ static_cast<std::size_t>(input[0]) | (static_cast<std::size_t>(input[1]) << 8u) };
+		input += 2;
+		std::size_t matchLength{ static_cast<std::size_t>(token & 0x0Fu) };
+		if ((matchLength == 15_uz) && !readLength(matchLength))
+			return false;
+		matchLength += 4_uz;
+		if ((offset == 0_uz) || (offset > output) || (matchLength > size - output))
+			return false;
+		for (std::size_t i{ 0_uz }; i < matchLength; ++i, ++output)
+			data[output] = data[output - offset]; // byte by byte as the match may overlap the output
+	}
+	return output == size;
+}
+
+// PRIVATE
+inline bool ResourcePack::priv_map(const std::string& filename)
+{
+#ifdef _WIN32
+	HANDLE file{ CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr) };
+	if (file == INVALID_HANDLE_VALUE)
+		return false;
+	LARGE_INTEGER fileSize{};
+	if (!GetFileSizeEx(file, &fileSize) || (fileSize.QuadPart == 0))
+	{
+		CloseHandle(file);
+		return false;
+	}
+	HANDLE mapping{ CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr) };
+	if (mapping == nullptr)
+	{
+		CloseHandle(file);
+		return false;
+	}
+	const void* view{ MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) };
+	if (view == nullptr)
+	{
+		CloseHandle(mapping);
+		CloseHandle(file);
+		return false;
+	}
+	m_fileHandle = file;
+	m_mappingHandle = mapping;
+	m_data = static_cast<const unsigned char*>(view);
+	m_size = static_cast<std::size_t>(fileSize.QuadPart);
+#else
+	const int file{ ::open(filename.c_str(), O_RDONLY) };
+	if (file < 0)
+		return false;
+	struct stat fileStatus{};
+	if ((::fstat(file, &fileStatus) != 0) || (fileStatus.st_size <= 0))
+	{
+		::close(file);
+		return false;
+	}
+	void* view{ ::mmap(nullptr, static_cast<std::size_t>(fileStatus.st_size), PROT_READ, MAP_PRIVATE, file, 0) };
+	::close(file); // mapping remains valid after the file is closed
+	if (view == MAP_FAILED)
+		return false;
+	m_data = static_cast<const unsigned char*>(view);
+	m_size = static_cast<std::size_t>(fileStatus.st_size);
+#endif // _WIN32
+	return true;
+}
+
+inline void ResourcePack::priv_unmap()
+{
+	if (m_data == nullptr)
+		return;
+#ifdef _WIN32
+	UnmapViewOfFile(m_data);
+	CloseHandle(static_cast<HANDLE>(m_mappingHandle));
+	CloseHandle(static_cast<HANDLE>(m_fileHandle));
+	m_mappingHandle = nullptr;
+	m_fileHandle = nullptr;
+#else
+	::munmap(const_cast<unsigned char*>(m_data), m_size);
+#endif // _WIN32
+	m_data = nullptr;
+	m_size = 0_uz;
+}
+
+inline bool ResourcePack::priv_readTableOfContents()
+{
+	const std::size_t headerSize{ 16_uz };
+	if ((m_size < headerSize) || (std::memcmp(m_data, "PLPK", 4_uz) != 0) || (priv_readU32(m_data + 4u) != 1u))
+		return false;
+	const std::size_t numberOfEntries{ priv_readU32(m_data + 8u) };
+	const std::size_t tableOfContentsSize{ priv_readU32(m_data + 12u) };
+	if (tableOfContentsSize > m_size - headerSize)
+		return false;
+
+	const unsigned char* position{ m_data + headerSize };
+	const unsigned char* const end{ position + tableOfContentsSize };
+	m_entries.reserve(numberOfEntries);
+	m_indices.reserve(numberOfEntries);
+	for (std::size_t i{ 0_uz }; i < numberOfEntries; ++i)
+	{
+		if (end - position < 32)
+			return false;
+		Entry entry{};
+		entry.offset = static_cast<std::size_t>(priv_readU64(position));
+		entry.storedSize = static_cast<std::size_t>(priv_readU64(position + 8u));
+		entry.size = static_cast<std::size_t>(priv_readU64(position + 16u));
+		const std::uint32_t compression{ priv_readU32(position + 24u) };
+		const std::size_t nameLength{ priv_readU32(position + 28u) };
+		position += 32;
+		if ((compression > static_cast<std::uint32_t>(Compression::Lz)) || (static_cast<std::size_t>(end - position) < nameLength))
+			return false;
+		if ((entry.offset > m_size) || (entry.storedSize > m_size - entry.offset))
+			return false;
+		entry.compression = static_cast<Compression>(compression);
+		if ((entry.compression == Compression::None) && (entry.storedSize != entry.size))
+			return false;
+		entry.name.assign(reinterpret_cast<const char*>(position), nameLength);
+		position += nameLength;
+		m_indices.emplace(entry.name, m_entries.size());
+		m_entries.push_back(std::move(entry));
+	}
+	return true;
+}
+
+inline std::uint32_t ResourcePack::priv_readU32(const unsigned char* bytes)
+{
+	return static_cast<std::uint32_t>(bytes[0]) | (static_cast<std::uint32_t>(bytes[1]) << 8u) | (static_cast<std::uint32_t>(bytes[2]) << 16u) | (static_cast<std::uint32_t>(bytes[3]) << 24u);
+}
+
+inline std::uint64_t ResourcePack::priv_readU64(const unsigned char* bytes)
+{
+	return static_cast<std::uint64_t>(priv_readU32(bytes)) | (static_cast<std::uint64_t>(priv_readU32(bytes + 4u)) << 32u);
+}
+
+inline void ResourcePack::priv_writeU32(std::vector<unsigned char>& bytes, const std::uint32_t value)
+{
+	for (unsigned int i{ 0u }; i < 4u; ++i)
+		bytes.push_back(static_cast<unsigned char>((value >> (i * 8u)) & 0xFFu));
+}
+
+inline void ResourcePack::priv_writeU64(std::vector<unsigned char>& bytes, const std::uint64_t value)
+{
+	priv_writeU32(bytes, static_cast<std::uint32_t>(value & 0xFFFFFFFFu));
+	priv_writeU32(bytes, static_cast<std::uint32_t>(value >> 32u));
+}
+
+} // namespace plinth
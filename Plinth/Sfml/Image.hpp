@@ -39,8 +39,11 @@
 #include "../Color.hpp"
 #include "Generic.hpp"
 #include "ImageChannel.hpp"
-#include <functional>
+#include "ImageSimd.hpp"
+#include "ImageParallel.hpp"
+#include "ImageSrgb.hpp"
 #include <string>
+#include <cstdint>
 
 namespace plinth
 {
@@ -67,12 +70,24 @@ enum class ResizeType
 	Pixel,
 	NearestNeighbour,
 	Bilinear,
+	Area, // mean of the covered source area. best for downscaling
+	Bicubic,
+	Lanczos3,
 };
 
-void processAllPixelsRgb(sf::Image& image, std::function<void (Color::Rgb&)> process);
-void processAllPixelsColor(sf::Image& image, std::function<void (sf::Color&)> process);
+// pixel kernels: work directly on the image's pixel buffer (RGBA, in row order) so that the process can be inlined
+// if isParallel is true, rows may be processed concurrently (see processInParallel) so process must be safe to call from multiple threads for different rows
+template <class ProcessT>
+void processAllRows(sf::Image& image, ProcessT process, bool isParallel = false); // process(std::uint8_t* row, unsigned int y, unsigned int width). row is width RGBA pixels
+template <class ProcessT>
+void processAllPixelsColor(sf::Image& image, ProcessT process, bool isParallel = false); // process(sf::Color& pixel)
+template <class ProcessT>
+void processAllPixelsColorWithLocation(sf::Image& image, ProcessT process, bool isParallel = false); // process(sf::Color& pixel, sf::Vector2u location)
+template <class ProcessT>
+void processAllPixelsRgb(sf::Image& image, ProcessT process, bool isParallel = false); // process(Color::Rgb& pixel). preserves pixel alpha. converts to and from double components so prefer processAllPixelsColor for speed
 
-void convertToGrayscale(sf::Image& image, GrayscaleConversionType conversionType = GrayscaleConversionType::Luminosity);
+// these operations use SIMD if available (see setMaximumInstructionSet) and are processed in parallel for large images (see processInParallel)
+void convertToGrayscale(sf::Image& image, GrayscaleConversionType conversionType = GrayscaleConversionType::Luminosity, bool isLinearLight = false); // linear light calculates gray from decoded sRGB (see ImageSrgb.hpp). it uses lookup tables instead of SIMD
 void invert(sf::Image& image);
 void createMaskFromAlpha(sf::Image& image);
 void clearWithColorButRetainTransparency(sf::Image& image, sf::Color color = sf::Color(255_uc, 255_uc, 255_uc, 255_uc));
@@ -81,6 +96,11 @@ void setAlpha(sf::Image& image, unsigned char alpha = 255_uc);
 void invertAlpha(sf::Image& image);
 void makeOpaque(sf::Image& image);
 
+// premultiplied alpha (colour multiplied by alpha) filters without dark fringes. draw it with sf::BlendMode(sf::BlendMode::Factor::One, sf::BlendMode::Factor::OneMinusSrcAlpha)
+void premultiplyAlpha(sf::Image& image);
+void unpremultiplyAlpha(sf::Image& image); // colour is rounded and clamped. colour of fully transparent pixels becomes black
+void bleedAlpha(sf::Image& image, unsigned int maximumDistance = 0u); // fully transparent pixels take the colour of their nearest visible pixel (alpha stays zero) so that smooth (straight alpha) sampling of e.g. an atlas does not show dark fringes. maximum distance is in pixels (0 is no limit)
+
 void setRedFromChannel(sf::Image& image, const Channel& channel);
 void setGreenFromChannel(sf::Image& image, const Channel& channel);
 void setBlueFromChannel(sf::Image& image, const Channel& channel);
@@ -88,7 +108,14 @@ void setRgbFromChannel(sf::Image& image, const Channel& channel);
 void setAlphaFromChannel(sf::Image& image, const Channel& channel);
 void setAlphaFromMask(sf::Image& image, const Channel& mask);
 
-sf::Image resize(ResizeType type, const sf::Image& image, sf::Vector2u destinationSize, sf::IntRect sourceRectangle = {});
+// composites source over destination (straight alpha) with the source's alpha scaled by amount (0 to 1). sizes must match
+// linear light blends colour in decoded sRGB (see ImageSrgb.hpp)
+void blend(sf::Image& destination, const sf::Image& source, float amount = 1.f, bool isLinearLight = false);
+
+// Draw types require an OpenGL context. all other types are processed on the CPU (in parallel for large images)
+// Area, Bicubic and Lanczos3 are separable (horizontal then vertical) and use precomputed fixed-point weights. they do not premultiply alpha
+// linear light (Bilinear, Area, Bicubic and Lanczos3 only) interpolates decoded sRGB so that downscales and edges are not darkened
+sf::Image resize(ResizeType type, const sf::Image& image, sf::Vector2u destinationSize, sf::IntRect sourceRectangle = {}, bool isLinearLight = false);
 
 	} // namspace Image
 } // namespace plinth
@@ -36,6 +36,11 @@
 #include <SFML/Graphics/RenderTexture.hpp>
 #include <SFML/Graphics/RectangleShape.hpp>
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
 namespace
 {
 
@@ -50,101 +55,249 @@ namespace plinth
 
 using namespace Sfml;
 
-inline void processAllPixelsRgb(sf::Image& image, std::function<void (Color::Rgb&)> process)
+		namespace impl
+		{
+
+inline std::uint8_t* getPixels(sf::Image& image)
 {
-	// preserves pixel alpha
-	const sf::Vector2u imageSize{ image.getSize() };
-	for (unsigned int y{ 0u }; y < imageSize.y; ++y)
+	// sf::Image only provides const access to its pixels but the image itself is not const so they can be modified directly
+	return const_cast<std::uint8_t*>(image.getPixelsPtr());
+}
+
+inline sf::Color loadPixel(const std::uint8_t* const pixel)
+{
+	return{ pixel[0u], pixel[1u], pixel[2u], pixel[3u] };
+}
+
+inline void storePixel(std::uint8_t* const pixel, const sf::Color color)
+{
+	pixel[0u] = color.r;
+	pixel[1u] = color.g;
+	pixel[2u] = color.b;
+	pixel[3u] = color.a;
+}
+
+inline unsigned char getLuminosity(const sf::Color color)
+{
+	// relative luminance weights (0.2126, 0.7152, 0.0722) in 16-bit fixed point. they sum to exactly 65536 so white stays white
+	return static_cast<unsigned char>(((13933u * color.r) + (46871u * color.g) + (4732u * color.b)) >> 16u);
+}
+
+inline unsigned char getLightness(const sf::Color color)
+{
+	// mean of the highest and lowest component value. the median value is ignored
+	return static_cast<unsigned char>((max(color.r, max(color.g, color.b)) + min(color.r, min(color.g, color.b))) / 2u);
+}
+
+inline unsigned char getMedian(const sf::Color color)
+{
+	// only the median component value is used. the highest and lowest values are ignored.
+	if (color.r > color.g && color.r > color.b)
+		return max(color.g, color.b);
+	else if (color.r < color.g && color.r < color.b)
+		return min(color.g, color.b);
+	else
+		return color.r;
+}
+
+inline unsigned char getAverage(const sf::Color color)
+{
+	// mean of all three components
+	return static_cast<unsigned char>((color.r + color.g + color.b) / 3u);
+}
+
+inline unsigned char getLinearLightGray(const sf::Color color, const GrayscaleConversionType conversionType)
+{
+	// gray is calculated from linear light and then encoded. median and single channel conversions select a component so are the same as without linear light
+	const std::array<std::uint16_t, 256u>& decode{ getSrgbToLinearTable() };
+	const std::uint32_t red{ decode[color.r] };
+	const std::uint32_t green{ decode[color.g] };
+	const std::uint32_t blue{ decode[color.b] };
+	std::uint32_t linear{};
+	switch (conversionType)
 	{
-		for (unsigned int x{ 0u }; x < imageSize.x; ++x)
-		{
-			sf::Color color{ image.getPixel({ x, y }) };
-			Color::Rgb pixel{ rgbFromColor(color) };
-			process(pixel);
-			color = colorFromColorAndAlpha(colorFromRgb(pixel), Tween::inverseLinear(0u, 255u, static_cast<unsigned int>(color.a)));
-			image.setPixel({ x, y }, color);
-		}
+	case GrayscaleConversionType::Average:
+		linear = (red + green + blue + 1u) / 3u;
+		break;
+	case GrayscaleConversionType::Lightness:
+		linear = (max(red, max(green, blue)) + min(red, min(green, blue)) + 1u) / 2u;
+		break;
+	case GrayscaleConversionType::Median:
+		return getMedian(color);
+	case GrayscaleConversionType::RedChannel:
+		return color.r;
+	case GrayscaleConversionType::GreenChannel:
+		return color.g;
+	case GrayscaleConversionType::BlueChannel:
+		return color.b;
+	case GrayscaleConversionType::Luminosity:
+	default:
+		linear = ((13933u * red) + (46871u * green) + (4732u * blue) + 32768u) >> 16u;
+	}
+	return getLinearToSrgbTable()[linear];
+}
+
+template <class ProcessT>
+inline void processPixels(std::uint8_t* const pixels, const std::size_t numberOfPixels, ProcessT& process)
+{
+	std::uint8_t* const end{ pixels + (numberOfPixels * 4_uz) };
+	for (std::uint8_t* pixel{ pixels }; pixel != end; pixel += 4u)
+	{
+		sf::Color color{ loadPixel(pixel) };
+		process(color);
+		storePixel(pixel, color);
 	}
 }
 
-inline void processAllPixelsColor(sf::Image& image, std::function<void (sf::Color&)> process)
+		} // namespace impl
+
+template <class ProcessT>
+inline void processAllRows(sf::Image& image, ProcessT process, const bool isParallel)
 {
 	const sf::Vector2u imageSize{ image.getSize() };
-	for (unsigned int y{ 0u }; y < imageSize.y; ++y)
+	std::uint8_t* const pixels{ impl::getPixels(image) };
+	if (pixels == nullptr)
+		return;
+	const std::size_t rowSize{ imageSize.x * 4_uz };
+	auto processRows = [&](const std::size_t begin, const std::size_t end)
+	{
+		for (std::size_t y{ begin }; y < end; ++y)
+			process(pixels + (y * rowSize), static_cast<unsigned int>(y), imageSize.x);
+	};
+	if (isParallel)
+		processInParallel(imageSize.y, imageSize.x, processRows);
+	else
+		processRows(0_uz, imageSize.y);
+}
+
+template <class ProcessT>
+inline void processAllPixelsColor(sf::Image& image, ProcessT process, const bool isParallel)
+{
+	processAllRows(image, [&process](std::uint8_t* const row, unsigned int, const unsigned int width)
 	{
-		for (unsigned int x{ 0u }; x < imageSize.x; ++x)
+		impl::processPixels(row, width, process);
+	}, isParallel);
+}
+
+template <class ProcessT>
+inline void processAllPixelsColorWithLocation(sf::Image& image, ProcessT process, const bool isParallel)
+{
+	processAllRows(image, [&process](std::uint8_t* const row, const unsigned int y, const unsigned int width)
+	{
+		for (unsigned int x{ 0u }; x < width; ++x)
 		{
-			sf::Color pixel{ image.getPixel({ x, y }) };
-			process(pixel);
-			image.setPixel({ x, y }, pixel);
+			sf::Color color{ impl::loadPixel(row + (x * 4_uz)) };
+			process(color, sf::Vector2u{ x, y });
+			impl::storePixel(row + (x * 4_uz), color);
 		}
-	}
+	}, isParallel);
 }
 
-inline void convertToGrayscale(sf::Image& image, const GrayscaleConversionType conversionType)
+template <class ProcessT>
+inline void processAllPixelsRgb(sf::Image& image, ProcessT process, const bool isParallel)
 {
+	// preserves pixel alpha
+	processAllPixelsColor(image, [&process](sf::Color& color)
+	{
+		Color::Rgb pixel{ rgbFromColor(color) };
+		process(pixel);
+		const unsigned char alpha{ color.a };
+		color = colorFromRgb(pixel);
+		color.a = alpha;
+	}, isParallel);
+}
+
+		namespace impl
+		{
+
+template <class ProcessT>
+inline void processAllPixelsSimd(sf::Image& image, const simd::Operation operation, const simd::Parameters& parameters, ProcessT process)
+{
+	// process must give identical results to the SIMD operation. it is used for remaining pixels or if SIMD is not available
+	processAllRows(image, [&](std::uint8_t* const row, unsigned int, const unsigned int width)
+	{
+		const std::size_t numberOfProcessedPixels{ simd::process(operation, row, width, parameters) };
+		processPixels(row + (numberOfProcessedPixels * 4_uz), width - numberOfProcessedPixels, process);
+	}, true);
+}
+
+inline void processAllPixelsBitwise(sf::Image& image, const std::uint32_t andMask, const std::uint32_t orMask, const std::uint32_t xorMask)
+{
+	// masks are of a pixel read as a little-endian 32-bit value (red is the lowest byte)
+	const simd::Parameters parameters{ andMask, orMask, xorMask, 0u };
+	processAllPixelsSimd(image, simd::Operation::Bitwise, parameters, [&parameters](sf::Color& pixel)
+	{
+		std::uint32_t value{ pixel.r | (static_cast<std::uint32_t>(pixel.g) << 8u) | (static_cast<std::uint32_t>(pixel.b) << 16u) | (static_cast<std::uint32_t>(pixel.a) << 24u) };
+		value = ((value & parameters.andMask) | parameters.orMask) ^ parameters.xorMask;
+		pixel = sf::Color(static_cast<std::uint8_t>(value), static_cast<std::uint8_t>(value >> 8u), static_cast<std::uint8_t>(value >> 16u), static_cast<std::uint8_t>(value >> 24u));
+	});
+}
+
+		} // namespace impl
+
+inline void convertToGrayscale(sf::Image& image, const GrayscaleConversionType conversionType, const bool isLinearLight)
+{
+	if (isLinearLight)
+	{
+		processAllPixelsColor(image, [conversionType](sf::Color& pixel)
+		{
+			pixel.r = pixel.g = pixel.b = impl::getLinearLightGray(pixel, conversionType);
+		}, true);
+		return;
+	}
+
 	switch (conversionType)
 	{
 	case GrayscaleConversionType::RedChannel:
-		processAllPixelsRgb(image, [](Color::Rgb& pixel)
+		impl::processAllPixelsSimd(image, impl::simd::Operation::ReplicateChannel, { 0xFF000000u, 0u, 0u, 0u }, [](sf::Color& pixel)
 		{
 			pixel.g = pixel.b = pixel.r;
 		});
 		break;
 	case GrayscaleConversionType::GreenChannel:
-		processAllPixelsRgb(image, [](Color::Rgb& pixel)
+		impl::processAllPixelsSimd(image, impl::simd::Operation::ReplicateChannel, { 0xFF000000u, 0u, 0u, 8u }, [](sf::Color& pixel)
 		{
 			pixel.b = pixel.r = pixel.g;
 		});
 		break;
 	case GrayscaleConversionType::BlueChannel:
-		processAllPixelsRgb(image, [](Color::Rgb& pixel)
+		impl::processAllPixelsSimd(image, impl::simd::Operation::ReplicateChannel, { 0xFF000000u, 0u, 0u, 16u }, [](sf::Color& pixel)
 		{
 			pixel.r = pixel.g = pixel.b;
 		});
 		break;
 	case GrayscaleConversionType::Luminosity:
-		processAllPixelsRgb(image, [](Color::Rgb& pixel)
+		impl::processAllPixelsSimd(image, impl::simd::Operation::Luminosity, { 0xFF000000u, 0u, 0u, 0u }, [](sf::Color& pixel)
 		{
-			pixel.r = pixel.g = pixel.b = pixel.getRelativeLuminance();
+			pixel.r = pixel.g = pixel.b = impl::getLuminosity(pixel);
 		});
 		break;
 	case GrayscaleConversionType::Lightness:
-		processAllPixelsRgb(image, [](Color::Rgb& pixel)
+		impl::processAllPixelsSimd(image, impl::simd::Operation::Lightness, { 0xFF000000u, 0u, 0u, 0u }, [](sf::Color& pixel)
 		{
-			// mean of the highest and lowest component value. the median value is ignored
-			pixel.r = pixel.g = pixel.b = (max(pixel.r, max(pixel.g, pixel.b)) + min(pixel.r, min(pixel.g, pixel.b))) / 2.0;
+			pixel.r = pixel.g = pixel.b = impl::getLightness(pixel);
 		});
 		break;
 	case GrayscaleConversionType::Median:
-		processAllPixelsRgb(image, [](Color::Rgb& pixel)
+		impl::processAllPixelsSimd(image, impl::simd::Operation::Median, { 0xFF000000u, 0u, 0u, 0u }, [](sf::Color& pixel)
 		{
-			// only the median component value is used. the highest and lowest values are ignored.
-			double value{};
-			if (pixel.r > pixel.g && pixel.r > pixel.b)
-				value = max(pixel.g, pixel.b);
-			else if (pixel.r < pixel.g && pixel.r < pixel.b)
-				value = min(pixel.g, pixel.b);
-			else
-				value = pixel.r;
-			pixel.r = pixel.g = pixel.b = value;
+			pixel.r = pixel.g = pixel.b = impl::getMedian(pixel);
 		});
 		break;
 	case GrayscaleConversionType::Average:
-		processAllPixelsRgb(image, [](Color::Rgb& pixel)
+		impl::processAllPixelsSimd(image, impl::simd::Operation::Average, { 0xFF000000u, 0u, 0u, 0u }, [](sf::Color& pixel)
 		{
-			// mean of all three components
-			pixel.r = pixel.g = pixel.b = (pixel.r + pixel.g + pixel.b) / 3.0;
+			pixel.r = pixel.g = pixel.b = impl::getAverage(pixel);
 		});
 		break;
 	default:
-		processAllPixelsRgb(image, [](Color::Rgb& pixel){}); // make no changes
+		break; // make no changes
 	}
 }
 
 inline void createMaskFromAlpha(sf::Image& image)
 {
-	processAllPixelsColor(image, [](sf::Color& pixel)
+	impl::processAllPixelsSimd(image, impl::simd::Operation::ReplicateChannel, { 0u, 0xFF000000u, 0u, 24u }, [](sf::Color& pixel)
 	{
 		pixel.r = pixel.a;
 		pixel.g = pixel.a;
@@ -155,49 +308,173 @@ inline void createMaskFromAlpha(sf::Image& image)
 
 inline void invert(sf::Image& image)
 {
-	processAllPixelsRgb(image, [](Color::Rgb& pixel)
-	{
-		pixel.r = 1.0 - pixel.r;
-		pixel.g = 1.0 - pixel.g;
-		pixel.b = 1.0 - pixel.b;
-	});
+	// preserves pixel alpha
+	impl::processAllPixelsBitwise(image, 0xFFFFFFFFu, 0u, 0x00FFFFFFu);
 }
 
 inline void setAlpha(sf::Image& image, const unsigned char alpha)
 {
-	processAllPixelsColor(image, [&alpha](sf::Color& pixel)
-	{
-		pixel.a = alpha;
-	});
+	impl::processAllPixelsBitwise(image, 0x00FFFFFFu, static_cast<std::uint32_t>(alpha) << 24u, 0u);
 }
 
 inline void invertAlpha(sf::Image& image)
 {
-	processAllPixelsColor(image, [](sf::Color& pixel)
+	impl::processAllPixelsBitwise(image, 0xFFFFFFFFu, 0u, 0xFF000000u);
+}
+
+inline void makeOpaque(sf::Image& image)
+{
+	impl::processAllPixelsBitwise(image, 0xFFFFFFFFu, 0xFF000000u, 0u);
+}
+
+		namespace impl
+		{
+
+inline unsigned char premultiplyComponent(const unsigned int component, const unsigned int alpha)
+{
+	// exactly rounded division by 255
+	const unsigned int value{ (component * alpha) + 128u };
+	return static_cast<unsigned char>((value + (value >> 8u)) >> 8u);
+}
+
+inline unsigned char unpremultiplyComponent(const unsigned int component, const unsigned int alpha)
+{
+	// alpha must not be zero
+	return static_cast<unsigned char>(min((component * 255u + (alpha / 2u)) / alpha, 255u));
+}
+
+struct NearestVisiblePixel
+{
+	std::int32_t x; // noNearestVisiblePixel if there is none
+	std::int32_t y;
+};
+
+constexpr std::int32_t noNearestVisiblePixel{ -(1 << 30) }; // far enough away that any visible pixel is nearer (so it needs no special case) without overflowing squared distances
+
+inline std::int64_t getNearestVisiblePixelDistance(const NearestVisiblePixel nearest, const std::int64_t x, const std::int64_t y)
+{
+	// squared
+	return (nearest.x - x) * (nearest.x - x) + (nearest.y - y) * (nearest.y - y);
+}
+
+inline void considerNearestVisiblePixel(const NearestVisiblePixel candidate, const std::int64_t x, const std::int64_t y, NearestVisiblePixel& nearest, std::int64_t& nearestDistance)
+{
+	const std::int64_t distance{ getNearestVisiblePixelDistance(candidate, x, y) };
+	if (distance < nearestDistance)
 	{
-		pixel.a = 255_uc - pixel.a;
+		nearest = candidate;
+		nearestDistance = distance;
+	}
+}
+
+		} // namespace impl
+
+inline void premultiplyAlpha(sf::Image& image)
+{
+	impl::processAllPixelsSimd(image, impl::simd::Operation::Premultiply, { 0u, 0u, 0u, 0u }, [](sf::Color& pixel)
+	{
+		pixel.r = impl::premultiplyComponent(pixel.r, pixel.a);
+		pixel.g = impl::premultiplyComponent(pixel.g, pixel.a);
+		pixel.b = impl::premultiplyComponent(pixel.b, pixel.a);
 	});
 }
 
-inline void makeOpaque(sf::Image& image)
+inline void unpremultiplyAlpha(sf::Image& image)
 {
-	processAllPixelsColor(image, [](sf::Color& pixel)
+	impl::processAllPixelsSimd(image, impl::simd::Operation::Unpremultiply, { 0u, 0u, 0u, 0u }, [](sf::Color& pixel)
 	{
-		pixel.a = 255_uc;
+		if (pixel.a == 0_uc)
+		{
+			pixel = sf::Color(0_uc, 0_uc, 0_uc, 0_uc);
+			return;
+		}
+		pixel.r = impl::unpremultiplyComponent(pixel.r, pixel.a);
+		pixel.g = impl::unpremultiplyComponent(pixel.g, pixel.a);
+		pixel.b = impl::unpremultiplyComponent(pixel.b, pixel.a);
 	});
 }
 
-inline void clearWithColorButRetainTransparency(sf::Image& image, const sf::Color color)
+inline void bleedAlpha(sf::Image& image, const unsigned int maximumDistance)
 {
-	processAllPixelsColor(image, [&color](sf::Color& pixel)
+	// the nearest visible pixel of every pixel is propagated by two raster passes (down then up) each sweeping rows in both directions (a sequential equivalent of a jump flood)
+	// it is linear and reads memory in order. the result is the nearest (Euclidean) visible pixel except for rare cases where a pixel next to it is found first
+	const sf::Vector2u size{ image.getSize() };
+	std::uint8_t* const pixels{ impl::getPixels(image) };
+	if ((pixels == nullptr) || (size.x == 0u) || (size.y == 0u))
+		return;
+	const std::size_t width{ size.x };
+	std::vector<impl::NearestVisiblePixel> nearest(width * size.y);
+	for (std::size_t y{ 0_uz }; y < size.y; ++y)
+	{
+		for (std::size_t x{ 0_uz }; x < width; ++x)
+		{
+			if (pixels[(y * width + x) * 4_uz + 3_uz] == 0u)
+				nearest[y * width + x] = { impl::noNearestVisiblePixel, impl::noNearestVisiblePixel };
+			else
+				nearest[y * width + x] = { static_cast<std::int32_t>(x), static_cast<std::int32_t>(y) };
+		}
+	}
+
+	const auto considerRow = [&](const std::size_t y, const std::ptrdiff_t rowOffset)
 	{
-		pixel.r = color.r;
-		pixel.g = color.g;
-		pixel.b = color.b;
-		// or: color.a = pixel.a; pixel = color;
+		// row offset is the direction of the row already processed (-1 is the row above). zero skips it
+		impl::NearestVisiblePixel* const row{ nearest.data() + (y * width) };
+		const impl::NearestVisiblePixel* const previousRow{ (rowOffset == 0) ? nullptr : row + (rowOffset * static_cast<std::ptrdiff_t>(width)) };
+		for (std::size_t x{ 0_uz }; x < width; ++x)
+		{
+			std::int64_t distance{ impl::getNearestVisiblePixelDistance(row[x], static_cast<std::int64_t>(x), static_cast<std::int64_t>(y)) };
+			if (distance == 0)
+				continue;
+			if (x > 0_uz)
+				impl::considerNearestVisiblePixel(row[x - 1_uz], static_cast<std::int64_t>(x), static_cast<std::int64_t>(y), row[x], distance);
+			if (previousRow != nullptr)
+			{
+				if (x > 0_uz)
+					impl::considerNearestVisiblePixel(previousRow[x - 1_uz], static_cast<std::int64_t>(x), static_cast<std::int64_t>(y), row[x], distance);
+				impl::considerNearestVisiblePixel(previousRow[x], static_cast<std::int64_t>(x), static_cast<std::int64_t>(y), row[x], distance);
+				if ((x + 1_uz) < width)
+					impl::considerNearestVisiblePixel(previousRow[x + 1_uz], static_cast<std::int64_t>(x), static_cast<std::int64_t>(y), row[x], distance);
+			}
+		}
+		for (std::size_t x{ width - 1_uz }; x > 0_uz; --x)
+		{
+			std::int64_t distance{ impl::getNearestVisiblePixelDistance(row[x - 1_uz], static_cast<std::int64_t>(x - 1_uz), static_cast<std::int64_t>(y)) };
+			impl::considerNearestVisiblePixel(row[x], static_cast<std::int64_t>(x - 1_uz), static_cast<std::int64_t>(y), row[x - 1_uz], distance);
+		}
+	};
+	for (std::size_t y{ 0_uz }; y < size.y; ++y)
+		considerRow(y, (y > 0_uz) ? -1 : 0);
+	for (std::size_t y{ size.y }; y > 0_uz; --y)
+		considerRow(y - 1_uz, (y < size.y) ? 1 : 0);
+
+	// alpha of transparent pixels stays zero
+	const std::int64_t maximumSquaredDistance{ (maximumDistance == 0u) ? std::numeric_limits<std::int64_t>::max() : static_cast<std::int64_t>(maximumDistance) * maximumDistance };
+	processInParallel(size.y, size.x, [&](const std::size_t begin, const std::size_t end)
+	{
+		for (std::size_t y{ begin }; y < end; ++y)
+		{
+			for (std::size_t x{ 0_uz }; x < width; ++x)
+			{
+				const impl::NearestVisiblePixel source{ nearest[y * width + x] };
+				if ((source.x == impl::noNearestVisiblePixel) || (impl::getNearestVisiblePixelDistance(source, static_cast<std::int64_t>(x), static_cast<std::int64_t>(y)) > maximumSquaredDistance))
+					continue;
+				std::uint8_t* const pixel{ pixels + ((y * width + x) * 4_uz) };
+				if (pixel[3u] != 0u)
+					continue;
+				const std::uint8_t* const sourcePixel{ pixels + ((static_cast<std::size_t>(source.y) * width + static_cast<std::size_t>(source.x)) * 4_uz) };
+				pixel[0u] = sourcePixel[0u];
+				pixel[1u] = sourcePixel[1u];
+				pixel[2u] = sourcePixel[2u];
+			}
+		}
 	});
 }
 
+inline void clearWithColorButRetainTransparency(sf::Image& image, const sf::Color color)
+{
+	impl::processAllPixelsBitwise(image, 0xFF000000u, color.r | (static_cast<std::uint32_t>(color.g) << 8u) | (static_cast<std::uint32_t>(color.b) << 16u), 0u);
+}
+
 inline void setRedFromChannel(sf::Image& image, const Channel& channel)
 {
 	if (image.getSize() != channel.getSize())
@@ -240,6 +517,57 @@ inline void setAlphaFromMask(sf::Image& image, const Channel& mask)
 	mask.copyToImage(image, ColorChannel::Alpha);
 }
 
+		namespace impl
+		{
+
+template <bool isLinearLightT>
+inline void blendRow(std::uint8_t* const destination, const std::uint8_t* const source, const unsigned int width, const std::uint32_t amount)
+{
+	// integer "source over". colour sums fit in 32 bits: 65535 (linear) x 255 x 255
+	const std::array<std::uint16_t, 256u>& decode{ getSrgbToLinearTable() };
+	const std::uint8_t* const encode{ getLinearToSrgbTable().data() };
+	for (std::size_t i{ 0_uz }; i < (width * 4_uz); i += 4_uz)
+	{
+		const std::uint32_t sourceAlpha{ ((source[i + 3_uz] * amount) + 127u) / 255u };
+		const std::uint32_t sourceWeight{ sourceAlpha * 255u };
+		const std::uint32_t destinationWeight{ destination[i + 3_uz] * (255u - sourceAlpha) };
+		const std::uint32_t total{ sourceWeight + destinationWeight };
+		if (total == 0u)
+		{
+			destination[i] = destination[i + 1_uz] = destination[i + 2_uz] = destination[i + 3_uz] = 0_uc;
+			continue;
+		}
+		for (std::size_t c{ 0_uz }; c < 3_uz; ++c)
+		{
+			const std::uint32_t sourceValue{ static_cast<std::uint32_t>(isLinearLightT ? decode[source[i + c]] : source[i + c]) };
+			const std::uint32_t destinationValue{ static_cast<std::uint32_t>(isLinearLightT ? decode[destination[i + c]] : destination[i + c]) };
+			const std::uint32_t value{ ((sourceValue * sourceWeight) + (destinationValue * destinationWeight) + (total / 2u)) / total };
+			destination[i + c] = isLinearLightT ? encode[value] : static_cast<std::uint8_t>(value);
+		}
+		destination[i + 3_uz] = static_cast<std::uint8_t>((total + 127u) / 255u);
+	}
+}
+
+		} // namespace impl
+
+inline void blend(sf::Image& destination, const sf::Image& source, const float amount, const bool isLinearLight)
+{
+	if (destination.getSize() != source.getSize())
+		throw Exception(exceptionPrefix + "Cannot blend images. Sizes do not match.");
+	const std::uint8_t* const sourcePixels{ source.getPixelsPtr() };
+	if (sourcePixels == nullptr)
+		return;
+	const std::uint32_t scaledAmount{ static_cast<std::uint32_t>((!(amount > 0.f) ? 0.f : ((amount > 1.f) ? 1.f : amount)) * 255.f + 0.5f) }; // NaN becomes zero
+	processAllRows(destination, [&](std::uint8_t* const row, const unsigned int y, const unsigned int width)
+	{
+		const std::uint8_t* const sourceRow{ sourcePixels + (y * width * 4_uz) };
+		if (isLinearLight)
+			impl::blendRow<true>(row, sourceRow, width, scaledAmount);
+		else
+			impl::blendRow<false>(row, sourceRow, width, scaledAmount);
+	}, true);
+}
+
 
 
 		namespace impl
@@ -273,15 +601,18 @@ inline sf::Image resize_Pixel(const sf::Image& image, const sf::Vector2u destina
 {
 	sf::Image result;
 	result.resize(destinationSize);
-	for (unsigned int y{ 0u }; y < destinationSize.y; ++y)
+	processInParallel(destinationSize.y, destinationSize.x, [&](const std::size_t begin, const std::size_t end)
 	{
-		const unsigned int sourceY{ sourceRectangle.position.y + (y * (sourceRectangle.size.y) / (destinationSize.y)) };
-		for (unsigned int x{ 0u }; x < destinationSize.x; ++x)
+		for (unsigned int y{ static_cast<unsigned int>(begin) }; y < end; ++y)
 		{
-			const unsigned int sourceX{ sourceRectangle.position.x + (x * (sourceRectangle.size.x) / (destinationSize.x)) };
-			result.setPixel({ x, y }, image.getPixel({ sourceX, sourceY }));
+			const unsigned int sourceY{ sourceRectangle.position.y + (y * (sourceRectangle.size.y) / (destinationSize.y)) };
+			for (unsigned int x{ 0u }; x < destinationSize.x; ++x)
+			{
+				const unsigned int sourceX{ sourceRectangle.position.x + (x * (sourceRectangle.size.x) / (destinationSize.x)) };
+				result.setPixel({ x, y }, image.getPixel({ sourceX, sourceY }));
+			}
 		}
-	}
+	});
 	return result;
 }
 
@@ -292,47 +623,332 @@ inline sf::Image resize_NearestNeighbour(const sf::Image& image, const sf::Vecto
 
 	sf::Image result;
 	result.resize(destinationSize);
-	for (unsigned int y{ 0u }; y < destinationSize.y; ++y)
+	processInParallel(destinationSize.y, destinationSize.x, [&](const std::size_t begin, const std::size_t end)
 	{
-		const long double targetY{ sourceRectangle.position.y + (((y + 0.5) * sourceRectangle.size.y) / (destinationSize.y)) - 0.5 };
-		const unsigned int sourceY{ static_cast<unsigned int>(yRange.clamp(std::llround(targetY))) };
-		for (unsigned int x{ 0u }; x < destinationSize.x; ++x)
+		for (unsigned int y{ static_cast<unsigned int>(begin) }; y < end; ++y)
 		{
-			const long double targetX{ sourceRectangle.position.x + (((x + 0.5) * sourceRectangle.size.x) / (destinationSize.x)) - 0.5 };
-			const unsigned int sourceX{ static_cast<unsigned int>(xRange.clamp(std::llround(targetX))) };
-			result.setPixel({ x, y }, image.getPixel({ sourceX, sourceY }));
+			const long double targetY{ sourceRectangle.position.y + (((y + 0.5) * sourceRectangle.size.y) / (destinationSize.y)) - 0.5 };
+			const unsigned int sourceY{ static_cast<unsigned int>(yRange.clamp(std::llround(targetY))) };
+			for (unsigned int x{ 0u }; x < destinationSize.x; ++x)
+			{
+				const long double targetX{ sourceRectangle.position.x + (((x + 0.5) * sourceRectangle.size.x) / (destinationSize.x)) - 0.5 };
+				const unsigned int sourceX{ static_cast<unsigned int>(xRange.clamp(std::llround(targetX))) };
+				result.setPixel({ x, y }, image.getPixel({ sourceX, sourceY }));
+			}
 		}
-	}
+	});
 	return result;
 }
 
-inline sf::Image resize_Bilinear(const sf::Image& image, const sf::Vector2u destinationSize, const sf::IntRect sourceRectangle)
+inline sf::Color interpolateLinearLight(const sf::Color topLeft, const sf::Color topRight, const sf::Color bottomLeft, const sf::Color bottomRight, const float xAlpha, const float yAlpha)
+{
+	// colour is interpolated in linear light. alpha is interpolated directly
+	const std::array<float, 256u>& decode{ getSrgbToLinearFloatTable() };
+	auto interpolate = [&](const float a, const float b, const float c, const float d)
+	{
+		const float upper{ a + ((b - a) * xAlpha) };
+		const float lower{ c + ((d - c) * xAlpha) };
+		return upper + ((lower - upper) * yAlpha);
+	};
+	return colorFromLinear(
+		interpolate(decode[topLeft.r], decode[topRight.r], decode[bottomLeft.r], decode[bottomRight.r]),
+		interpolate(decode[topLeft.g], decode[topRight.g], decode[bottomLeft.g], decode[bottomRight.g]),
+		interpolate(decode[topLeft.b], decode[topRight.b], decode[bottomLeft.b], decode[bottomRight.b]),
+		static_cast<std::uint8_t>(interpolate(topLeft.a, topRight.a, bottomLeft.a, bottomRight.a) + 0.5f));
+}
+
+inline sf::Image resize_Bilinear(const sf::Image& image, const sf::Vector2u destinationSize, const sf::IntRect sourceRectangle, const bool isLinearLight)
 {
 	const pl::Range<long long int>xRange{ 0ll, static_cast<long long int>(sourceRectangle.size.x) - 1ll };
 	const pl::Range<long long int>yRange{ 0ll, static_cast<long long int>(sourceRectangle.size.y) - 1ll };
 
 	sf::Image result;
 	result.resize(destinationSize);
-	for (unsigned int y{ 0u }; y < destinationSize.y; ++y)
+	processInParallel(destinationSize.y, destinationSize.x, [&](const std::size_t begin, const std::size_t end)
 	{
-		const long double targetY{ sourceRectangle.position.y + (((y + 0.5) * sourceRectangle.size.y) / (destinationSize.y)) - 0.5 };
-		const unsigned int minY{ static_cast<unsigned int>(yRange.clamp(std::llround(std::floor(targetY)))) };
-		const unsigned int maxY{ static_cast<unsigned int>(yRange.clamp(std::llround(std::ceil(targetY)))) };
-		const long double yAlpha{ targetY - minY };
-
-		for (unsigned int x{ 0u }; x < destinationSize.x; ++x)
+		for (unsigned int y{ static_cast<unsigned int>(begin) }; y < end; ++y)
 		{
-			const long double targetX{ sourceRectangle.position.x + (((x + 0.5) * sourceRectangle.size.x) / (destinationSize.x)) - 0.5 };
-			const unsigned int minX{ static_cast<unsigned int>(xRange.clamp(std::llround(std::floor(targetX)))) };
-			const unsigned int maxX{ static_cast<unsigned int>(xRange.clamp(std::llround(std::ceil(targetX)))) };
-			const long double xAlpha{ targetX - minX };
+			const long double targetY{ sourceRectangle.position.y + (((y + 0.5) * sourceRectangle.size.y) / (destinationSize.y)) - 0.5 };
+			const unsigned int minY{ static_cast<unsigned int>(yRange.clamp(std::llround(std::floor(targetY)))) };
+			const unsigned int maxY{ static_cast<unsigned int>(yRange.clamp(std::llround(std::ceil(targetY)))) };
+			const long double yAlpha{ targetY - minY };
+
+			for (unsigned int x{ 0u }; x < destinationSize.x; ++x)
+			{
+				const long double targetX{ sourceRectangle.position.x + (((x + 0.5) * sourceRectangle.size.x) / (destinationSize.x)) - 0.5 };
+				const unsigned int minX{ static_cast<unsigned int>(xRange.clamp(std::llround(std::floor(targetX)))) };
+				const unsigned int maxX{ static_cast<unsigned int>(xRange.clamp(std::llround(std::ceil(targetX)))) };
+				const long double xAlpha{ targetX - minX };
+
+				if (isLinearLight)
+				{
+					result.setPixel({ x, y }, interpolateLinearLight(image.getPixel({ minX, minY }), image.getPixel({ maxX, minY }), image.getPixel({ minX, maxY }), image.getPixel({ maxX, maxY }), static_cast<float>(xAlpha), static_cast<float>(yAlpha)));
+					continue;
+				}
+
+				const sf::Color upper{ Tween::linear(image.getPixel({ minX, minY }), image.getPixel({ maxX, minY }), xAlpha) };
+				const sf::Color lower{ Tween::linear(image.getPixel({ minX, maxY }), image.getPixel({ maxX, maxY }), xAlpha) };
+
+				result.setPixel({ x, y }, Tween::linear(upper, lower, yAlpha));
+			}
+		}
+	});
+	return result;
+}
+
+// weights are fixed point. the sum of weights times the maximum sample (255, or 65535 for linear light and intermediate samples) must fit in a signed 32-bit accumulator (including negative lobes)
+constexpr unsigned int resamplePrecisionBits{ 22u };
+constexpr unsigned int resampleLinearLightPrecisionBits{ 14u };
+constexpr unsigned int resampleIntermediatePrecisionBits{ 14u }; // vertical pass (its samples are 16-bit)
+
+struct ResampleCoefficients
+{
+	std::size_t numberOfTaps; // maximum number of source pixels for any destination pixel
+	std::vector<unsigned int> firstSources; // for each destination pixel
+	std::vector<unsigned int> numbersOfSources; // for each destination pixel
+	std::vector<std::int32_t> weights; // numberOfTaps for each destination pixel
+};
+
+inline double getResampleFilterSupport(const ResizeType type)
+{
+	switch (type)
+	{
+	case ResizeType::Bicubic:
+		return 2.0;
+	case ResizeType::Lanczos3:
+		return 3.0;
+	default:
+		return 0.5;
+	}
+}
 
-			const sf::Color upper{ Tween::linear(image.getPixel({ minX, minY }), image.getPixel({ maxX, minY }), xAlpha) };
-			const sf::Color lower{ Tween::linear(image.getPixel({ minX, maxY }), image.getPixel({ maxX, maxY }), xAlpha) };
+inline double getResampleFilterWeight(const ResizeType type, double x)
+{
+	x = std::abs(x);
+	switch (type)
+	{
+	case ResizeType::Bicubic:
+	{
+		// Keys cubic convolution (a = -0.5)
+		constexpr double a{ -0.5 };
+		if (x < 1.0)
+			return (((a + 2.0) * x - (a + 3.0)) * x * x) + 1.0;
+		if (x < 2.0)
+			return (((x - 5.0) * x + 8.0) * x - 4.0) * a;
+		return 0.0;
+	}
+	case ResizeType::Lanczos3:
+	{
+		if (x >= 3.0)
+			return 0.0;
+		if (x < 1e-8)
+			return 1.0;
+		const double piX{ pi * x };
+		return 3.0 * std::sin(piX) * std::sin(piX / 3.0) / (piX * piX);
+	}
+	default:
+		return 0.0;
+	}
+}
 
-			result.setPixel({ x, y }, Tween::linear(upper, lower, yAlpha));
+inline ResampleCoefficients createResampleCoefficients(const ResizeType type, const unsigned int sourceStart, const unsigned int sourceSize, const unsigned int destinationSize, const unsigned int precisionBits)
+{
+	// source pixels are clamped to [sourceStart, sourceStart + sourceSize) so edges are extended rather than faded
+	const double scale{ static_cast<double>(sourceSize) / destinationSize };
+	const double filterScale{ (scale > 1.0) ? scale : 1.0 }; // filter is stretched when downscaling so that every source pixel contributes
+	const double support{ getResampleFilterSupport(type) * filterScale };
+
+	ResampleCoefficients coefficients{};
+	coefficients.numberOfTaps = static_cast<std::size_t>(std::ceil(support)) * 2_uz + 1_uz;
+	coefficients.firstSources.resize(destinationSize);
+	coefficients.numbersOfSources.resize(destinationSize);
+	coefficients.weights.assign(coefficients.numberOfTaps * destinationSize, 0);
+
+	std::vector<double> weights(coefficients.numberOfTaps);
+	std::vector<double> clampedWeights(coefficients.numberOfTaps);
+	for (unsigned int i{ 0u }; i < destinationSize; ++i)
+	{
+		std::size_t numberOfSources{ 0_uz };
+		double total{ 0.0 };
+		long long int first{ 0ll };
+		if (type == ResizeType::Area)
+		{
+			// exact coverage of the destination pixel's span in the source
+			const double begin{ i * scale };
+			const double end{ (i + 1u) * scale };
+			first = static_cast<long long int>(std::floor(begin));
+			for (long long int x{ first }; (x < end) && (numberOfSources < coefficients.numberOfTaps); ++x)
+			{
+				const double coverage{ ((end < x + 1.0) ? end : x + 1.0) - ((begin > x) ? begin : static_cast<double>(x)) };
+				weights[numberOfSources++] = coverage;
+				total += coverage;
+			}
 		}
+		else
+		{
+			const double center{ (i + 0.5) * scale };
+			first = static_cast<long long int>(std::floor(center - support + 0.5));
+			const long long int last{ static_cast<long long int>(std::floor(center + support + 0.5)) };
+			for (long long int x{ first }; (x < last) && (numberOfSources < coefficients.numberOfTaps); ++x)
+			{
+				const double weight{ getResampleFilterWeight(type, (x + 0.5 - center) / filterScale) };
+				weights[numberOfSources++] = weight;
+				total += weight;
+			}
+		}
+
+		// fold taps outside the source into the edge pixels
+		const long long int lastSource{ static_cast<long long int>(sourceSize) - 1ll };
+		std::fill(clampedWeights.begin(), clampedWeights.end(), 0.0);
+		const long long int clampedFirst{ (first < 0ll) ? 0ll : ((first > lastSource) ? lastSource : first) };
+		std::size_t numberOfClampedSources{ 0_uz };
+		for (std::size_t t{ 0_uz }; t < numberOfSources; ++t)
+		{
+			long long int x{ first + static_cast<long long int>(t) };
+			x = (x < 0ll) ? 0ll : ((x > lastSource) ? lastSource : x);
+			const std::size_t index{ static_cast<std::size_t>(x - clampedFirst) };
+			clampedWeights[index] += weights[t];
+			if (index + 1_uz > numberOfClampedSources)
+				numberOfClampedSources = index + 1_uz;
+		}
+
+		coefficients.firstSources[i] = sourceStart + static_cast<unsigned int>(clampedFirst);
+		coefficients.numbersOfSources[i] = static_cast<unsigned int>(numberOfClampedSources);
+		std::int32_t* const fixedWeights{ coefficients.weights.data() + (i * coefficients.numberOfTaps) };
+		for (std::size_t t{ 0_uz }; t < numberOfClampedSources; ++t)
+			fixedWeights[t] = static_cast<std::int32_t>(std::lround((clampedWeights[t] / total) * (1u << precisionBits)));
 	}
+	return coefficients;
+}
+
+template <bool isLinearLightT>
+struct ResampleSample // source samples are 8-bit encoded components or 16-bit linear light (with alpha scaled to 16 bits)
+{
+	// intermediate samples (between the passes) are 16-bit so that the horizontal pass is not rounded to 8 bits. encoded components keep fractional bits and are signed so that filter overshoot reaches the vertical pass
+	using IntermediateType = typename std::conditional<isLinearLightT, std::uint16_t, std::int16_t>::type;
+	static constexpr unsigned int precisionBits{ isLinearLightT ? resampleLinearLightPrecisionBits : resamplePrecisionBits }; // horizontal pass
+	static constexpr unsigned int fractionBits{ isLinearLightT ? 0u : 6u }; // of intermediate samples
+	static constexpr std::int32_t intermediateMinimum{ isLinearLightT ? 0 : -32768 };
+	static constexpr std::int32_t intermediateMaximum{ isLinearLightT ? 65535 : 32767 };
+	static constexpr std::int32_t maximum{ isLinearLightT ? 65535 : 255 };
+};
+
+template <bool isLinearLightT>
+inline typename ResampleSample<isLinearLightT>::IntermediateType toIntermediateResampled(const std::int32_t value)
+{
+	constexpr std::int32_t minimum{ ResampleSample<isLinearLightT>::intermediateMinimum };
+	constexpr std::int32_t maximum{ ResampleSample<isLinearLightT>::intermediateMaximum };
+	const std::int32_t result{ value >> (ResampleSample<isLinearLightT>::precisionBits - ResampleSample<isLinearLightT>::fractionBits) };
+	return static_cast<typename ResampleSample<isLinearLightT>::IntermediateType>((result < minimum) ? minimum : ((result > maximum) ? maximum : result));
+}
+
+template <bool isLinearLightT>
+inline std::int32_t clampResampled(const std::int32_t value)
+{
+	constexpr std::int32_t maximum{ ResampleSample<isLinearLightT>::maximum };
+	if (value <= 0)
+		return 0;
+	const std::int32_t result{ value >> (resampleIntermediatePrecisionBits + ResampleSample<isLinearLightT>::fractionBits) };
+	return (result > maximum) ? maximum : result;
+}
+
+template <bool isLinearLightT>
+inline sf::Image resize_Separable(const ResizeType type, const sf::Image& image, const sf::Vector2u destinationSize, const sf::IntRect sourceRectangle)
+{
+	using IntermediateT = typename ResampleSample<isLinearLightT>::IntermediateType;
+	constexpr unsigned int precisionBits{ ResampleSample<isLinearLightT>::precisionBits };
+	constexpr unsigned int fractionBits{ ResampleSample<isLinearLightT>::fractionBits };
+
+	// source rectangle is clipped to the image
+	const sf::Vector2u imageSize{ image.getSize() };
+	const unsigned int left{ static_cast<unsigned int>(std::max(0, std::min(sourceRectangle.position.x, static_cast<int>(imageSize.x) - 1))) };
+	const unsigned int top{ static_cast<unsigned int>(std::max(0, std::min(sourceRectangle.position.y, static_cast<int>(imageSize.y) - 1))) };
+	const sf::Vector2u sourceSize{ std::max(1u, std::min(static_cast<unsigned int>(sourceRectangle.size.x), imageSize.x - left)), std::max(1u, std::min(static_cast<unsigned int>(sourceRectangle.size.y), imageSize.y - top)) };
+
+	const ResampleCoefficients horizontal{ createResampleCoefficients(type, left, sourceSize.x, destinationSize.x, precisionBits) };
+	const ResampleCoefficients vertical{ createResampleCoefficients(type, 0u, sourceSize.y, destinationSize.y, resampleIntermediatePrecisionBits) };
+	const std::int32_t horizontalRounding{ 1 << (precisionBits - fractionBits - 1u) };
+	const std::int32_t verticalRounding{ 1 << (resampleIntermediatePrecisionBits + fractionBits - 1u) };
+	const std::array<std::uint16_t, 256u>& decode{ getSrgbToLinearTable() };
+	const std::uint8_t* const encode{ isLinearLightT ? getLinearToSrgbTable().data() : nullptr };
+
+	// horizontal pass: source rows (within the rectangle) to intermediate rows of destination width. linear light is decoded here
+	const std::uint8_t* const sourcePixels{ image.getPixelsPtr() };
+	const std::size_t sourceRowSize{ imageSize.x * 4_uz };
+	const std::size_t intermediateRowSize{ destinationSize.x * 4_uz };
+	std::vector<IntermediateT> intermediate(intermediateRowSize * sourceSize.y);
+	processInParallel(sourceSize.y, destinationSize.x * horizontal.numberOfTaps, [&](const std::size_t begin, const std::size_t end)
+	{
+		for (std::size_t y{ begin }; y < end; ++y)
+		{
+			const std::uint8_t* const sourceRow{ sourcePixels + ((top + y) * sourceRowSize) };
+			IntermediateT* destination{ intermediate.data() + (y * intermediateRowSize) };
+			for (std::size_t x{ 0_uz }; x < destinationSize.x; ++x, destination += 4)
+			{
+				const std::int32_t* const weights{ horizontal.weights.data() + (x * horizontal.numberOfTaps) };
+				const std::uint8_t* source{ sourceRow + (horizontal.firstSources[x] * 4_uz) };
+				std::int32_t r{ horizontalRounding }, g{ horizontalRounding }, b{ horizontalRounding }, a{ horizontalRounding };
+				for (unsigned int t{ 0u }; t < horizontal.numbersOfSources[x]; ++t, source += 4)
+				{
+					if (isLinearLightT)
+					{
+						r += decode[source[0u]] * weights[t];
+						g += decode[source[1u]] * weights[t];
+						b += decode[source[2u]] * weights[t];
+						a += (source[3u] * 257) * weights[t];
+					}
+					else
+					{
+						r += source[0u] * weights[t];
+						g += source[1u] * weights[t];
+						b += source[2u] * weights[t];
+						a += source[3u] * weights[t];
+					}
+				}
+				destination[0u] = toIntermediateResampled<isLinearLightT>(r);
+				destination[1u] = toIntermediateResampled<isLinearLightT>(g);
+				destination[2u] = toIntermediateResampled<isLinearLightT>(b);
+				destination[3u] = toIntermediateResampled<isLinearLightT>(a);
+			}
+		}
+	});
+
+	// vertical pass: weighted sum of whole intermediate rows (contiguous so the inner loop vectorises). linear light is encoded here
+	sf::Image result;
+	result.resize(destinationSize);
+	std::uint8_t* const resultPixels{ getPixels(result) };
+	processInParallel(destinationSize.y, destinationSize.x * vertical.numberOfTaps, [&](const std::size_t begin, const std::size_t end)
+	{
+		std::vector<std::int32_t> accumulator(intermediateRowSize);
+		for (std::size_t y{ begin }; y < end; ++y)
+		{
+			std::fill(accumulator.begin(), accumulator.end(), verticalRounding);
+			const std::int32_t* const weights{ vertical.weights.data() + (y * vertical.numberOfTaps) };
+			for (unsigned int t{ 0u }; t < vertical.numbersOfSources[y]; ++t)
+			{
+				const IntermediateT* const source{ intermediate.data() + ((vertical.firstSources[y] + t) * intermediateRowSize) };
+				const std::int32_t weight{ weights[t] };
+				for (std::size_t i{ 0_uz }; i < intermediateRowSize; ++i)
+					accumulator[i] += source[i] * weight;
+			}
+			std::uint8_t* const row{ resultPixels + (y * intermediateRowSize) };
+			if (isLinearLightT)
+			{
+				for (std::size_t i{ 0_uz }; i < intermediateRowSize; i += 4_uz)
+				{
+					row[i] = encode[clampResampled<isLinearLightT>(accumulator[i])];
+					row[i + 1_uz] = encode[clampResampled<isLinearLightT>(accumulator[i + 1_uz])];
+					row[i + 2_uz] = encode[clampResampled<isLinearLightT>(accumulator[i + 2_uz])];
+					row[i + 3_uz] = static_cast<std::uint8_t>(((clampResampled<isLinearLightT>(accumulator[i + 3_uz]) * 255) + 32767) / 65535);
+				}
+			}
+			else
+			{
+				for (std::size_t i{ 0_uz }; i < intermediateRowSize; ++i)
+					row[i] = static_cast<std::uint8_t>(clampResampled<isLinearLightT>(accumulator[i]));
+			}
+		}
+	});
 	return result;
 }
 
@@ -340,7 +956,7 @@ inline sf::Image resize_Bilinear(const sf::Image& image, const sf::Vector2u dest
 
 
 
-inline sf::Image resize(const ResizeType type, const sf::Image& image, const sf::Vector2u destinationSize, sf::IntRect sourceRectangle)
+inline sf::Image resize(const ResizeType type, const sf::Image& image, const sf::Vector2u destinationSize, sf::IntRect sourceRectangle, const bool isLinearLight)
 {
 	const sf::Vector2u imageSize{ image.getSize() };
 	if (destinationSize == imageSize)
@@ -380,7 +996,14 @@ inline sf::Image resize(const ResizeType type, const sf::Image& image, const sf:
 		return impl::resize_NearestNeighbour(image, destinationSize, sourceRectangle);
 		break;
 	case ResizeType::Bilinear:
-		return impl::resize_Bilinear(image, destinationSize, sourceRectangle);
+		return impl::resize_Bilinear(image, destinationSize, sourceRectangle, isLinearLight);
+		break;
+	case ResizeType::Area:
+	case ResizeType::Bicubic:
+	case ResizeType::Lanczos3:
+		if (isLinearLight)
+			return impl::resize_Separable<true>(type, image, destinationSize, sourceRectangle);
+		return impl::resize_Separable<false>(type, image, destinationSize, sourceRectangle);
 		break;
 	}
 	return image;
@@ -33,6 +33,10 @@
 #include <SFML/System/Vector2.hpp>
 #include <SFML/Graphics/Image.hpp>
 #include <SFML/Graphics/Color.hpp>
+#include "ImageNoise.hpp"
+#include "ImageParallel.hpp"
+#include "ImageSimd.hpp"
+#include <vector>
 
 namespace plinth
 {
@@ -48,14 +52,20 @@ enum class ColorChannel
 	Rgb
 };
 
-enum class NoiseType
-{
-	Random
-};
-
 class Channel
 {
 public:
+	template <class T>
+	struct Span // consecutive pixels (e.g. a row). access is unchecked
+	{
+		T* pixels;
+		std::size_t size;
+
+		T* begin() const;
+		T* end() const;
+		T& operator[](std::size_t index) const;
+	};
+
 	Channel();
 	Channel(sf::Vector2u size);
 	Channel(sf::Vector2u size, unsigned char value);
@@ -64,11 +74,17 @@ public:
 	sf::Vector2u getSize() const;
 	void setPixel(sf::Vector2u location, unsigned char value);
 	unsigned char getPixel(sf::Vector2u location) const;
-	void copyFromImage(const sf::Image& image, ColorChannel colorChannel = ColorChannel::Rgb, bool resize = true);
-	void copyToImage(sf::Image& image, ColorChannel colorChannel = ColorChannel::Rgb, bool replaceAlpha = false) const;
+	unsigned char* getData(); // all pixels in rows. row y starts at getData() + (y * getStride())
+	const unsigned char* getData() const;
+	std::size_t getStride() const; // number of pixels from the start of one row to the start of the next
+	Span<unsigned char> getRow(unsigned int y); // unchecked (y must be less than height)
+	Span<const unsigned char> getRow(unsigned int y) const;
+	void copyFromImage(const sf::Image& image, ColorChannel colorChannel = ColorChannel::Rgb, bool resize = true); // copying (from and to images) uses SIMD and is processed in parallel for large channels (see processInParallel). Rgb copies the mean of red, green and blue
+	void copyToImage(sf::Image& image, ColorChannel colorChannel = ColorChannel::Rgb, bool replaceAlpha = false) const; // if sizes differ, only the overlapping area (from the top-left) is copied
 	void clear(unsigned char value = 0_uc);
 	void invert();
 	void generateNoise(NoiseType type = NoiseType::Random);
+	void generateNoise(NoiseType type, const NoiseSettings& settings); // see NoiseSettings. throws if scale or lacunarity is not greater than zero
 
 private:
 	const std::string m_exceptionPrefix;
@@ -76,6 +92,14 @@ private:
 	std::vector<unsigned char> m_pixels;
 };
 
+		namespace impl
+		{
+
+void extractChannelRow(const std::uint8_t* pixels, std::uint8_t* values, std::size_t numberOfPixels, ColorChannel colorChannel); // RGBA pixels to channel values
+void insertChannelRow(std::uint8_t* pixels, const std::uint8_t* values, std::size_t numberOfPixels, ColorChannel colorChannel, bool replaceAlpha); // channel values to RGBA pixels
+
+		} // namespace impl
+
 	} // namespace Image
 } // namespace plinth
 #include "ImageChannel.inl"
@@ -37,6 +37,79 @@ namespace plinth
 {
 	namespace Image
 	{
+		namespace impl
+		{
+
+inline unsigned int getColorChannelShift(const ColorChannel colorChannel)
+{
+	// bit shift of the component in a pixel read as a little-endian 32-bit value
+	switch (colorChannel)
+	{
+	case ColorChannel::Green:
+		return 8u;
+	case ColorChannel::Blue:
+		return 16u;
+	case ColorChannel::Alpha:
+		return 24u;
+	default:
+		return 0u;
+	}
+}
+
+inline void extractChannelRow(const std::uint8_t* const pixels, std::uint8_t* const values, const std::size_t numberOfPixels, const ColorChannel colorChannel)
+{
+	if (colorChannel == ColorChannel::Rgb)
+	{
+		std::size_t i{ simd::extract(simd::Operation::Average, pixels, values, numberOfPixels, { 0u, 0u, 0u, 0u }) };
+		for (; i < numberOfPixels; ++i)
+			values[i] = static_cast<std::uint8_t>((static_cast<unsigned int>(pixels[i * 4_uz]) + pixels[i * 4_uz + 1_uz] + pixels[i * 4_uz + 2_uz]) / 3u);
+		return;
+	}
+	const unsigned int shift{ getColorChannelShift(colorChannel) };
+	std::size_t i{ simd::extract(simd::Operation::ReplicateChannel, pixels, values, numberOfPixels, { 0u, 0u, 0u, shift }) };
+	for (; i < numberOfPixels; ++i)
+		values[i] = pixels[i * 4_uz + (shift / 8u)];
+}
+
+inline void insertChannelRow(std::uint8_t* const pixels, const std::uint8_t* const values, const std::size_t numberOfPixels, const ColorChannel colorChannel, const bool replaceAlpha)
+{
+	// alpha is replaced before the channel is copied so copying to alpha always uses the values
+	const bool isRgb{ colorChannel == ColorChannel::Rgb };
+	const unsigned int shift{ getColorChannelShift(colorChannel) };
+	const std::uint32_t andMask{ isRgb ? 0xFF000000u : ~(0xFFu << shift) };
+	const std::uint32_t orMask{ (replaceAlpha && (colorChannel != ColorChannel::Alpha)) ? 0xFF000000u : 0u };
+	std::size_t i{ simd::insert(pixels, values, numberOfPixels, { andMask, orMask, 0u, shift }, isRgb) };
+	for (; i < numberOfPixels; ++i)
+	{
+		std::uint8_t* const pixel{ pixels + (i * 4_uz) };
+		if (replaceAlpha)
+			pixel[3u] = 255_uc;
+		if (isRgb)
+			pixel[0u] = pixel[1u] = pixel[2u] = values[i];
+		else
+			pixel[shift / 8u] = values[i];
+	}
+}
+
+		} // namespace impl
+
+template <class T>
+inline T* Channel::Span<T>::begin() const
+{
+	return pixels;
+}
+
+template <class T>
+inline T* Channel::Span<T>::end() const
+{
+	return pixels + size;
+}
+
+template <class T>
+inline T& Channel::Span<T>::operator[](const std::size_t index) const
+{
+	return pixels[index];
+}
 
 inline Channel::Channel()
 	: m_exceptionPrefix{ "SFML/ImageChannel: " }
@@ -88,76 +161,60 @@ inline unsigned char Channel::getPixel(const sf::Vector2u location) const
 	return m_pixels[static_cast<std::size_t>(location.y) * static_cast<std::size_t>(m_size.x) + static_cast<std::size_t>(location.x)];
 }
 
+inline unsigned char* Channel::getData()
+{
+	return m_pixels.data();
+}
+
+inline const unsigned char* Channel::getData() const
+{
+	return m_pixels.data();
+}
+
+inline std::size_t Channel::getStride() const
+{
+	return m_size.x;
+}
+
+inline Channel::Span<unsigned char> Channel::getRow(const unsigned int y)
+{
+	return{ m_pixels.data() + (static_cast<std::size_t>(y) * m_size.x), m_size.x };
+}
+
+inline Channel::Span<const unsigned char> Channel::getRow(const unsigned int y) const
+{
+	return{ m_pixels.data() + (static_cast<std::size_t>(y) * m_size.x), m_size.x };
+}
+
 inline void Channel::copyFromImage(const sf::Image& image, const ColorChannel colorChannel, const bool resize)
 {
 	const sf::Vector2u imageSize{ image.getSize() };
 	if (resize)
 		setSize(imageSize);
-	for (unsigned int y{ 0u }; y < m_size.y; ++y)
+	const std::uint8_t* const pixels{ image.getPixelsPtr() };
+	if (pixels == nullptr)
+		return;
+	const sf::Vector2u size{ (m_size.x < imageSize.x) ? m_size.x : imageSize.x, (m_size.y < imageSize.y) ? m_size.y : imageSize.y };
+	processInParallel(size.y, size.x, [&](const std::size_t begin, const std::size_t end)
 	{
-		if (!resize && (y >= imageSize.y))
-			continue;
-
-		for (unsigned int x{ 0u }; x < m_size.x; ++x)
-		{
-			if (!resize && (x >= imageSize.x))
-				continue;
-
-			switch (colorChannel)
-			{
-			case ColorChannel::Red:
-				setPixel({ x, y }, image.getPixel({ x, y }).r);
-				break;
-			case ColorChannel::Green:
-				setPixel({ x, y }, image.getPixel({ x, y }).g);
-				break;
-			case ColorChannel::Blue:
-				setPixel({ x, y }, image.getPixel({ x, y }).b);
-				break;
-			case ColorChannel::Alpha:
-				setPixel({ x, y }, image.getPixel({ x, y }).a);
-				break;
-			default:
-				const sf::Color color{ image.getPixel({x, y}) };
-				setPixel({ x, y }, static_cast<std::uint8_t>((static_cast<unsigned int>(color.r) + color.g + color.b) / 3u));
-			}
-		}
-	}
+		for (std::size_t y{ begin }; y < end; ++y)
+			impl::extractChannelRow(pixels + (y * imageSize.x * 4_uz), m_pixels.data() + (y * m_size.x), size.x, colorChannel);
+	});
 }
 
 inline void Channel::copyToImage(sf::Image& image, const ColorChannel colorChannel, const bool replaceAlpha) const
 {
 	const sf::Vector2u imageSize{ image.getSize() };
-	for (std::size_t i{ 0_uz }; i < m_pixels.size(); ++i)
+	// sf::Image only provides const access to its pixels but the image itself is not const so they can be modified directly
+	std::uint8_t* const pixels{ const_cast<std::uint8_t*>(image.getPixelsPtr()) };
+	if (pixels == nullptr)
+		return;
+	const sf::Vector2u size{ (m_size.x < imageSize.x) ? m_size.x : imageSize.x, (m_size.y < imageSize.y) ? m_size.y : imageSize.y };
+	processInParallel(size.y, size.x, [&](const std::size_t begin, const std::size_t end)
 	{
-		const sf::Vector2u location{ static_cast<unsigned int>(i % imageSize.x), static_cast<unsigned int>(i / imageSize.x) };
-		if ((location.x >= imageSize.x) || (location.y >= imageSize.y))
-			continue;
-
-		sf::Color color{ image.getPixel(location) };
-		if (replaceAlpha)
-			color.a = 255_uc;
-		switch (colorChannel)
-		{
-		case ColorChannel::Red:
-			color.r = m_pixels[i];
-			break;
-		case ColorChannel::Green:
-			color.g = m_pixels[i];
-			break;
-		case ColorChannel::Blue:
-			color.b = m_pixels[i];
-			break;
-		case ColorChannel::Alpha:
-			color.a = m_pixels[i];
-			break;
-		default:
-			color.r = m_pixels[i];
-			color.g = m_pixels[i];
-			color.b = m_pixels[i];
-		}
-		image.setPixel(location, color);
-	}
+		for (std::size_t y{ begin }; y < end; ++y)
+			impl::insertChannelRow(pixels + (y * imageSize.x * 4_uz), m_pixels.data() + (y * m_size.x), size.x, colorChannel, replaceAlpha);
+	});
 }
 
 inline void Channel::clear(const unsigned char value)
@@ -174,9 +231,23 @@ inline void Channel::invert()
 
 inline void Channel::generateNoise(const NoiseType type)
 {
-	RandomDistribution<unsigned int> random{ 0u, 255u };
-	for (auto& pixel : m_pixels)
-		pixel = static_cast<unsigned char>(random.value());
+	generateNoise(type, NoiseSettings{});
+}
+
+inline void Channel::generateNoise(const NoiseType type, const NoiseSettings& settings)
+{
+	if (type == NoiseType::Random)
+	{
+		RandomDistribution<unsigned int> random{ 0u, 255u };
+		for (auto& pixel : m_pixels)
+			pixel = static_cast<unsigned char>(random.value());
+		return;
+	}
+	if (!(settings.scale > 0.f))
+		throw Exception(m_exceptionPrefix + "Could not generate noise; scale must be greater than zero.");
+	if (!(settings.lacunarity > 0.f))
+		throw Exception(m_exceptionPrefix + "Could not generate noise; lacunarity must be greater than zero.");
+	impl::generateNoise(m_pixels.data(), m_size, m_size.x, type, settings);
 }
 
 	} // namespace Image
@@ -0,0 +1,63 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// Plinth
+//
+// Copyright(c) 2014-2025 M.J.Silk
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions :
+//
+// 1. The origin of this software must not be misrepresented; you must not
+// claim that you wrote the original software.If you use this software
+// in a product, an acknowledgment in the product documentation would be
+// appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not be
+// misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+// M.J.Silk
+// MJSilk2@gmail.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+
+// REQUIRES C++11
+
+#pragma once
+
+#include "Common.hpp"
+#include <SFML/System/Vector2.hpp>
+#include "Image.hpp"
+#include "ImageChannel.hpp"
+#include "ImageParallel.hpp"
+#include <vector>
+#include <cstdint>
+
+namespace plinth
+{
+	namespace Image
+	{
+
+// signed distance fields (e.g. from an alpha channel: Channel(image, ColorChannel::Alpha)) for scalable outlines and glows
+// pixels at or above the threshold are inside. distances are exact Euclidean distances (Meijster's linear-time transform) between pixel centres, less half a pixel so the edge is between an inside pixel and an outside pixel
+// the column and row passes are processed in parallel for large channels (see processInParallel)
+std::vector<float> createSignedDistances(const Channel& channel, unsigned char threshold = 128_uc); // distance (in pixels) to the edge for each pixel in rows of the channel's width. positive inside, negative outside
+Channel createDistanceField(const Channel& channel, float spread, unsigned char threshold = 128_uc, unsigned int downsampleFactor = 1u); // edge is 128 (127.5 rounded). spread is the distance (in original pixels) that reaches 0 (outside) and 255 (inside). downsampled size is rounded up and each pixel is the mean distance of its block
+
+		namespace impl
+		{
+
+void transformDistanceRow(const std::uint32_t* columnDistances, std::size_t width, std::int64_t* squaredDistances, std::vector<std::size_t>& sites, std::vector<std::size_t>& starts); // squared distances along a row from the distances within each column
+
+		} // namespace impl
+
+	} // namespace Image
+} // namespace plinth
+#include "ImageDistanceField.inl"
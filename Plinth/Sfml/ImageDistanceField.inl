@@ -0,0 +1,237 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// Plinth
+//
+// Copyright(c) 2014-2025 M.J.Silk
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions :
+//
+// 1. The origin of this software must not be misrepresented; you must not
+// claim that you wrote the original software.If you use this software
+// in a product, an acknowledgment in the product documentation would be
+// appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not be
+// misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+// M.J.Silk
+// MJSilk2@gmail.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once
+
+#include "ImageDistanceField.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace plinth
+{
+	namespace Image
+	{
+		namespace impl
+		{
+
+constexpr std::size_t distanceFieldStripWidth{ 1024u }; // columns processed together by the column pass
+
+inline std::int64_t floorDivide(const std::int64_t numerator, const std::int64_t denominator)
+{
+	// floating-point division is much faster than integer division and is exact here as the numerator is less than 2^53
+	return static_cast<std::int64_t>(std::floor(static_cast<double>(numerator) / static_cast<double>(denominator)));
+}
+
+inline void transformDistanceRow(const std::uint32_t* const columnDistances, const std::size_t width, std::int64_t* const squaredDistances, std::vector<std::size_t>& sites, std::vector<std::size_t>& starts)
+{
+	// lower envelope of the parabolas (x - i)^2 + g(i)^2: sites are the columns whose parabolas form the envelope and starts are where each begins
+	const auto f = [&](const std::int64_t x, const std::size_t i)
+	{
+		const std::int64_t g{ columnDistances[i] };
+		return (x - static_cast<std::int64_t>(i)) * (x - static_cast<std::int64_t>(i)) + g * g;
+	};
+	const auto separation = [&](const std::size_t i, const std::size_t u)
+	{
+		const std::int64_t gi{ columnDistances[i] };
+		const std::int64_t gu{ columnDistances[u] };
+		const std::int64_t si{ static_cast<std::int64_t>(i) };
+		const std::int64_t su{ static_cast<std::int64_t>(u) };
+		return floorDivide(su * su - si * si + gu * gu - gi * gi, 2 * (su - si));
+	};
+
+	sites.resize(width);
+	starts.resize(width);
+	std::size_t q{ 0_uz }; // index of the last envelope parabola
+	bool isEmpty{ false };
+	sites[0_uz] = 0_uz;
+	starts[0_uz] = 0_uz;
+	for (std::size_t u{ 1_uz }; u < width; ++u)
+	{
+		while (!isEmpty && (f(static_cast<std::int64_t>(starts[q]), sites[q]) > f(static_cast<std::int64_t>(starts[q]), u)))
+		{
+			if (q == 0_uz)
+				isEmpty = true;
+			else
+				--q;
+		}
+		if (isEmpty)
+		{
+			isEmpty = false;
+			q = 0_uz;
+			sites[0_uz] = u;
+			starts[0_uz] = 0_uz;
+		}
+		else
+		{
+			const std::int64_t start{ 1 + separation(sites[q], u) };
+			if (start < static_cast<std::int64_t>(width))
+			{
+				++q;
+				sites[q] = u;
+				starts[q] = static_cast<std::size_t>(start);
+			}
+		}
+	}
+	for (std::size_t u{ width }; u > 0_uz; --u)
+	{
+		const std::size_t x{ u - 1_uz };
+		squaredDistances[x] = f(static_cast<std::int64_t>(x), sites[q]);
+		if ((x == starts[q]) && (q > 0_uz))
+			--q;
+	}
+}
+
+		} // namespace impl
+
+inline std::vector<float> createSignedDistances(const Channel& channel, const unsigned char threshold)
+{
+	const sf::Vector2u size{ channel.getSize() };
+	const std::size_t width{ size.x };
+	const std::size_t height{ size.y };
+	std::vector<float> distances(width * height);
+	if (distances.empty())
+		return distances;
+
+	// column pass: distance (in pixels) to the nearest inside pixel and to the nearest outside pixel in the same column
+	// sweeps down then up across whole rows of a strip of columns so the inner loops run over consecutive memory
+	const std::uint32_t infinity{ static_cast<std::uint32_t>(width + height) };
+	std::vector<std::uint32_t> toInside(width * height);
+	std::vector<std::uint32_t> toOutside(width * height);
+	const std::size_t numberOfStrips{ (width + impl::distanceFieldStripWidth - 1_uz) / impl::distanceFieldStripWidth };
+	processInParallel(numberOfStrips, height * impl::distanceFieldStripWidth, [&](const std::size_t begin, const std::size_t end)
+	{
+		for (std::size_t s{ begin }; s < end; ++s)
+		{
+			const std::size_t left{ s * impl::distanceFieldStripWidth };
+			const std::size_t right{ std::min(width, left + impl::distanceFieldStripWidth) };
+			for (std::size_t y{ 0_uz }; y < height; ++y)
+			{
+				const unsigned char* const pixels{ channel.getData() + (y * channel.getStride()) };
+				std::uint32_t* const inside{ toInside.data() + (y * width) };
+				std::uint32_t* const outside{ toOutside.data() + (y * width) };
+				if (y == 0_uz)
+				{
+					for (std::size_t x{ left }; x < right; ++x)
+					{
+						const bool isInside{ pixels[x] >= threshold };
+						inside[x] = isInside ? 0u : infinity;
+						outside[x] = isInside ? infinity : 0u;
+					}
+					continue;
+				}
+				const std::uint32_t* const previousInside{ inside - width };
+				const std::uint32_t* const previousOutside{ outside - width };
+				for (std::size_t x{ left }; x < right; ++x)
+				{
+					const bool isInside{ pixels[x] >= threshold };
+					inside[x] = isInside ? 0u : std::min(infinity, previousInside[x] + 1u);
+					outside[x] = isInside ? std::min(infinity, previousOutside[x] + 1u) : 0u;
+				}
+			}
+			for (std::size_t y{ height - 1_uz }; y > 0_uz; --y)
+			{
+				std::uint32_t* const inside{ toInside.data() + ((y - 1_uz) * width) };
+				std::uint32_t* const outside{ toOutside.data() + ((y - 1_uz) * width) };
+				for (std::size_t x{ left }; x < right; ++x)
+				{
+					inside[x] = std::min(inside[x], inside[x + width] + 1u);
+					outside[x] = std::min(outside[x], outside[x + width] + 1u);
+				}
+			}
+		}
+	});
+
+	// row pass: exact distances from the column distances
+	processInParallel(height, width, [&](const std::size_t begin, const std::size_t end)
+	{
+		std::vector<std::int64_t> squaredToInside(width);
+		std::vector<std::int64_t> squaredToOutside(width);
+		std::vector<std::size_t> sites;
+		std::vector<std::size_t> starts;
+		for (std::size_t y{ begin }; y < end; ++y)
+		{
+			impl::transformDistanceRow(toInside.data() + (y * width), width, squaredToInside.data(), sites, starts);
+			impl::transformDistanceRow(toOutside.data() + (y * width), width, squaredToOutside.data(), sites, starts);
+			float* const row{ distances.data() + (y * width) };
+			for (std::size_t x{ 0_uz }; x < width; ++x)
+			{
+				// one of the squared distances is always zero
+				const float outsideDistance{ std::sqrt(static_cast<float>(squaredToOutside[x])) };
+				const float insideDistance{ std::sqrt(static_cast<float>(squaredToInside[x])) };
+				row[x] = (squaredToInside[x] == 0) ? (outsideDistance - 0.5f) : (0.5f - insideDistance);
+			}
+		}
+	});
+	return distances;
+}
+
+inline Channel createDistanceField(const Channel& channel, const float spread, const unsigned char threshold, const unsigned int downsampleFactor)
+{
+	if (spread <= 0.f)
+		throw Exception(exceptionPrefix + "Cannot create distance field. Spread must be greater than zero.");
+	if (downsampleFactor == 0u)
+		throw Exception(exceptionPrefix + "Cannot create distance field. Downsample factor must be at least one.");
+
+	const sf::Vector2u sourceSize{ channel.getSize() };
+	const sf::Vector2u size{ (sourceSize.x + downsampleFactor - 1u) / downsampleFactor, (sourceSize.y + downsampleFactor - 1u) / downsampleFactor };
+	Channel field(size);
+	if ((size.x == 0u) || (size.y == 0u))
+		return field;
+
+	const std::vector<float> distances{ createSignedDistances(channel, threshold) };
+	const float scale{ 127.5f / spread };
+	processInParallel(size.y, size.x * downsampleFactor * downsampleFactor, [&](const std::size_t begin, const std::size_t end)
+	{
+		for (std::size_t y{ begin }; y < end; ++y)
+		{
+			const std::size_t top{ y * downsampleFactor };
+			const std::size_t bottom{ std::min<std::size_t>(sourceSize.y, top + downsampleFactor) };
+			Channel::Span<unsigned char> row{ field.getRow(static_cast<unsigned int>(y)) };
+			for (std::size_t x{ 0_uz }; x < size.x; ++x)
+			{
+				const std::size_t left{ x * downsampleFactor };
+				const std::size_t right{ std::min<std::size_t>(sourceSize.x, left + downsampleFactor) };
+				float total{ 0.f };
+				for (std::size_t sourceY{ top }; sourceY < bottom; ++sourceY)
+				{
+					for (std::size_t sourceX{ left }; sourceX < right; ++sourceX)
+						total += distances[sourceY * sourceSize.x + sourceX];
+				}
+				const float distance{ total / static_cast<float>((bottom - top) * (right - left)) };
+				row[x] = static_cast<unsigned char>(std::max(0.f, std::min(255.f, 127.5f + distance * scale)) + 0.5f);
+			}
+		}
+	});
+	return field;
+}
+
+	} // namespace Image
+} // namespace plinth
@@ -0,0 +1,81 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// Plinth
+//
+// Copyright(c) 2014-2025 M.J.Silk
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions :
+//
+// 1. The origin of this software must not be misrepresented; you must not
+// claim that you wrote the original software.If you use this software
+// in a product, an acknowledgment in the product documentation would be
+// appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not be
+// misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+// M.J.Silk
+// MJSilk2@gmail.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+
+// REQUIRES C++11
+
+#pragma once
+
+#include "Common.hpp"
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/System/Vector2.hpp>
+#include "Image.hpp"
+#include "ImageChannel.hpp"
+#include "ImageParallel.hpp"
+#include <vector>
+#include <cstdint>
+
+namespace plinth
+{
+	namespace Image
+	{
+
+// blur and convolution filters for channels and (all four components of) images
+// all are separable (horizontal then vertical). edges are clamped (pixels beyond the edge repeat the edge pixel)
+// rows are processed in parallel and columns are processed in parallel strips that are copied into a contiguous tile so that the inner loops run over consecutive memory (and vectorise)
+// results are rounded and clamped to 0-255 after each pass
+
+// box blur: mean of a (2 x radius + 1) square. uses running sums so the time per pixel does not depend on the radius
+// each extra pass makes it closer to a Gaussian (three passes is a close approximation)
+void boxBlur(Channel& channel, unsigned int radius, std::size_t numberOfPasses = 1u);
+void boxBlur(sf::Image& image, unsigned int radius, std::size_t numberOfPasses = 1u);
+
+// exact Gaussian blur. kernel radius is 3 x sigma (rounded up) so time per pixel increases with sigma. for large sigmas, consider a multiple-pass box blur
+void gaussianBlur(Channel& channel, float sigma);
+void gaussianBlur(sf::Image& image, float sigma);
+std::vector<float> createGaussianKernel(float sigma); // normalised (sums to 1)
+
+// separable convolution with any kernels. kernels should have an odd number of weights (the middle weight is at the pixel) and are used as given (not normalised)
+// weights are converted to 16-bit fixed point and clamped to -64 to 64. the sum of absolute weights should be less than 128
+void convolveSeparable(Channel& channel, const std::vector<float>& horizontalKernel, const std::vector<float>& verticalKernel);
+void convolveSeparable(sf::Image& image, const std::vector<float>& horizontalKernel, const std::vector<float>& verticalKernel);
+
+		namespace impl
+		{
+
+template <std::size_t numberOfComponentsT>
+void boxBlur(std::uint8_t* pixels, sf::Vector2u size, unsigned int radius, std::size_t numberOfPasses);
+template <std::size_t numberOfComponentsT>
+void convolveSeparable(std::uint8_t* pixels, sf::Vector2u size, const std::vector<float>& horizontalKernel, const std::vector<float>& verticalKernel);
+
+		} // namespace impl
+
+	} // namespace Image
+} // namespace plinth
+#include "ImageFilter.inl"
@@ -0,0 +1,303 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// Plinth
+//
+// Copyright(c) 2014-2025 M.J.Silk
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions :
+//
+// 1. The origin of this software must not be misrepresented; you must not
+// claim that you wrote the original software.If you use this software
+// in a product, an acknowledgment in the product documentation would be
+// appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not be
+// misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+// M.J.Silk
+// MJSilk2@gmail.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once
+
+#include "ImageFilter.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace plinth
+{
+	namespace Image
+	{
+		namespace impl
+		{
+
+constexpr std::size_t filterStripSize{ 256u }; // bytes of each row in a column strip
+constexpr unsigned int filterPrecisionBits{ 16u }; // of convolution weights
+constexpr unsigned int maximumBoxBlurRadius{ (1u << 22u) - 1u }; // keeps the reciprocal division exact
+
+struct BoxDivisor // division of a box sum by the box size as a multiplication by a reciprocal, exact for all sums of 8-bit values
+{
+	std::uint32_t half;
+	std::uint32_t reciprocal;
+	unsigned int shift;
+
+	explicit BoxDivisor(const std::uint32_t boxSize)
+		: half{ boxSize / 2u }
+		, reciprocal{ 0u }
+		, shift{ 32u }
+	{
+		for (std::uint32_t size{ boxSize }; size > 1u; size >>= 1u)
+			++shift;
+		reciprocal = static_cast<std::uint32_t>(((1ull << shift) + boxSize - 1ull) / boxSize);
+	}
+	std::uint8_t operator()(const std::uint32_t sum) const
+	{
+		return static_cast<std::uint8_t>((static_cast<std::uint64_t>(sum + half) * reciprocal) >> shift);
+	}
+};
+
+inline std::size_t clampFilterIndex(const long long int index, const std::size_t size)
+{
+	return (index < 0ll) ? 0_uz : ((static_cast<std::size_t>(index) >= size) ? (size - 1_uz) : static_cast<std::size_t>(index));
+}
+
+inline void padFilterRow(const std::uint8_t* const row, std::uint8_t* const padded, const std::size_t width, const std::size_t numberOfComponents, const std::size_t radius)
+{
+	// padded has radius pixels either side that repeat the edge pixels
+	std::memcpy(padded + (radius * numberOfComponents), row, width * numberOfComponents);
+	for (std::size_t x{ 0_uz }; x < radius; ++x)
+	{
+		std::memcpy(padded + (x * numberOfComponents), row, numberOfComponents);
+		std::memcpy(padded + ((radius + width + x) * numberOfComponents), row + ((width - 1_uz) * numberOfComponents), numberOfComponents);
+	}
+}
+
+inline void accumulateWeighted(const std::uint8_t* const values, std::int32_t* const accumulators, const std::size_t numberOfValues, const std::int32_t weight)
+{
+	for (std::size_t i{ simd::accumulateWeighted(values, accumulators, numberOfValues, weight) }; i < numberOfValues; ++i)
+		accumulators[i] += values[i] * weight;
+}
+
+inline void narrowFiltered(const std::int32_t* const accumulators, std::uint8_t* const values, const std::size_t numberOfValues)
+{
+	for (std::size_t i{ simd::narrow(accumulators, values, numberOfValues, filterPrecisionBits) }; i < numberOfValues; ++i)
+	{
+		const std::int32_t value{ accumulators[i] >> filterPrecisionBits };
+		values[i] = (value <= 0) ? 0_uc : ((value >= 255) ? 255_uc : static_cast<std::uint8_t>(value));
+	}
+}
+
+template <class ProcessT>
+inline void processFilterStrips(std::uint8_t* const pixels, const sf::Vector2u size, const std::size_t numberOfComponents, ProcessT process)
+{
+	// process(const std::uint8_t* strip, std::uint8_t* destination, std::size_t stripSize, std::size_t rowSize) is called for each column strip
+	// strip is a contiguous copy of the strip's rows (each stripSize bytes) and destination is the strip's first row in the image
+	const std::size_t rowSize{ size.x * numberOfComponents };
+	const std::size_t numberOfStrips{ (rowSize + filterStripSize - 1_uz) / filterStripSize };
+	processInParallel(numberOfStrips, size.y * (filterStripSize / numberOfComponents), [&](const std::size_t begin, const std::size_t end)
+	{
+		std::vector<std::uint8_t> strip(filterStripSize * size.y);
+		for (std::size_t s{ begin }; s < end; ++s)
+		{
+			const std::size_t offset{ s * filterStripSize };
+			const std::size_t stripSize{ std::min(filterStripSize, rowSize - offset) };
+			for (std::size_t y{ 0_uz }; y < size.y; ++y)
+				std::memcpy(strip.data() + (y * stripSize), pixels + (y * rowSize) + offset, stripSize);
+			process(strip.data(), pixels + offset, stripSize, rowSize);
+		}
+	});
+}
+
+template <std::size_t numberOfComponentsT>
+inline void boxBlur(std::uint8_t* const pixels, const sf::Vector2u size, unsigned int radius, const std::size_t numberOfPasses)
+{
+	if ((pixels == nullptr) || (radius == 0u) || (size.x == 0u) || (size.y == 0u))
+		return;
+	radius = std::min(radius, maximumBoxBlurRadius);
+	const std::size_t boxSize{ 2_uz * radius + 1_uz };
+	const BoxDivisor divide{ static_cast<std::uint32_t>(boxSize) };
+	const std::size_t rowSize{ size.x * numberOfComponentsT };
+
+	for (std::size_t pass{ 0_uz }; pass < numberOfPasses; ++pass)
+	{
+		// horizontal: running sums along a copy of the row that is padded with the edge pixels (one extra pixel at the end so the last slide can be done unconditionally)
+		processInParallel(size.y, size.x, [&](const std::size_t begin, const std::size_t end)
+		{
+			std::vector<std::uint8_t> padded((size.x + boxSize) * numberOfComponentsT);
+			for (std::size_t y{ begin }; y < end; ++y)
+			{
+				std::uint8_t* const row{ pixels + (y * rowSize) };
+				padFilterRow(row, padded.data(), size.x, numberOfComponentsT, radius);
+				std::memcpy(padded.data() + ((size.x + boxSize - 1_uz) * numberOfComponentsT), row + ((size.x - 1_uz) * numberOfComponentsT), numberOfComponentsT);
+
+				std::uint32_t sums[numberOfComponentsT]{};
+				for (std::size_t x{ 0_uz }; x < boxSize; ++x)
+				{
+					for (std::size_t c{ 0_uz }; c < numberOfComponentsT; ++c)
+						sums[c] += padded[x * numberOfComponentsT + c];
+				}
+				const std::uint8_t* leaving{ padded.data() };
+				const std::uint8_t* entering{ padded.data() + (boxSize * numberOfComponentsT) };
+				for (std::size_t x{ 0_uz }; x < size.x; ++x)
+				{
+					for (std::size_t c{ 0_uz }; c < numberOfComponentsT; ++c)
+					{
+						row[x * numberOfComponentsT + c] = divide(sums[c]);
+						sums[c] += static_cast<std::uint32_t>(entering[c]) - leaving[c];
+					}
+					entering += numberOfComponentsT;
+					leaving += numberOfComponentsT;
+				}
+			}
+		});
+
+		// vertical: running sums of whole strip rows
+		processFilterStrips(pixels, size, numberOfComponentsT, [&](const std::uint8_t* const strip, std::uint8_t* const destination, const std::size_t stripSize, const std::size_t destinationRowSize)
+		{
+			std::vector<std::uint32_t> sums(stripSize, 0u);
+			for (long long int y{ -static_cast<long long int>(radius) }; y <= static_cast<long long int>(radius); ++y)
+			{
+				const std::uint8_t* const row{ strip + (clampFilterIndex(y, size.y) * stripSize) };
+				for (std::size_t i{ 0_uz }; i < stripSize; ++i)
+					sums[i] += row[i];
+			}
+			for (std::size_t y{ 0_uz }; y < size.y; ++y)
+			{
+				std::uint8_t* const row{ destination + (y * destinationRowSize) };
+				const std::uint8_t* const entering{ strip + (clampFilterIndex(static_cast<long long int>(y + radius) + 1ll, size.y) * stripSize) };
+				const std::uint8_t* const leaving{ strip + (clampFilterIndex(static_cast<long long int>(y) - radius, size.y) * stripSize) };
+				for (std::size_t i{ simd::slideBox(sums.data(), entering, leaving, row, stripSize, divide.half, divide.reciprocal, divide.shift) }; i < stripSize; ++i)
+				{
+					row[i] = divide(sums[i]);
+					sums[i] += static_cast<std::uint32_t>(entering[i]) - leaving[i];
+				}
+			}
+		});
+	}
+}
+
+inline std::vector<std::int32_t> createFixedPointKernel(const std::vector<float>& kernel)
+{
+	// weights are clamped so that the split multiplication of the SIMD paths can be used
+	const double limit{ static_cast<double>((1 << 22) - 1) };
+	std::vector<std::int32_t> fixedKernel(kernel.size());
+	for (std::size_t i{ 0_uz }; i < kernel.size(); ++i)
+		fixedKernel[i] = static_cast<std::int32_t>(std::lround(std::max(-limit, std::min(limit, kernel[i] * static_cast<double>(1u << filterPrecisionBits)))));
+	return fixedKernel;
+}
+
+template <std::size_t numberOfComponentsT>
+inline void convolveSeparable(std::uint8_t* const pixels, const sf::Vector2u size, const std::vector<float>& horizontalKernel, const std::vector<float>& verticalKernel)
+{
+	if ((pixels == nullptr) || (size.x == 0u) || (size.y == 0u))
+		return;
+	const std::vector<std::int32_t> horizontal{ createFixedPointKernel(horizontalKernel) };
+	const std::vector<std::int32_t> vertical{ createFixedPointKernel(verticalKernel) };
+	const std::int32_t rounding{ 1 << (filterPrecisionBits - 1u) };
+	const std::size_t rowSize{ size.x * numberOfComponentsT };
+
+	// horizontal: each weight is applied to a whole (padded) row so the inner loop runs over consecutive memory
+	if (!horizontal.empty())
+	{
+		const std::size_t radius{ horizontal.size() / 2_uz };
+		processInParallel(size.y, size.x * horizontal.size(), [&](const std::size_t begin, const std::size_t end)
+		{
+			std::vector<std::uint8_t> padded((size.x + horizontal.size()) * numberOfComponentsT);
+			std::vector<std::int32_t> accumulators(rowSize);
+			for (std::size_t y{ begin }; y < end; ++y)
+			{
+				std::uint8_t* const row{ pixels + (y * rowSize) };
+				padFilterRow(row, padded.data(), size.x, numberOfComponentsT, radius);
+				std::fill(accumulators.begin(), accumulators.end(), rounding);
+				for (std::size_t t{ 0_uz }; t < horizontal.size(); ++t)
+					accumulateWeighted(padded.data() + (t * numberOfComponentsT), accumulators.data(), rowSize, horizontal[t]);
+				narrowFiltered(accumulators.data(), row, rowSize);
+			}
+		});
+	}
+
+	// vertical: each weight is applied to a whole strip row
+	if (!vertical.empty())
+	{
+		const long long int radius{ static_cast<long long int>(vertical.size() / 2_uz) };
+		processFilterStrips(pixels, size, numberOfComponentsT, [&](const std::uint8_t* const strip, std::uint8_t* const destination, const std::size_t stripSize, const std::size_t destinationRowSize)
+		{
+			std::vector<std::int32_t> accumulators(stripSize);
+			for (std::size_t y{ 0_uz }; y < size.y; ++y)
+			{
+				std::fill(accumulators.begin(), accumulators.end(), rounding);
+				for (std::size_t t{ 0_uz }; t < vertical.size(); ++t)
+					accumulateWeighted(strip + (clampFilterIndex(static_cast<long long int>(y + t) - radius, size.y) * stripSize), accumulators.data(), stripSize, vertical[t]);
+				narrowFiltered(accumulators.data(), destination + (y * destinationRowSize), stripSize);
+			}
+		});
+	}
+}
+
+		} // namespace impl
+
+inline void boxBlur(Channel& channel, const unsigned int radius, const std::size_t numberOfPasses)
+{
+	impl::boxBlur<1u>(channel.getData(), channel.getSize(), radius, numberOfPasses);
+}
+
+inline void boxBlur(sf::Image& image, const unsigned int radius, const std::size_t numberOfPasses)
+{
+	impl::boxBlur<4u>(impl::getPixels(image), image.getSize(), radius, numberOfPasses);
+}
+
+inline void gaussianBlur(Channel& channel, const float sigma)
+{
+	const std::vector<float> kernel{ createGaussianKernel(sigma) };
+	impl::convolveSeparable<1u>(channel.getData(), channel.getSize(), kernel, kernel);
+}
+
+inline void gaussianBlur(sf::Image& image, const float sigma)
+{
+	const std::vector<float> kernel{ createGaussianKernel(sigma) };
+	impl::convolveSeparable<4u>(impl::getPixels(image), image.getSize(), kernel, kernel);
+}
+
+inline std::vector<float> createGaussianKernel(const float sigma)
+{
+	if (sigma <= 0.f)
+		return{ 1.f };
+	const std::size_t radius{ static_cast<std::size_t>(std::ceil(3.f * sigma)) };
+	std::vector<float> kernel(radius * 2_uz + 1_uz);
+	double total{ 0.0 };
+	for (std::size_t i{ 0_uz }; i < kernel.size(); ++i)
+	{
+		const double x{ static_cast<double>(i) - static_cast<double>(radius) };
+		const double weight{ std::exp(-(x * x) / (2.0 * sigma * sigma)) };
+		kernel[i] = static_cast<float>(weight);
+		total += weight;
+	}
+	for (auto& weight : kernel)
+		weight = static_cast<float>(weight / total);
+	return kernel;
+}
+
+inline void convolveSeparable(Channel& channel, const std::vector<float>& horizontalKernel, const std::vector<float>& verticalKernel)
+{
+	impl::convolveSeparable<1u>(channel.getData(), channel.getSize(), horizontalKernel, verticalKernel);
+}
+
+inline void convolveSeparable(sf::Image& image, const std::vector<float>& horizontalKernel, const std::vector<float>& verticalKernel)
+{
+	impl::convolveSeparable<4u>(impl::getPixels(image), image.getSize(), horizontalKernel, verticalKernel);
+}
+
+	} // namespace Image
+} // namespace plinth
@@ -0,0 +1,92 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// Plinth
+//
+// Copyright(c) 2014-2025 M.J.Silk
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions :
+//
+// 1. The origin of this software must not be misrepresented; you must not
+// claim that you wrote the original software.If you use this software
+// in a product, an acknowledgment in the product documentation would be
+// appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not be
+// misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+// M.J.Silk
+// MJSilk2@gmail.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+
+// REQUIRES C++11
+
+#pragma once
+
+#include "Common.hpp"
+#include <SFML/Graphics/Image.hpp>
+#include "Image.hpp"
+#include "ImageChannel.hpp"
+#include "ImageParallel.hpp"
+#include <array>
+#include <cstdint>
+
+namespace plinth
+{
+	namespace Image
+	{
+
+// histograms and lookup tables (LUTs) of 8-bit values: any per-component adjustment (levels, curves, equalisation etc.) is a single table lookup per byte
+// both are processed in parallel for large images and channels (see processInParallel). each thread counts into its own partial histograms, which are then summed
+
+using Histogram = std::array<std::uint64_t, 256u>; // number of pixels with each value
+using Lut = std::array<std::uint8_t, 256u>; // new value for each value
+
+struct ImageHistogram
+{
+	Histogram red;
+	Histogram green;
+	Histogram blue;
+	Histogram alpha;
+};
+
+ImageHistogram createHistogram(const sf::Image& image);
+Histogram createHistogram(const Channel& channel);
+
+void applyLut(sf::Image& image, const Lut& red, const Lut& green, const Lut& blue, const Lut& alpha);
+void applyLut(sf::Image& image, const Lut& rgb); // alpha is unchanged
+void applyLut(Channel& channel, const Lut& lut);
+
+Lut createIdentityLut();
+Lut createLevelsLut(unsigned char inputLow, unsigned char inputHigh, float gamma = 1.f, unsigned char outputLow = 0_uc, unsigned char outputHigh = 255_uc); // input range is stretched to output range (values outside are clamped). gamma greater than 1 brightens mid-tones. throws if input high is not greater than input low or gamma is not greater than zero
+Lut createEqualizationLut(const Histogram& histogram); // spreads values so that the cumulative histogram is (as close as possible to) a straight line. identity if there is only one value
+
+// automatic adjustments. alpha is unchanged
+// clipped fraction of the darkest and of the lightest pixels are ignored when finding the range (e.g. so that a few noisy pixels do not prevent stretching). it must be from 0 to 0.5
+// per component adjusts red, green and blue independently (which can also remove a colour cast). otherwise, one LUT (from their combined histogram) is used for all three so hue is kept
+void autoLevels(sf::Image& image, float clippedFraction = 0.001f, bool isPerComponent = true); // stretches the range of values to 0-255
+void autoLevels(Channel& channel, float clippedFraction = 0.001f);
+void equalizeHistogram(sf::Image& image, bool isPerComponent = false);
+void equalizeHistogram(Channel& channel);
+
+		namespace impl
+		{
+
+using PartialHistograms = std::array<std::array<std::uint32_t, 256u>, 16u>; // one for each byte position in a block of 16 bytes
+
+void countHistograms(const std::uint8_t* values, std::size_t numberOfValues, PartialHistograms& partialHistograms); // value i is counted in partial histogram (i % 16)
+
+		} // namespace impl
+
+	} // namespace Image
+} // namespace plinth
+#include "ImageHistogram.inl"
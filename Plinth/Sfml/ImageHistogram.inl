@@ -0,0 +1,256 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// Plinth
+//
+// Copyright(c) 2014-2025 M.J.Silk
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions :
+//
+// 1. The origin of this software must not be misrepresented; you must not
+// claim that you wrote the original software.If you use this software
+// in a product, an acknowledgment in the product documentation would be
+// appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not be
+// misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+// M.J.Silk
+// MJSilk2@gmail.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once
+
+#include "ImageHistogram.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <mutex>
+
+namespace plinth
+{
+	namespace Image
+	{
+		namespace impl
+		{
+
+inline void countHistograms(const std::uint8_t* const values, const std::size_t numberOfValues, PartialHistograms& partialHistograms)
+{
+	// each of the 16 bytes of a block is counted in a different partial histogram so that consecutive equal values (e.g. an opaque alpha) do not wait for each other's increments
+	std::size_t i{ 0_uz };
+	for (; (i + 16_uz) <= numberOfValues; i += 16_uz)
+	{
+		for (std::size_t b{ 0_uz }; b < 16_uz; ++b)
+			++partialHistograms[b][values[i + b]];
+	}
+	for (; i < numberOfValues; ++i)
+		++partialHistograms[i % 16_uz][values[i]];
+}
+
+inline std::array<Histogram, 4u> createHistograms(const std::uint8_t* const values, const sf::Vector2u size, const std::size_t stride, const std::size_t numberOfComponents)
+{
+	// numberOfComponents must be 1 or 4 and stride is in values. rows are counted separately (each starting at partial histogram zero) so that the component of partial histogram p is (p % numberOfComponents)
+	// a band of rows would need more than 2^36 values to overflow its partial histograms
+	std::array<Histogram, 4u> histograms{};
+	std::mutex mutex;
+	const std::size_t rowSize{ size.x * numberOfComponents };
+	processInParallel(size.y, size.x, [&](const std::size_t begin, const std::size_t end)
+	{
+		PartialHistograms partialHistograms{};
+		for (std::size_t y{ begin }; y < end; ++y)
+			countHistograms(values + (y * stride), rowSize, partialHistograms);
+		std::lock_guard<std::mutex> lock(mutex);
+		for (std::size_t p{ 0_uz }; p < partialHistograms.size(); ++p)
+		{
+			Histogram& histogram{ histograms[p % numberOfComponents] };
+			for (std::size_t v{ 0_uz }; v < 256_uz; ++v)
+				histogram[v] += partialHistograms[p][v];
+		}
+	});
+	return histograms;
+}
+
+inline void findHistogramRange(const Histogram& histogram, const float clippedFraction, std::size_t& low, std::size_t& high)
+{
+	// lowest and highest values after ignoring the clipped fraction of values from each end
+	std::uint64_t total{ 0u };
+	for (const std::uint64_t count : histogram)
+		total += count;
+	const std::uint64_t clipped{ static_cast<std::uint64_t>(static_cast<double>(total) * clippedFraction) };
+	std::uint64_t count{ 0u };
+	for (low = 0_uz; low < 255_uz; ++low)
+	{
+		count += histogram[low];
+		if (count > clipped)
+			break;
+	}
+	count = 0u;
+	for (high = 255_uz; high > 0_uz; --high)
+	{
+		count += histogram[high];
+		if (count > clipped)
+			break;
+	}
+}
+
+inline Lut createAutoLevelsLut(const Histogram& histogram, const float clippedFraction)
+{
+	std::size_t low;
+	std::size_t high;
+	findHistogramRange(histogram, clippedFraction, low, high);
+	if (high <= low)
+		return createIdentityLut();
+	return createLevelsLut(static_cast<unsigned char>(low), static_cast<unsigned char>(high));
+}
+
+inline Histogram combineRgbHistograms(const ImageHistogram& histogram)
+{
+	Histogram combined;
+	for (std::size_t v{ 0_uz }; v < 256_uz; ++v)
+		combined[v] = histogram.red[v] + histogram.green[v] + histogram.blue[v];
+	return combined;
+}
+
+inline void validateClippedFraction(const float clippedFraction)
+{
+	if (!(clippedFraction >= 0.f) || !(clippedFraction <= 0.5f))
+		throw Exception(exceptionPrefix + "Cannot apply auto levels. Clipped fraction must be from 0 to 0.5.");
+}
+
+		} // namespace impl
+
+inline ImageHistogram createHistogram(const sf::Image& image)
+{
+	const std::array<Histogram, 4u> histograms{ impl::createHistograms(image.getPixelsPtr(), image.getSize(), image.getSize().x * 4_uz, 4_uz) };
+	return{ histograms[0u], histograms[1u], histograms[2u], histograms[3u] };
+}
+
+inline Histogram createHistogram(const Channel& channel)
+{
+	return impl::createHistograms(channel.getData(), channel.getSize(), channel.getStride(), 1_uz)[0u];
+}
+
+inline void applyLut(sf::Image& image, const Lut& red, const Lut& green, const Lut& blue, const Lut& alpha)
+{
+	processAllRows(image, [&](std::uint8_t* const row, unsigned int, const unsigned int width)
+	{
+		std::uint8_t* const end{ row + (width * 4_uz) };
+		for (std::uint8_t* pixel{ row }; pixel != end; pixel += 4u)
+		{
+			pixel[0u] = red[pixel[0u]];
+			pixel[1u] = green[pixel[1u]];
+			pixel[2u] = blue[pixel[2u]];
+			pixel[3u] = alpha[pixel[3u]];
+		}
+	}, true);
+}
+
+inline void applyLut(sf::Image& image, const Lut& rgb)
+{
+	applyLut(image, rgb, rgb, rgb, createIdentityLut());
+}
+
+inline void applyLut(Channel& channel, const Lut& lut)
+{
+	const sf::Vector2u size{ channel.getSize() };
+	processInParallel(size.y, size.x, [&](const std::size_t begin, const std::size_t end)
+	{
+		for (std::size_t y{ begin }; y < end; ++y)
+		{
+			for (unsigned char& value : channel.getRow(static_cast<unsigned int>(y)))
+				value = lut[value];
+		}
+	});
+}
+
+inline Lut createIdentityLut()
+{
+	Lut lut;
+	for (std::size_t v{ 0_uz }; v < 256_uz; ++v)
+		lut[v] = static_cast<std::uint8_t>(v);
+	return lut;
+}
+
+inline Lut createLevelsLut(const unsigned char inputLow, const unsigned char inputHigh, const float gamma, const unsigned char outputLow, const unsigned char outputHigh)
+{
+	if (inputHigh <= inputLow)
+		throw Exception(exceptionPrefix + "Cannot create levels LUT. Input high must be greater than input low.");
+	if (!(gamma > 0.f))
+		throw Exception(exceptionPrefix + "Cannot create levels LUT. Gamma must be greater than zero.");
+
+	Lut lut;
+	const double inverseGamma{ 1.0 / gamma };
+	for (std::size_t v{ 0_uz }; v < 256_uz; ++v)
+	{
+		double alpha{ (static_cast<double>(v) - inputLow) / (inputHigh - inputLow) };
+		alpha = std::pow(std::min(std::max(alpha, 0.0), 1.0), inverseGamma);
+		lut[v] = static_cast<std::uint8_t>(std::lround(outputLow + alpha * (static_cast<double>(outputHigh) - outputLow)));
+	}
+	return lut;
+}
+
+inline Lut createEqualizationLut(const Histogram& histogram)
+{
+	// cumulative count (excluding the lowest value present) scaled to 0-255
+	std::uint64_t total{ 0u };
+	for (const std::uint64_t count : histogram)
+		total += count;
+	std::size_t lowest{ 0_uz };
+	while ((lowest < 255_uz) && (histogram[lowest] == 0u))
+		++lowest;
+	const std::uint64_t lowestCount{ histogram[lowest] };
+	if (total == lowestCount)
+		return createIdentityLut();
+
+	Lut lut;
+	const double scale{ 255.0 / static_cast<double>(total - lowestCount) };
+	std::uint64_t cumulative{ 0u };
+	for (std::size_t v{ 0_uz }; v < 256_uz; ++v)
+	{
+		cumulative += histogram[v];
+		lut[v] = (cumulative <= lowestCount) ? 0_uc : static_cast<std::uint8_t>(std::lround(static_cast<double>(cumulative - lowestCount) * scale));
+	}
+	return lut;
+}
+
+inline void autoLevels(sf::Image& image, const float clippedFraction, const bool isPerComponent)
+{
+	impl::validateClippedFraction(clippedFraction);
+	const ImageHistogram histogram{ createHistogram(image) };
+	if (isPerComponent)
+		applyLut(image, impl::createAutoLevelsLut(histogram.red, clippedFraction), impl::createAutoLevelsLut(histogram.green, clippedFraction), impl::createAutoLevelsLut(histogram.blue, clippedFraction), createIdentityLut());
+	else
+		applyLut(image, impl::createAutoLevelsLut(impl::combineRgbHistograms(histogram), clippedFraction));
+}
+
+inline void autoLevels(Channel& channel, const float clippedFraction)
+{
+	impl::validateClippedFraction(clippedFraction);
+	applyLut(channel, impl::createAutoLevelsLut(createHistogram(channel), clippedFraction));
+}
+
+inline void equalizeHistogram(sf::Image& image, const bool isPerComponent)
+{
+	const ImageHistogram histogram{ createHistogram(image) };
+	if (isPerComponent)
+		applyLut(image, createEqualizationLut(histogram.red), createEqualizationLut(histogram.green), createEqualizationLut(histogram.blue), createIdentityLut());
+	else
+		applyLut(image, createEqualizationLut(impl::combineRgbHistograms(histogram)));
+}
+
+inline void equalizeHistogram(Channel& channel)
+{
+	applyLut(channel, createEqualizationLut(createHistogram(channel)));
+}
+
+	} // namespace Image
+} // namespace plinth
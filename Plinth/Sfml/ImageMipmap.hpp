@@ -0,0 +1,87 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// Plinth
+//
+// Copyright(c) 2014-2025 M.J.Silk
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions :
+//
+// 1. The origin of this software must not be misrepresented; you must not
+// claim that you wrote the original software.If you use this software
+// in a product, an acknowledgment in the product documentation would be
+// appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not be
+// misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+// M.J.Silk
+// MJSilk2@gmail.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+
+// REQUIRES C++11
+
+#pragma once
+
+#include "Common.hpp"
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/System/Vector2.hpp>
+#include "Image.hpp"
+#include "ImageParallel.hpp"
+#include "ImageSimd.hpp"
+#include "ImageSrgb.hpp"
+#include <vector>
+#include <cstdint>
+
+namespace plinth
+{
+	namespace Image
+	{
+
+enum class MipmapFilter
+{
+	Box, // mean of each 2x2 block
+	Tent // 4x4 (1-3-3-1) weighted mean centred on each 2x2 block. smoother with less aliasing
+};
+
+// mipmaps (image pyramid): each level is half the size of the previous (rounded down but at least 1) and is created from the previous level, down to 1x1
+// level 0 is the original image. a maximum number of levels of zero creates all levels
+// gamma-correct averages linear light (decoded from sRGB) instead of the encoded bytes, which keeps downscaled images from darkening
+// alpha-weighted weights colour by alpha so colours of fully transparent pixels do not bleed into visible ones. alpha itself is still a plain mean
+// Box without gamma-correct or alpha-weighted uses SIMD (see setMaximumInstructionSet). all levels are processed in parallel across rows for large levels (see processInParallel)
+struct MipmapBuffer
+{
+	std::vector<std::uint8_t> pixels; // all levels, one after the other. each level is tightly packed RGBA rows
+	std::vector<sf::Vector2u> sizes; // size of each level
+	std::vector<std::size_t> offsets; // offset (in bytes) of each level in pixels
+
+	std::size_t getNumberOfLevels() const;
+	const std::uint8_t* getLevelPixels(std::size_t level) const;
+	sf::Image getLevelImage(std::size_t level) const;
+};
+
+std::size_t getNumberOfMipmapLevels(sf::Vector2u size); // including level 0
+sf::Vector2u getMipmapLevelSize(sf::Vector2u size, std::size_t level);
+sf::Image createHalfSize(const sf::Image& image, MipmapFilter filter = MipmapFilter::Box, bool isGammaCorrect = false, bool isAlphaWeighted = false); // next mipmap level
+std::vector<sf::Image> createMipmaps(const sf::Image& image, MipmapFilter filter = MipmapFilter::Box, bool isGammaCorrect = false, bool isAlphaWeighted = false, std::size_t maximumNumberOfLevels = 0u);
+MipmapBuffer createMipmapBuffer(const sf::Image& image, MipmapFilter filter = MipmapFilter::Box, bool isGammaCorrect = false, bool isAlphaWeighted = false, std::size_t maximumNumberOfLevels = 0u);
+
+		namespace impl
+		{
+
+void downsampleMipmap(const std::uint8_t* source, sf::Vector2u sourceSize, std::uint8_t* destination, MipmapFilter filter, bool isGammaCorrect, bool isAlphaWeighted); // destination is getMipmapLevelSize(sourceSize, 1)
+
+		} // namespace impl
+
+	} // namespace Image
+} // namespace plinth
+#include "ImageMipmap.inl"
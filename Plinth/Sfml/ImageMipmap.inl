@@ -0,0 +1,261 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// Plinth
+//
+// Copyright(c) 2014-2025 M.J.Silk
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions :
+//
+// 1. The origin of this software must not be misrepresented; you must not
+// claim that you wrote the original software.If you use this software
+// in a product, an acknowledgment in the product documentation would be
+// appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not be
+// misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+// M.J.Silk
+// MJSilk2@gmail.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once
+
+#include "ImageMipmap.hpp"
+
+#include <cstring>
+
+namespace plinth
+{
+	namespace Image
+	{
+		namespace impl
+		{
+
+struct MipmapTaps
+{
+	std::size_t numberOfTaps;
+	int offsets[4u]; // from the first source pixel (2 x destination)
+	std::uint32_t weights[4u];
+	std::uint32_t total; // of weights in both directions
+};
+
+inline MipmapTaps getMipmapTaps(const MipmapFilter filter)
+{
+	if (filter == MipmapFilter::Tent)
+		return{ 4_uz, { -1, 0, 1, 2 }, { 1u, 3u, 3u, 1u }, 64u };
+	return{ 2_uz, { 0, 1, 0, 0 }, { 1u, 1u, 0u, 0u }, 4u };
+}
+
+inline unsigned int clampMipmapSource(const long long int index, const unsigned int size)
+{
+	return static_cast<unsigned int>((index < 0ll) ? 0ll : ((index >= size) ? (size - 1ll) : index));
+}
+
+template <std::size_t numberOfTapsT, bool isGammaCorrectT, bool isAlphaWeightedT>
+inline void downsampleMipmapRows(const std::uint8_t* const source, const sf::Vector2u sourceSize, std::uint8_t* const destination, const sf::Vector2u destinationSize, const MipmapTaps& taps, const std::size_t begin, const std::size_t end)
+{
+	// colour sums fit in 32 bits: 65535 (linear) x 255 (alpha) x 64 (total weight) < 2^32
+	const std::array<std::uint16_t, 256u>& decode{ getSrgbToLinearTable() };
+	const std::uint8_t* const encode{ getLinearToSrgbTable().data() };
+	const std::size_t sourceRowSize{ sourceSize.x * 4_uz };
+	for (std::size_t y{ begin }; y < end; ++y)
+	{
+		const std::uint8_t* rows[numberOfTapsT];
+		for (std::size_t j{ 0_uz }; j < numberOfTapsT; ++j)
+			rows[j] = source + (clampMipmapSource(static_cast<long long int>(y * 2_uz) + taps.offsets[j], sourceSize.y) * sourceRowSize);
+		std::uint8_t* pixel{ destination + (y * destinationSize.x * 4_uz) };
+		for (unsigned int x{ 0u }; x < destinationSize.x; ++x, pixel += 4)
+		{
+			std::size_t columns[numberOfTapsT];
+			for (std::size_t i{ 0_uz }; i < numberOfTapsT; ++i)
+				columns[i] = clampMipmapSource(static_cast<long long int>(x * 2ll) + taps.offsets[i], sourceSize.x) * 4_uz;
+
+			std::uint32_t colors[3u]{ 0u, 0u, 0u };
+			std::uint32_t unweightedColors[3u]{ 0u, 0u, 0u }; // used if alpha-weighted and all alpha is zero
+			std::uint32_t alpha{ 0u };
+			for (std::size_t j{ 0_uz }; j < numberOfTapsT; ++j)
+			{
+				for (std::size_t i{ 0_uz }; i < numberOfTapsT; ++i)
+				{
+					const std::uint8_t* const sample{ rows[j] + columns[i] };
+					const std::uint32_t weight{ taps.weights[j] * taps.weights[i] };
+					const std::uint32_t alphaWeight{ weight * sample[3u] };
+					for (std::size_t c{ 0_uz }; c < 3_uz; ++c)
+					{
+						const std::uint32_t value{ static_cast<std::uint32_t>(isGammaCorrectT ? decode[sample[c]] : sample[c]) };
+						if (isAlphaWeightedT)
+						{
+							colors[c] += value * alphaWeight;
+							unweightedColors[c] += value * weight;
+						}
+						else
+							colors[c] += value * weight;
+					}
+					alpha += alphaWeight;
+				}
+			}
+			const bool isWeighted{ isAlphaWeightedT && (alpha > 0u) };
+			const std::uint32_t divisor{ isWeighted ? alpha : taps.total };
+			for (std::size_t c{ 0_uz }; c < 3_uz; ++c)
+			{
+				const std::uint32_t sum{ (isAlphaWeightedT && !isWeighted) ? unweightedColors[c] : colors[c] };
+				const std::uint32_t value{ (sum + (divisor / 2u)) / divisor };
+				pixel[c] = isGammaCorrectT ? encode[value] : static_cast<std::uint8_t>(value);
+			}
+			pixel[3u] = static_cast<std::uint8_t>((alpha + (taps.total / 2u)) / taps.total);
+		}
+	}
+}
+
+inline void downsampleMipmapBoxRows(const std::uint8_t* const source, const sf::Vector2u sourceSize, std::uint8_t* const destination, const sf::Vector2u destinationSize, const std::size_t begin, const std::size_t end)
+{
+	// source must be at least 2 pixels wide
+	const std::size_t sourceRowSize{ sourceSize.x * 4_uz };
+	for (std::size_t y{ begin }; y < end; ++y)
+	{
+		const std::uint8_t* const upperRow{ source + (clampMipmapSource(static_cast<long long int>(y * 2_uz), sourceSize.y) * sourceRowSize) };
+		const std::uint8_t* const lowerRow{ source + (clampMipmapSource(static_cast<long long int>(y * 2_uz + 1_uz), sourceSize.y) * sourceRowSize) };
+		std::uint8_t* const row{ destination + (y * destinationSize.x * 4_uz) };
+		const std::size_t numberOfProcessedPixels{ simd::downsampleBox(upperRow, lowerRow, row, destinationSize.x) };
+		for (std::size_t i{ numberOfProcessedPixels * 4_uz }; i < destinationSize.x * 4_uz; ++i)
+		{
+			const std::size_t left{ ((i / 4_uz) * 8_uz) + (i % 4_uz) };
+			row[i] = static_cast<std::uint8_t>((upperRow[left] + upperRow[left + 4_uz] + lowerRow[left] + lowerRow[left + 4_uz] + 2u) / 4u);
+		}
+	}
+}
+
+template <std::size_t numberOfTapsT>
+inline void downsampleMipmapRows(const std::uint8_t* const source, const sf::Vector2u sourceSize, std::uint8_t* const destination, const sf::Vector2u destinationSize, const MipmapTaps& taps, const bool isGammaCorrect, const bool isAlphaWeighted, const std::size_t begin, const std::size_t end)
+{
+	if (isGammaCorrect && isAlphaWeighted)
+		downsampleMipmapRows<numberOfTapsT, true, true>(source, sourceSize, destination, destinationSize, taps, begin, end);
+	else if (isGammaCorrect)
+		downsampleMipmapRows<numberOfTapsT, true, false>(source, sourceSize, destination, destinationSize, taps, begin, end);
+	else if (isAlphaWeighted)
+		downsampleMipmapRows<numberOfTapsT, false, true>(source, sourceSize, destination, destinationSize, taps, begin, end);
+	else
+		downsampleMipmapRows<numberOfTapsT, false, false>(source, sourceSize, destination, destinationSize, taps, begin, end);
+}
+
+inline void downsampleMipmap(const std::uint8_t* const source, const sf::Vector2u sourceSize, std::uint8_t* const destination, const MipmapFilter filter, const bool isGammaCorrect, const bool isAlphaWeighted)
+{
+	const sf::Vector2u destinationSize{ getMipmapLevelSize(sourceSize, 1_uz) };
+	const MipmapTaps taps{ getMipmapTaps(filter) };
+	processInParallel(destinationSize.y, destinationSize.x * taps.numberOfTaps, [&](const std::size_t begin, const std::size_t end)
+	{
+		if ((filter == MipmapFilter::Box) && !isGammaCorrect && !isAlphaWeighted && (sourceSize.x > 1u))
+			downsampleMipmapBoxRows(source, sourceSize, destination, destinationSize, begin, end);
+		else if (filter == MipmapFilter::Tent)
+			downsampleMipmapRows<4u>(source, sourceSize, destination, destinationSize, taps, isGammaCorrect, isAlphaWeighted, begin, end);
+		else
+			downsampleMipmapRows<2u>(source, sourceSize, destination, destinationSize, taps, isGammaCorrect, isAlphaWeighted, begin, end);
+	});
+}
+
+		} // namespace impl
+
+inline std::size_t MipmapBuffer::getNumberOfLevels() const
+{
+	return sizes.size();
+}
+
+inline const std::uint8_t* MipmapBuffer::getLevelPixels(const std::size_t level) const
+{
+	return pixels.data() + offsets[level];
+}
+
+inline sf::Image MipmapBuffer::getLevelImage(const std::size_t level) const
+{
+	return sf::Image(sizes[level], getLevelPixels(level));
+}
+
+inline std::size_t getNumberOfMipmapLevels(sf::Vector2u size)
+{
+	if ((size.x == 0u) || (size.y == 0u))
+		return 0_uz;
+	std::size_t numberOfLevels{ 1_uz };
+	while ((size.x > 1u) || (size.y > 1u))
+	{
+		size = getMipmapLevelSize(size, 1_uz);
+		++numberOfLevels;
+	}
+	return numberOfLevels;
+}
+
+inline sf::Vector2u getMipmapLevelSize(sf::Vector2u size, std::size_t level)
+{
+	for (; level > 0_uz; --level)
+		size = { (size.x > 1u) ? (size.x / 2u) : 1u, (size.y > 1u) ? (size.y / 2u) : 1u };
+	return size;
+}
+
+inline sf::Image createHalfSize(const sf::Image& image, const MipmapFilter filter, const bool isGammaCorrect, const bool isAlphaWeighted)
+{
+	const sf::Vector2u imageSize{ image.getSize() };
+	if ((imageSize.x == 0u) || (imageSize.y == 0u))
+		return sf::Image{};
+	sf::Image result;
+	result.resize(getMipmapLevelSize(imageSize, 1_uz));
+	impl::downsampleMipmap(image.getPixelsPtr(), imageSize, impl::getPixels(result), filter, isGammaCorrect, isAlphaWeighted);
+	return result;
+}
+
+inline std::vector<sf::Image> createMipmaps(const sf::Image& image, const MipmapFilter filter, const bool isGammaCorrect, const bool isAlphaWeighted, const std::size_t maximumNumberOfLevels)
+{
+	std::size_t numberOfLevels{ getNumberOfMipmapLevels(image.getSize()) };
+	if ((maximumNumberOfLevels > 0_uz) && (maximumNumberOfLevels < numberOfLevels))
+		numberOfLevels = maximumNumberOfLevels;
+
+	std::vector<sf::Image> levels;
+	levels.reserve(numberOfLevels);
+	if (numberOfLevels == 0_uz)
+		return levels;
+	levels.push_back(image);
+	for (std::size_t level{ 1_uz }; level < numberOfLevels; ++level)
+	{
+		const sf::Image& previous{ levels.back() };
+		sf::Image next;
+		next.resize(getMipmapLevelSize(previous.getSize(), 1_uz));
+		impl::downsampleMipmap(previous.getPixelsPtr(), previous.getSize(), impl::getPixels(next), filter, isGammaCorrect, isAlphaWeighted);
+		levels.push_back(std::move(next));
+	}
+	return levels;
+}
+
+inline MipmapBuffer createMipmapBuffer(const sf::Image& image, const MipmapFilter filter, const bool isGammaCorrect, const bool isAlphaWeighted, const std::size_t maximumNumberOfLevels)
+{
+	std::size_t numberOfLevels{ getNumberOfMipmapLevels(image.getSize()) };
+	if ((maximumNumberOfLevels > 0_uz) && (maximumNumberOfLevels < numberOfLevels))
+		numberOfLevels = maximumNumberOfLevels;
+
+	MipmapBuffer buffer{};
+	std::size_t size{ 0_uz };
+	for (std::size_t level{ 0_uz }; level < numberOfLevels; ++level)
+	{
+		buffer.sizes.push_back(getMipmapLevelSize(image.getSize(), level));
+		buffer.offsets.push_back(size);
+		size += buffer.sizes.back().x * buffer.sizes.back().y * 4_uz;
+	}
+	buffer.pixels.resize(size);
+	if (numberOfLevels == 0_uz)
+		return buffer;
+
+	std::memcpy(buffer.pixels.data(), image.getPixelsPtr(), buffer.sizes[0u].x * buffer.sizes[0u].y * 4_uz);
+	for (std::size_t level{ 1_uz }; level < numberOfLevels; ++level)
+		impl::downsampleMipmap(buffer.pixels.data() + buffer.offsets[level - 1_uz], buffer.sizes[level - 1_uz], buffer.pixels.data() + buffer.offsets[level], filter, isGammaCorrect, isAlphaWeighted);
+	return buffer;
+}
+
+	} // namespace Image
+} // namespace plinth
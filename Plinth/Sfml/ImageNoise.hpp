@@ -0,0 +1,92 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// Plinth
+//
+// Copyright(c) 2014-2025 M.J.Silk
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions :
+//
+// 1. The origin of this software must not be misrepresented; you must not
+// claim that you wrote the original software.If you use this software
+// in a product, an acknowledgment in the product documentation would be
+// appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not be
+// misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+// M.J.Silk
+// MJSilk2@gmail.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+
+// REQUIRES C++11
+
+#pragma once
+
+#include "Common.hpp"
+#include <SFML/System/Vector2.hpp>
+#include "ImageParallel.hpp"
+#include "ImageSimd.hpp"
+#include <vector>
+#include <cstdint>
+
+namespace plinth
+{
+	namespace Image
+	{
+
+enum class NoiseType
+{
+	Random, // white noise from the global random generator (settings are not used)
+	Value, // smoothly interpolated random values at the corners of each cell
+	Perlin, // gradient noise
+	Simplex, // gradient noise on a grid of triangles. fewer directional artefacts than Perlin
+	Worley // cellular: distance to the nearest of one random point per cell
+};
+
+// coherent noise (all types except Random) is created from hashes of the seed so the same seed and settings always give the same noise
+// each octave (fBm) has double (lacunarity) the frequency and half (persistence) the amplitude of the previous one by default
+// tileable noise wraps at the size so that it repeats seamlessly. the number of cells across is rounded to a whole number for each octave (Simplex is blended across the size instead as its grid cannot be wrapped)
+// evaluated using SIMD (see setMaximumInstructionSet) and in parallel across rows (see processInParallel). results are identical for any instruction set (unless the compiler contracts floating-point operations, e.g. into FMA)
+struct NoiseSettings
+{
+	float scale; // size of a cell of the first octave (in pixels)
+	std::size_t numberOfOctaves; // at most 16
+	float lacunarity; // frequency multiplier for each octave
+	float persistence; // amplitude multiplier for each octave
+	std::uint32_t seed;
+	bool isTileable;
+
+	NoiseSettings();
+};
+
+		namespace impl
+		{
+
+struct NoiseOctave
+{
+	float frequencyX; // cells per pixel
+	float frequencyY;
+	float amplitude; // normalised so that the amplitudes of all octaves sum to one
+	std::uint32_t periodX; // number of cells across before wrapping (zero does not wrap)
+	std::uint32_t periodY;
+	std::uint32_t seed;
+};
+
+std::vector<NoiseOctave> createNoiseOctaves(const NoiseSettings& settings, sf::Vector2u size);
+void generateNoise(std::uint8_t* pixels, sf::Vector2u size, std::size_t stride, NoiseType type, const NoiseSettings& settings); // coherent types only
+
+		} // namespace impl
+
+	} // namespace Image
+} // namespace plinth
+#include "ImageNoise.inl"
@@ -0,0 +1,551 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// Plinth
+//
+// Copyright(c) 2014-2025 M.J.Silk
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions :
+//
+// 1. The origin of this software must not be misrepresented; you must not
+// claim that you wrote the original software.If you use this software
+// in a product, an acknowledgment in the product documentation would be
+// appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not be
+// misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+// M.J.Silk
+// MJSilk2@gmail.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once
+
+#include "ImageNoise.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if defined(_MSC_VER)
+#define PLINTH_IMAGE_NOISE_INLINE __forceinline
+#else // _MSC_VER
+#define PLINTH_IMAGE_NOISE_INLINE __attribute__((always_inline)) inline
+#endif // _MSC_VER
+
+namespace plinth
+{
+	namespace Image
+	{
+
+inline NoiseSettings::NoiseSettings()
+	: scale{ 32.f }
+	, numberOfOctaves{ 1u }
+	, lacunarity{ 2.f }
+	, persistence{ 0.5f }
+	, seed{ 0u }
+	, isTileable{ false }
+{
+}
+
+		namespace impl
+		{
+			namespace noise
+			{
+
+// the noise algorithms are written once for "lanes" (a number of values processed together) so that scalar and SIMD perform exactly the same operations
+// they are forced inline so that, when used with SIMD lanes, they are compiled for the instruction set of the calling row function
+
+constexpr std::size_t maximumNumberOfOctaves{ 16u };
+constexpr std::uint32_t hashMultipliers[4]{ 0x8da6b343u, 0xd8163841u, 0x2c1b3c6du, 0x297a2d39u };
+constexpr float simplexSkew{ 0.366025403784f }; // (sqrt(3) - 1) / 2
+constexpr float simplexUnskew{ 0.211324865405f }; // (3 - sqrt(3)) / 6
+constexpr float perlinScale{ 0.632455532034f }; // 1 / (sqrt(5) x sqrt(1/2)): brings the greatest possible values to -1 and 1
+constexpr float simplexScale{ 44.2718872f }; // 70 x sqrt(2/5) (the usual scale adjusted for the longer gradients): brings values to about -1 and 1
+
+inline std::uint32_t hash(const std::uint32_t x, const std::uint32_t y, const std::uint32_t seed)
+{
+	std::uint32_t h{ x * hashMultipliers[0u] + y * hashMultipliers[1u] + seed };
+	h ^= h >> 15u;
+	h *= hashMultipliers[2u];
+	h ^= h >> 12u;
+	h *= hashMultipliers[3u];
+	h ^= h >> 15u;
+	return h;
+}
+
+struct ScalarLanes
+{
+	typedef float Float;
+	typedef std::uint32_t Integer; // masks are all bits set (true) or zero (false)
+	static constexpr std::size_t size{ 1u };
+
+	static Float set(const float value) { return value; }
+	static Integer setInteger(const std::uint32_t value) { return value; }
+	static Integer indices() { return 0u; }
+	static Float add(const Float a, const Float b) { return a + b; }
+	static Float subtract(const Float a, const Float b) { return a - b; }
+	static Float multiply(const Float a, const Float b) { return a * b; }
+	static Float minimum(const Float a, const Float b) { return (a < b) ? a : b; }
+	static Float maximum(const Float a, const Float b) { return (a > b) ? a : b; }
+	static Float squareRoot(const Float a) { return std::sqrt(a); }
+	static Float floor(const Float a)
+	{
+		const Float truncated{ static_cast<float>(static_cast<std::int32_t>(a)) };
+		return (truncated > a) ? (truncated - 1.f) : truncated;
+	}
+	static Integer toInteger(const Float a) { return static_cast<std::uint32_t>(static_cast<std::int32_t>(a)); } // truncates
+	static Float toFloat(const Integer a) { return static_cast<float>(static_cast<std::int32_t>(a)); }
+	static Integer addInteger(const Integer a, const Integer b) { return a + b; }
+	static Integer andInteger(const Integer a, const Integer b) { return a & b; }
+	static Integer isZero(const Integer a) { return (a == 0u) ? 0xFFFFFFFFu : 0u; }
+	static Integer isEqual(const Integer a, const Integer b) { return (a == b) ? 0xFFFFFFFFu : 0u; }
+	static Integer isGreater(const Float a, const Float b) { return (a > b) ? 0xFFFFFFFFu : 0u; }
+	static Float select(const Integer mask, const Float a, const Float b) { return (mask != 0u) ? a : b; }
+	static Integer selectInteger(const Integer mask, const Integer a, const Integer b) { return (mask != 0u) ? a : b; }
+	static Integer hash(const Integer x, const Integer y, const Integer seed) { return noise::hash(x, y, seed); }
+	static Float hashToUnit(const Integer h) { return static_cast<float>(h >> 8u) * (1.f / 16777216.f); }
+	static Float lowHalfToUnit(const Integer h) { return static_cast<float>(h & 0xFFFFu) * (1.f / 65536.f); }
+	static Float highHalfToUnit(const Integer h) { return static_cast<float>(h >> 16u) * (1.f / 65536.f); }
+	static void storeBytes(const Float value, std::uint8_t* const destination)
+	{
+		const Float scaled{ minimum(maximum(value * 127.5f + 127.5f, 0.f), 255.f) + 0.5f };
+		*destination = static_cast<std::uint8_t>(static_cast<std::int32_t>(scaled));
+	}
+};
+
+#ifdef PLINTH_IMAGE_SIMD
+
+// SIMD lanes wrap their vectors in structs (passed by reference) so that the lane templates, which are compiled without the instruction set, never pass vectors by value
+
+struct Sse2Lanes
+{
+	struct Float { __m128 value; };
+	struct Integer { __m128i value; };
+	static constexpr std::size_t size{ 4u };
+
+	PLINTH_IMAGE_SIMD_TARGET("sse2") static Float set(const float value) { return{ _mm_set1_ps(value) }; }
+	PLINTH_IMAGE_SIMD_TARGET("sse2") static Integer setInteger(const std::uint32_t value) { return{ _mm_set1_epi32(static_cast<int>(value)) }; }
+	PLINTH_IMAGE_SIMD_TARGET("sse2") static Integer indices() { return{ _mm_setr_epi32(0, 1, 2, 3) }; }
+	PLINTH_IMAGE_SIMD_TARGET("sse2") static Float add(const Float& a, const Float& b) { return{ _mm_add_ps(a.value, b.value) }; }
+	PLINTH_IMAGE_SIMD_TARGET("sse2") static Float subtract(const Float& a, const Float& b) { return{ _mm_sub_ps(a.value, b.value) }; }
+	PLINTH_IMAGE_SIMD_TARGET("sse2") static Float multiply(const Float& a, const Float& b) { return{ _mm_mul_ps(a.value, b.value) }; }
+	PLINTH_IMAGE_SIMD_TARGET("sse2") static Float minimum(const Float& a, const Float& b) { return{ _mm_min_ps(a.value, b.value) }; }
+	PLINTH_IMAGE_SIMD_TARGET("sse2") static Float maximum(const Float& a, const Float& b) { return{ _mm_max_ps(a.value, b.value) }; }
+	PLINTH_IMAGE_SIMD_TARGET("sse2") static Float squareRoot(const Float& a) { return{ _mm_sqrt_ps(a.value) }; }
+	PLINTH_IMAGE_SIMD_TARGET("sse2") static Float floor(const Float& a)
+	{
+		const __m128 truncated{ _mm_cvtepi32_ps(_mm_cvttps_epi32(a.value)) };
+		return{ _mm_sub_ps(truncated, _mm_and_ps(_mm_cmpgt_ps(truncated, a.value), _mm_set1_ps(1.f))) };
+	}
+	PLINTH_IMAGE_SIMD_TARGET("sse2") static Integer toInteger(const Float& a) { return{ _mm_cvttps_epi32(a.value) }; }
+	PLINTH_IMAGE_SIMD_TARGET("sse2") static Float toFloat(const Integer& a) { return{ _mm_cvtepi32_ps(a.value) }; }
+	PLINTH_IMAGE_SIMD_TARGET("sse2") static Integer addInteger(const Integer& a, const Integer& b) { return{ _mm_add_epi32(a.value, b.value) }; }
+	PLINTH_IMAGE_SIMD_TARGET("sse2") static Integer andInteger(const Integer& a, const Integer& b) { return{ _mm_and_si128(a.value, b.value) }; }
+	PLINTH_IMAGE_SIMD_TARGET("sse2") static Integer isZero(const Integer& a) { return{ _mm_cmpeq_epi32(a.value, _mm_setzero_si128()) }; }
+	PLINTH_IMAGE_SIMD_TARGET("sse2") static Integer isEqual(const Integer& a, const Integer& b) { return{ _mm_cmpeq_epi32(a.value, b.value) }; }
+	PLINTH_IMAGE_SIMD_TARGET("sse2") static Integer isGreater(const Float& a, const Float& b) { return{ _mm_castps_si128(_mm_cmpgt_ps(a.value, b.value)) }; }
+	PLINTH_IMAGE_SIMD_TARGET("sse2") static Float select(const Integer& mask, const Float& a, const Float& b)
+	{
+		const __m128 floatMask{ _mm_castsi128_ps(mask.value) };
+		return{ _mm_or_ps(_mm_and_ps(floatMask, a.value), _mm_andnot_ps(floatMask, b.value)) };
+	}
+	PLINTH_IMAGE_SIMD_TARGET("sse2") static Integer selectInteger(const Integer& mask, const Integer& a, const Integer& b) { return{ _mm_or_si128(_mm_and_si128(mask.value, a.value), _mm_andnot_si128(mask.value, b.value)) }; }
+	PLINTH_IMAGE_SIMD_TARGET("sse2") static __m128i multiply(const __m128i a, const std::uint32_t b)
+	{
+		// low 32 bits of each product (SSE2 has no 32-bit multiply so even and odd lanes are multiplied separately)
+		const __m128i multiplier{ _mm_set1_epi32(static_cast<int>(b)) };
+		const __m128i even{ _mm_mul_epu32(a, multiplier) };
+		const __m128i odd{ _mm_mul_epu32(_mm_srli_epi64(a, 32), multiplier) };
+		return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)), _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+	}
+	PLINTH_IMAGE_SIMD_TARGET("sse2") static Integer hash(const Integer& x, const Integer& y, const Integer& seed)
+	{
+		__m128i h{ _mm_add_epi32(_mm_add_epi32(multiply(x.value, hashMultipliers[0u]), multiply(y.value, hashMultipliers[1u])), seed.value) };
+		h = _mm_xor_si128(h, _mm_srli_epi32(h, 15));
+		h = multiply(h, hashMultipliers[2u]);
+		h = _mm_xor_si128(h, _mm_srli_epi32(h, 12));
+		h = multiply(h, hashMultipliers[3u]);
+		return{ _mm_xor_si128(h, _mm_srli_epi32(h, 15)) };
+	}
+	PLINTH_IMAGE_SIMD_TARGET("sse2") static Float hashToUnit(const Integer& h) { return{ _mm_mul_ps(_mm_cvtepi32_ps(_mm_srli_epi32(h.value, 8)), _mm_set1_ps(1.f / 16777216.f)) }; }
+	PLINTH_IMAGE_SIMD_TARGET("sse2") static Float lowHalfToUnit(const Integer& h) { return{ _mm_mul_ps(_mm_cvtepi32_ps(_mm_and_si128(h.value, _mm_set1_epi32(0xFFFF))), _mm_set1_ps(1.f / 65536.f)) }; }
+	PLINTH_IMAGE_SIMD_TARGET("sse2") static Float highHalfToUnit(const Integer& h) { return{ _mm_mul_ps(_mm_cvtepi32_ps(_mm_srli_epi32(h.value, 16)), _mm_set1_ps(1.f / 65536.f)) }; }
+	PLINTH_IMAGE_SIMD_TARGET("sse2") static void storeBytes(const Float& value, std::uint8_t* const destination)
+	{
+		const __m128 scaled{ _mm_add_ps(_mm_min_ps(_mm_max_ps(_mm_add_ps(_mm_mul_ps(value.value, _mm_set1_ps(127.5f)), _mm_set1_ps(127.5f)), _mm_setzero_ps()), _mm_set1_ps(255.f)), _mm_set1_ps(0.5f)) };
+		const __m128i words{ _mm_packs_epi32(_mm_cvttps_epi32(scaled), _mm_setzero_si128()) };
+		const int bytes{ _mm_cvtsi128_si32(_mm_packus_epi16(words, words)) };
+		std::memcpy(destination, &bytes, 4u);
+	}
+};
+
+struct Avx2Lanes
+{
+	struct Float { __m256 value; };
+	struct Integer { __m256i value; };
+	static constexpr std::size_t size{ 8u };
+
+	PLINTH_IMAGE_SIMD_TARGET("avx2") static Float set(const float value) { return{ _mm256_set1_ps(value) }; }
+	PLINTH_IMAGE_SIMD_TARGET("avx2") static Integer setInteger(const std::uint32_t value) { return{ _mm256_set1_epi32(static_cast<int>(value)) }; }
+	PLINTH_IMAGE_SIMD_TARGET("avx2") static Integer indices() { return{ _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7) }; }
+	PLINTH_IMAGE_SIMD_TARGET("avx2") static Float add(const Float& a, const Float& b) { return{ _mm256_add_ps(a.value, b.value) }; }
+	PLINTH_IMAGE_SIMD_TARGET("avx2") static Float subtract(const Float& a, const Float& b) { return{ _mm256_sub_ps(a.value, b.value) }; }
+	PLINTH_IMAGE_SIMD_TARGET("avx2") static Float multiply(const Float& a, const Float& b) { return{ _mm256_mul_ps(a.value, b.value) }; }
+	PLINTH_IMAGE_SIMD_TARGET("avx2") static Float minimum(const Float& a, const Float& b) { return{ _mm256_min_ps(a.value, b.value) }; }
+	PLINTH_IMAGE_SIMD_TARGET("avx2") static Float maximum(const Float& a, const Float& b) { return{ _mm256_max_ps(a.value, b.value) }; }
+	PLINTH_IMAGE_SIMD_TARGET("avx2") static Float squareRoot(const Float& a) { return{ _mm256_sqrt_ps(a.value) }; }
+	PLINTH_IMAGE_SIMD_TARGET("avx2") static Float floor(const Float& a)
+	{
+		// same as SSE2 (rather than rounding) so results match for all values
+		const __m256 truncated{ _mm256_cvtepi32_ps(_mm256_cvttps_epi32(a.value)) };
+		return{ _mm256_sub_ps(truncated, _mm256_and_ps(_mm256_cmp_ps(truncated, a.value, _CMP_GT_OQ), _mm256_set1_ps(1.f))) };
+	}
+	PLINTH_IMAGE_SIMD_TARGET("avx2") static Integer toInteger(const Float& a) { return{ _mm256_cvttps_epi32(a.value) }; }
+	PLINTH_IMAGE_SIMD_TARGET("avx2") static Float toFloat(const Integer& a) { return{ _mm256_cvtepi32_ps(a.value) }; }
+	PLINTH_IMAGE_SIMD_TARGET("avx2") static Integer addInteger(const Integer& a, const Integer& b) { return{ _mm256_add_epi32(a.value, b.value) }; }
+	PLINTH_IMAGE_SIMD_TARGET("avx2") static Integer andInteger(const Integer& a, const Integer& b) { return{ _mm256_and_si256(a.value, b.value) }; }
+	PLINTH_IMAGE_SIMD_TARGET("avx2") static Integer isZero(const Integer& a) { return{ _mm256_cmpeq_epi32(a.value, _mm256_setzero_si256()) }; }
+	PLINTH_IMAGE_SIMD_TARGET("avx2") static Integer isEqual(const Integer& a, const Integer& b) { return{ _mm256_cmpeq_epi32(a.value, b.value) }; }
+	PLINTH_IMAGE_SIMD_TARGET("avx2") static Integer isGreater(const Float& a, const Float& b) { return{ _mm256_castps_si256(_mm256_cmp_ps(a.value, b.value, _CMP_GT_OQ)) }; }
+	PLINTH_IMAGE_SIMD_TARGET("avx2") static Float select(const Integer& mask, const Float& a, const Float& b) { return{ _mm256_blendv_ps(b.value, a.value, _mm256_castsi256_ps(mask.value)) }; }
+	PLINTH_IMAGE_SIMD_TARGET("avx2") static Integer selectInteger(const Integer& mask, const Integer& a, const Integer& b) { return{ _mm256_blendv_epi8(b.value, a.value, mask.value) }; }
+	PLINTH_IMAGE_SIMD_TARGET("avx2") static Integer hash(const Integer& x, const Integer& y, const Integer& seed)
+	{
+		__m256i h{ _mm256_add_epi32(_mm256_add_epi32(_mm256_mullo_epi32(x.value, _mm256_set1_epi32(static_cast<int>(hashMultipliers[0u]))), _mm256_mullo_epi32(y.value, _mm256_set1_epi32(static_cast<int>(hashMultipliers[1u])))), seed.value) };
+		h = _mm256_xor_si256(h, _mm256_srli_epi32(h, 15));
+		h = _mm256_mullo_epi32(h, _mm256_set1_epi32(static_cast<int>(hashMultipliers[2u])));
+		h = _mm256_xor_si256(h, _mm256_srli_epi32(h, 12));
+		h = _mm256_mullo_epi32(h, _mm256_set1_epi32(static_cast<int>(hashMultipliers[3u])));
+		return{ _mm256_xor_si256(h, _mm256_srli_epi32(h, 15)) };
+	}
+	PLINTH_IMAGE_SIMD_TARGET("avx2") static Float hashToUnit(const Integer& h) { return{ _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_srli_epi32(h.value, 8)), _mm256_set1_ps(1.f / 16777216.f)) }; }
+	PLINTH_IMAGE_SIMD_TARGET("avx2") static Float lowHalfToUnit(const Integer& h) { return{ _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_and_si256(h.value, _mm256_set1_epi32(0xFFFF))), _mm256_set1_ps(1.f / 65536.f)) }; }
+	PLINTH_IMAGE_SIMD_TARGET("avx2") static Float highHalfToUnit(const Integer& h) { return{ _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_srli_epi32(h.value, 16)), _mm256_set1_ps(1.f / 65536.f)) }; }
+	PLINTH_IMAGE_SIMD_TARGET("avx2") static void storeBytes(const Float& value, std::uint8_t* const destination)
+	{
+		const __m256 scaled{ _mm256_add_ps(_mm256_min_ps(_mm256_max_ps(_mm256_add_ps(_mm256_mul_ps(value.value, _mm256_set1_ps(127.5f)), _mm256_set1_ps(127.5f)), _mm256_setzero_ps()), _mm256_set1_ps(255.f)), _mm256_set1_ps(0.5f)) };
+		const __m256i words{ _mm256_packs_epi32(_mm256_cvttps_epi32(scaled), _mm256_setzero_si256()) };
+		const __m256i bytes{ _mm256_packus_epi16(words, words) }; // first four bytes of each half
+		const int low{ _mm_cvtsi128_si32(_mm256_castsi256_si128(bytes)) };
+		const int high{ _mm_cvtsi128_si32(_mm256_extracti128_si256(bytes, 1)) };
+		std::memcpy(destination, &low, 4u);
+		std::memcpy(destination + 4u, &high, 4u);
+	}
+};
+
+#endif // PLINTH_IMAGE_SIMD
+
+template <class LanesT>
+PLINTH_IMAGE_NOISE_INLINE typename LanesT::Integer wrapCell(const typename LanesT::Integer& cell, const std::uint32_t period)
+{
+	// cells from -1 to period wrap to 0 to (period - 1). zero period does not wrap
+	typename LanesT::Integer wrapped{ cell };
+	if (period != 0u)
+	{
+		wrapped = LanesT::selectInteger(LanesT::isEqual(wrapped, LanesT::setInteger(period)), LanesT::setInteger(0u), wrapped);
+		wrapped = LanesT::selectInteger(LanesT::isEqual(wrapped, LanesT::setInteger(0xFFFFFFFFu)), LanesT::setInteger(period - 1u), wrapped);
+	}
+	return wrapped;
+}
+
+template <class LanesT>
+PLINTH_IMAGE_NOISE_INLINE typename LanesT::Float fade(const typename LanesT::Float& t)
+{
+	// 6t^5 - 15t^4 + 10t^3
+	const typename LanesT::Float polynomial{ LanesT::add(LanesT::multiply(t, LanesT::subtract(LanesT::multiply(t, LanesT::set(6.f)), LanesT::set(15.f))), LanesT::set(10.f)) };
+	return LanesT::multiply(LanesT::multiply(LanesT::multiply(t, t), t), polynomial);
+}
+
+template <class LanesT>
+PLINTH_IMAGE_NOISE_INLINE typename LanesT::Float interpolate(const typename LanesT::Float& a, const typename LanesT::Float& b, const typename LanesT::Float& t)
+{
+	return LanesT::add(a, LanesT::multiply(LanesT::subtract(b, a), t));
+}
+
+template <class LanesT>
+PLINTH_IMAGE_NOISE_INLINE typename LanesT::Float gradient(const typename LanesT::Integer& h, const typename LanesT::Float& x, const typename LanesT::Float& y)
+{
+	// one of eight gradients: (+/-1, +/-2) or (+/-2, +/-1)
+	const typename LanesT::Float zero{ LanesT::set(0.f) };
+	const typename LanesT::Integer isXFirst{ LanesT::isZero(LanesT::andInteger(h, LanesT::setInteger(4u))) };
+	const typename LanesT::Float u{ LanesT::select(isXFirst, x, y) };
+	const typename LanesT::Float v{ LanesT::select(isXFirst, y, x) };
+	const typename LanesT::Float doubleV{ LanesT::add(v, v) };
+	const typename LanesT::Float signedU{ LanesT::select(LanesT::isZero(LanesT::andInteger(h, LanesT::setInteger(1u))), u, LanesT::subtract(zero, u)) };
+	const typename LanesT::Float signedV{ LanesT::select(LanesT::isZero(LanesT::andInteger(h, LanesT::setInteger(2u))), doubleV, LanesT::subtract(zero, doubleV)) };
+	return LanesT::add(signedU, signedV);
+}
+
+struct ValueNoise
+{
+	template <class LanesT>
+	PLINTH_IMAGE_NOISE_INLINE static typename LanesT::Float evaluate(const typename LanesT::Float& x, const typename LanesT::Float& y, const NoiseOctave& octave)
+	{
+		typedef typename LanesT::Integer Integer;
+		const typename LanesT::Float cellX{ LanesT::floor(x) };
+		const typename LanesT::Float cellY{ LanesT::floor(y) };
+		const Integer x0{ wrapCell<LanesT>(LanesT::toInteger(cellX), octave.periodX) };
+		const Integer y0{ wrapCell<LanesT>(LanesT::toInteger(cellY), octave.periodY) };
+		const Integer x1{ wrapCell<LanesT>(LanesT::addInteger(x0, LanesT::setInteger(1u)), octave.periodX) };
+		const Integer y1{ wrapCell<LanesT>(LanesT::addInteger(y0, LanesT::setInteger(1u)), octave.periodY) };
+		const Integer seed{ LanesT::setInteger(octave.seed) };
+		const typename LanesT::Float u{ fade<LanesT>(LanesT::subtract(x, cellX)) };
+		const typename LanesT::Float v{ fade<LanesT>(LanesT::subtract(y, cellY)) };
+		const typename LanesT::Float top{ interpolate<LanesT>(LanesT::hashToUnit(LanesT::hash(x0, y0, seed)), LanesT::hashToUnit(LanesT::hash(x1, y0, seed)), u) };
+		const typename LanesT::Float bottom{ interpolate<LanesT>(LanesT::hashToUnit(LanesT::hash(x0, y1, seed)), LanesT::hashToUnit(LanesT::hash(x1, y1, seed)), u) };
+		return LanesT::subtract(LanesT::multiply(interpolate<LanesT>(top, bottom, v), LanesT::set(2.f)), LanesT::set(1.f));
+	}
+};
+
+struct PerlinNoise
+{
+	template <class LanesT>
+	PLINTH_IMAGE_NOISE_INLINE static typename LanesT::Float evaluate(const typename LanesT::Float& x, const typename LanesT::Float& y, const NoiseOctave& octave)
+	{
+		typedef typename LanesT::Integer Integer;
+		typedef typename LanesT::Float Float;
+		const Float cellX{ LanesT::floor(x) };
+		const Float cellY{ LanesT::floor(y) };
+		const Integer x0{ wrapCell<LanesT>(LanesT::toInteger(cellX), octave.periodX) };
+		const Integer y0{ wrapCell<LanesT>(LanesT::toInteger(cellY), octave.periodY) };
+		const Integer x1{ wrapCell<LanesT>(LanesT::addInteger(x0, LanesT::setInteger(1u)), octave.periodX) };
+		const Integer y1{ wrapCell<LanesT>(LanesT::addInteger(y0, LanesT::setInteger(1u)), octave.periodY) };
+		const Integer seed{ LanesT::setInteger(octave.seed) };
+		const Float fx0{ LanesT::subtract(x, cellX) };
+		const Float fy0{ LanesT::subtract(y, cellY) };
+		const Float fx1{ LanesT::subtract(fx0, LanesT::set(1.f)) };
+		const Float fy1{ LanesT::subtract(fy0, LanesT::set(1.f)) };
+		const Float u{ fade<LanesT>(fx0) };
+		const Float v{ fade<LanesT>(fy0) };
+		const Float top{ interpolate<LanesT>(gradient<LanesT>(LanesT::hash(x0, y0, seed), fx0, fy0), gradient<LanesT>(LanesT::hash(x1, y0, seed), fx1, fy0), u) };
+		const Float bottom{ interpolate<LanesT>(gradient<LanesT>(LanesT::hash(x0, y1, seed), fx0, fy1), gradient<LanesT>(LanesT::hash(x1, y1, seed), fx1, fy1), u) };
+		return LanesT::multiply(interpolate<LanesT>(top, bottom, v), LanesT::set(perlinScale));
+	}
+};
+
+struct SimplexNoise
+{
+	template <class LanesT>
+	PLINTH_IMAGE_NOISE_INLINE static typename LanesT::Float corner(const typename LanesT::Integer& h, const typename LanesT::Float& x, const typename LanesT::Float& y)
+	{
+		const typename LanesT::Float falloff{ LanesT::maximum(LanesT::subtract(LanesT::subtract(LanesT::set(0.5f), LanesT::multiply(x, x)), LanesT::multiply(y, y)), LanesT::set(0.f)) };
+		const typename LanesT::Float squared{ LanesT::multiply(falloff, falloff) };
+		return LanesT::multiply(LanesT::multiply(squared, squared), gradient<LanesT>(h, x, y));
+	}
+
+	template <class LanesT>
+	PLINTH_IMAGE_NOISE_INLINE static typename LanesT::Float evaluateUnwrapped(const typename LanesT::Float& x, const typename LanesT::Float& y, const typename LanesT::Integer& seed)
+	{
+		typedef typename LanesT::Integer Integer;
+		typedef typename LanesT::Float Float;
+		const Float skew{ LanesT::multiply(LanesT::add(x, y), LanesT::set(simplexSkew)) };
+		const Float cellX{ LanesT::floor(LanesT::add(x, skew)) };
+		const Float cellY{ LanesT::floor(LanesT::add(y, skew)) };
+		const Float unskew{ LanesT::multiply(LanesT::add(cellX, cellY), LanesT::set(simplexUnskew)) };
+		const Float x0{ LanesT::subtract(x, LanesT::subtract(cellX, unskew)) };
+		const Float y0{ LanesT::subtract(y, LanesT::subtract(cellY, unskew)) };
+		const Integer isLower{ LanesT::isGreater(x0, y0) }; // lower triangle steps along x first
+		const Float stepX{ LanesT::select(isLower, LanesT::set(1.f), LanesT::set(0.f)) };
+		const Float stepY{ LanesT::select(isLower, LanesT::set(0.f), LanesT::set(1.f)) };
+		const Float x1{ LanesT::add(LanesT::subtract(x0, stepX), LanesT::set(simplexUnskew)) };
+		const Float y1{ LanesT::add(LanesT::subtract(y0, stepY), LanesT::set(simplexUnskew)) };
+		const Float x2{ LanesT::add(LanesT::subtract(x0, LanesT::set(1.f)), LanesT::set(2.f * simplexUnskew)) };
+		const Float y2{ LanesT::add(LanesT::subtract(y0, LanesT::set(1.f)), LanesT::set(2.f * simplexUnskew)) };
+		const Integer i{ LanesT::toInteger(cellX) };
+		const Integer j{ LanesT::toInteger(cellY) };
+		const Integer one{ LanesT::setInteger(1u) };
+		const Integer i1{ LanesT::selectInteger(isLower, LanesT::addInteger(i, one), i) };
+		const Integer j1{ LanesT::selectInteger(isLower, j, LanesT::addInteger(j, one)) };
+		const Float total{ LanesT::add(LanesT::add(corner<LanesT>(LanesT::hash(i, j, seed), x0, y0), corner<LanesT>(LanesT::hash(i1, j1, seed), x1, y1)), corner<LanesT>(LanesT::hash(LanesT::addInteger(i, one), LanesT::addInteger(j, one), seed), x2, y2)) };
+		return LanesT::multiply(total, LanesT::set(simplexScale));
+	}
+
+	template <class LanesT>
+	PLINTH_IMAGE_NOISE_INLINE static typename LanesT::Float evaluate(const typename LanesT::Float& x, const typename LanesT::Float& y, const NoiseOctave& octave)
+	{
+		typedef typename LanesT::Float Float;
+		const typename LanesT::Integer seed{ LanesT::setInteger(octave.seed) };
+		if ((octave.periodX == 0u) || (octave.periodY == 0u))
+			return evaluateUnwrapped<LanesT>(x, y, seed);
+
+		// the triangle grid cannot wrap so the noise is blended with copies shifted by the period (weighted by distance from the opposite edge)
+		const Float width{ LanesT::set(static_cast<float>(octave.periodX)) };
+		const Float height{ LanesT::set(static_cast<float>(octave.periodY)) };
+		const Float shiftedX{ LanesT::subtract(x, width) };
+		const Float shiftedY{ LanesT::subtract(y, height) };
+		const Float right{ LanesT::subtract(width, x) };
+		const Float below{ LanesT::subtract(height, y) };
+		const Float top{ LanesT::add(LanesT::multiply(evaluateUnwrapped<LanesT>(x, y, seed), right), LanesT::multiply(evaluateUnwrapped<LanesT>(shiftedX, y, seed), x)) };
+		const Float bottom{ LanesT::add(LanesT::multiply(evaluateUnwrapped<LanesT>(x, shiftedY, seed), right), LanesT::multiply(evaluateUnwrapped<LanesT>(shiftedX, shiftedY, seed), x)) };
+		const Float blended{ LanesT::add(LanesT::multiply(top, below), LanesT::multiply(bottom, y)) };
+		return LanesT::multiply(blended, LanesT::set(1.f / (static_cast<float>(octave.periodX) * static_cast<float>(octave.periodY))));
+	}
+};
+
+struct WorleyNoise
+{
+	template <class LanesT>
+	PLINTH_IMAGE_NOISE_INLINE static typename LanesT::Float evaluate(const typename LanesT::Float& x, const typename LanesT::Float& y, const NoiseOctave& octave)
+	{
+		// distance to the nearest point (0 to about 1) is mapped to -1 to 1
+		typedef typename LanesT::Integer Integer;
+		typedef typename LanesT::Float Float;
+		const Float cellX{ LanesT::floor(x) };
+		const Float cellY{ LanesT::floor(y) };
+		const Float fx{ LanesT::subtract(x, cellX) };
+		const Float fy{ LanesT::subtract(y, cellY) };
+		const Integer x0{ wrapCell<LanesT>(LanesT::toInteger(cellX), octave.periodX) };
+		const Integer y0{ wrapCell<LanesT>(LanesT::toInteger(cellY), octave.periodY) };
+		const Integer seed{ LanesT::setInteger(octave.seed) };
+		Float nearest{ LanesT::set(8.f) };
+		for (int offsetY{ -1 }; offsetY <= 1; ++offsetY)
+		{
+			const Integer neighbourY{ wrapCell<LanesT>(LanesT::addInteger(y0, LanesT::setInteger(static_cast<std::uint32_t>(offsetY))), octave.periodY) };
+			const Float pointOffsetY{ LanesT::subtract(LanesT::set(static_cast<float>(offsetY)), fy) };
+			for (int offsetX{ -1 }; offsetX <= 1; ++offsetX)
+			{
+				const Integer neighbourX{ wrapCell<LanesT>(LanesT::addInteger(x0, LanesT::setInteger(static_cast<std::uint32_t>(offsetX))), octave.periodX) };
+				const Integer h{ LanesT::hash(neighbourX, neighbourY, seed) };
+				const Float dx{ LanesT::add(LanesT::subtract(LanesT::set(static_cast<float>(offsetX)), fx), LanesT::lowHalfToUnit(h)) };
+				const Float dy{ LanesT::add(pointOffsetY, LanesT::highHalfToUnit(h)) };
+				nearest = LanesT::minimum(nearest, LanesT::add(LanesT::multiply(dx, dx), LanesT::multiply(dy, dy)));
+			}
+		}
+		return LanesT::subtract(LanesT::multiply(LanesT::squareRoot(nearest), LanesT::set(2.f)), LanesT::set(1.f));
+	}
+};
+
+template <class LanesT, class NoiseT>
+PLINTH_IMAGE_NOISE_INLINE std::size_t generateRow(std::uint8_t* const row, const std::size_t begin, const std::size_t width, const float y, const std::vector<NoiseOctave>& octaves)
+{
+	// returns number of pixels processed (from the start)
+	typedef typename LanesT::Float Float;
+	const Float pixelY{ LanesT::set(y + 0.5f) };
+	std::size_t x{ begin };
+	for (; (x + LanesT::size) <= width; x += LanesT::size)
+	{
+		const Float pixelX{ LanesT::add(LanesT::toFloat(LanesT::addInteger(LanesT::setInteger(static_cast<std::uint32_t>(x)), LanesT::indices())), LanesT::set(0.5f)) };
+		Float total{ LanesT::set(0.f) };
+		for (const auto& octave : octaves)
+		{
+			const Float value{ NoiseT::template evaluate<LanesT>(LanesT::multiply(pixelX, LanesT::set(octave.frequencyX)), LanesT::multiply(pixelY, LanesT::set(octave.frequencyY)), octave) };
+			total = LanesT::add(total, LanesT::multiply(value, LanesT::set(octave.amplitude)));
+		}
+		LanesT::storeBytes(total, row + x);
+	}
+	return x;
+}
+
+#ifdef PLINTH_IMAGE_SIMD
+template <class NoiseT>
+PLINTH_IMAGE_SIMD_TARGET("sse2") inline std::size_t generateRowSse2(std::uint8_t* const row, const std::size_t width, const float y, const std::vector<NoiseOctave>& octaves)
+{
+	return generateRow<Sse2Lanes, NoiseT>(row, 0_uz, width, y, octaves);
+}
+
+template <class NoiseT>
+PLINTH_IMAGE_SIMD_TARGET("avx2") inline std::size_t generateRowAvx2(std::uint8_t* const row, const std::size_t width, const float y, const std::vector<NoiseOctave>& octaves)
+{
+	return generateRow<Avx2Lanes, NoiseT>(row, 0_uz, width, y, octaves);
+}
+#endif // PLINTH_IMAGE_SIMD
+
+template <class NoiseT>
+inline void generateRow(std::uint8_t* const row, const std::size_t width, const float y, const std::vector<NoiseOctave>& octaves)
+{
+	std::size_t x{ 0_uz };
+#ifdef PLINTH_IMAGE_SIMD
+	switch (getInstructionSet())
+	{
+	case InstructionSet::Avx2:
+		x = generateRowAvx2<NoiseT>(row, width, y, octaves);
+		break;
+	case InstructionSet::Sse2:
+		x = generateRowSse2<NoiseT>(row, width, y, octaves);
+		break;
+	case InstructionSet::Scalar:
+		break;
+	}
+#endif // PLINTH_IMAGE_SIMD
+	generateRow<ScalarLanes, NoiseT>(row, x, width, y, octaves);
+}
+
+			} // namespace noise
+
+inline std::vector<NoiseOctave> createNoiseOctaves(const NoiseSettings& settings, const sf::Vector2u size)
+{
+	const std::size_t numberOfOctaves{ std::max(1_uz, std::min(noise::maximumNumberOfOctaves, settings.numberOfOctaves)) };
+	std::vector<NoiseOctave> octaves(numberOfOctaves);
+	double totalAmplitude{ 0.0 };
+	for (std::size_t o{ 0_uz }; o < numberOfOctaves; ++o)
+		totalAmplitude += std::pow(static_cast<double>(settings.persistence), static_cast<double>(o));
+	for (std::size_t o{ 0_uz }; o < numberOfOctaves; ++o)
+	{
+		NoiseOctave& octave{ octaves[o] };
+		const double frequencyMultiplier{ std::pow(static_cast<double>(settings.lacunarity), static_cast<double>(o)) };
+		octave.amplitude = static_cast<float>(std::pow(static_cast<double>(settings.persistence), static_cast<double>(o)) / totalAmplitude);
+		octave.seed = noise::hash(static_cast<std::uint32_t>(o), 0x9e3779b9u, settings.seed);
+		if (settings.isTileable && (size.x > 0u) && (size.y > 0u))
+		{
+			octave.periodX = static_cast<std::uint32_t>(std::max(1.0, std::round(size.x / static_cast<double>(settings.scale) * frequencyMultiplier)));
+			octave.periodY = static_cast<std::uint32_t>(std::max(1.0, std::round(size.y / static_cast<double>(settings.scale) * frequencyMultiplier)));
+			octave.frequencyX = static_cast<float>(static_cast<double>(octave.periodX) / size.x);
+			octave.frequencyY = static_cast<float>(static_cast<double>(octave.periodY) / size.y);
+		}
+		else
+		{
+			octave.periodX = 0u;
+			octave.periodY = 0u;
+			octave.frequencyX = static_cast<float>(frequencyMultiplier / settings.scale);
+			octave.frequencyY = octave.frequencyX;
+		}
+	}
+	return octaves;
+}
+
+inline void generateNoise(std::uint8_t* const pixels, const sf::Vector2u size, const std::size_t stride, const NoiseType type, const NoiseSettings& settings)
+{
+	if ((size.x == 0u) || (size.y == 0u))
+		return;
+	const std::vector<NoiseOctave> octaves{ createNoiseOctaves(settings, size) };
+	processInParallel(size.y, size.x * octaves.size(), [&](const std::size_t begin, const std::size_t end)
+	{
+		for (std::size_t y{ begin }; y < end; ++y)
+		{
+			std::uint8_t* const row{ pixels + (y * stride) };
+			const float rowY{ static_cast<float>(y) };
+			switch (type)
+			{
+			case NoiseType::Value:
+				noise::generateRow<noise::ValueNoise>(row, size.x, rowY, octaves);
+				break;
+			case NoiseType::Perlin:
+				noise::generateRow<noise::PerlinNoise>(row, size.x, rowY, octaves);
+				break;
+			case NoiseType::Simplex:
+				noise::generateRow<noise::SimplexNoise>(row, size.x, rowY, octaves);
+				break;
+			case NoiseType::Worley:
+				noise::generateRow<noise::WorleyNoise>(row, size.x, rowY, octaves);
+				break;
+			case NoiseType::Random:
+				break;
+			}
+		}
+	});
+}
+
+		} // namespace impl
+
+	} // namespace Image
+} // namespace plinth
@@ -0,0 +1,109 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// Plinth
+//
+// Copyright(c) 2014-2025 M.J.Silk
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions :
+//
+// 1. The origin of this software must not be misrepresented; you must not
+// claim that you wrote the original software.If you use this software
+// in a product, an acknowledgment in the product documentation would be
+// appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not be
+// misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+// M.J.Silk
+// MJSilk2@gmail.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+
+// REQUIRES C++11
+
+#pragma once
+
+#include "Common.hpp"
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/Color.hpp>
+#include <SFML/System/Vector2.hpp>
+#include "Image.hpp"
+#include "ImageParallel.hpp"
+#include <vector>
+#include <cstdint>
+
+namespace plinth
+{
+	namespace Image
+	{
+
+// palette quantisation: an image as one byte per pixel (an index into a palette of up to 256 colours) uses a quarter of the memory of RGBA
+// colours (including alpha) are compared by squared distance. images with no more colours than requested are indexed exactly (with no error)
+// mapping pixels to the palette uses a k-d tree (with a cache of recent colours) and is processed in parallel (see processInParallel)
+
+enum class QuantizationType
+{
+	MedianCut, // repeatedly splits the box of colours with the greatest error at its median (using a histogram of 5 bits per component)
+	KMeans // median cut then moves each palette colour to the mean of the pixels nearest to it (for a number of iterations). slower but closer
+};
+
+struct QuantizationError // per component (red, green, blue and alpha)
+{
+	float meanSquaredError;
+	float peakSignalToNoiseRatio; // in decibels. infinite if there is no error
+	unsigned int maximumError; // greatest difference in any component of any pixel
+};
+
+struct IndexedImage
+{
+	sf::Vector2u size;
+	std::vector<std::uint8_t> indices; // one per pixel, in rows
+	std::vector<sf::Color> palette; // at most 256 colours
+	QuantizationError error; // compared with the image it was created from
+};
+
+IndexedImage createIndexedImage(const sf::Image& image, std::size_t maximumNumberOfColors = 256u, QuantizationType type = QuantizationType::MedianCut, std::size_t numberOfIterations = 4u); // iterations are used only by KMeans
+IndexedImage createIndexedImage(const sf::Image& image, const std::vector<sf::Color>& palette); // each pixel becomes the nearest colour of the given palette (e.g. one shared by many images)
+std::vector<sf::Color> createPalette(const sf::Image& image, std::size_t maximumNumberOfColors = 256u, QuantizationType type = QuantizationType::MedianCut, std::size_t numberOfIterations = 4u);
+sf::Image expandIndexedImage(const IndexedImage& indexedImage);
+void expandIndexedImage(const IndexedImage& indexedImage, std::uint8_t* pixels); // writes RGBA pixels (4 bytes per pixel, in rows) e.g. for uploading to a texture. indices outside the palette become transparent black
+QuantizationError getQuantizationError(const sf::Image& image, const IndexedImage& indexedImage);
+
+		namespace impl
+		{
+
+class PaletteTree // k-d tree of palette colours for nearest colour searches
+{
+public:
+	explicit PaletteTree(const std::vector<sf::Color>& palette);
+	std::uint8_t findNearest(std::uint32_t color) const; // color is a pixel read as a little-endian 32-bit value (red is the lowest byte)
+
+private:
+	struct Node
+	{
+		int components[4];
+		std::uint8_t index;
+		std::uint8_t axis;
+		int lower; // child node with smaller component on axis (-1 if none)
+		int higher;
+	};
+	std::vector<Node> m_nodes;
+
+	int priv_build(std::vector<std::size_t>& order, std::size_t begin, std::size_t end, const std::vector<sf::Color>& palette);
+	void priv_search(int node, const int (&components)[4], int& bestDistance, std::uint8_t& bestIndex) const;
+};
+
+		} // namespace impl
+
+	} // namespace Image
+} // namespace plinth
+#include "ImagePalette.inl"
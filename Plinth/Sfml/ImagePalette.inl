@@ -0,0 +1,525 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// Plinth
+//
+// Copyright(c) 2014-2025 M.J.Silk
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions :
+//
+// 1. The origin of this software must not be misrepresented; you must not
+// claim that you wrote the original software.If you use this software
+// in a product, an acknowledgment in the product documentation would be
+// appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not be
+// misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+// M.J.Silk
+// MJSilk2@gmail.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once
+
+#include "ImagePalette.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <mutex>
+#include <unordered_map>
+
+namespace plinth
+{
+	namespace Image
+	{
+		namespace impl
+		{
+
+constexpr unsigned int paletteHistogramBits{ 5u }; // per component
+constexpr std::size_t paletteCacheBits{ 12u }; // size of the cache of recently mapped colours (per thread)
+
+inline std::uint32_t packPaletteColor(const sf::Color color)
+{
+	return static_cast<std::uint32_t>(color.r) | (static_cast<std::uint32_t>(color.g) << 8u) | (static_cast<std::uint32_t>(color.b) << 16u) | (static_cast<std::uint32_t>(color.a) << 24u);
+}
+
+inline std::uint32_t loadPalettePixel(const std::uint8_t* const pixel)
+{
+	return static_cast<std::uint32_t>(pixel[0u]) | (static_cast<std::uint32_t>(pixel[1u]) << 8u) | (static_cast<std::uint32_t>(pixel[2u]) << 16u) | (static_cast<std::uint32_t>(pixel[3u]) << 24u);
+}
+
+inline int getColorDistance(const int (&a)[4], const int (&b)[4])
+{
+	int distance{ 0 };
+	for (std::size_t c{ 0_uz }; c < 4_uz; ++c)
+		distance += (a[c] - b[c]) * (a[c] - b[c]);
+	return distance;
+}
+
+struct PaletteStatistics // accumulated while mapping pixels to a palette
+{
+	std::vector<std::uint64_t> sums; // four components for each palette colour
+	std::vector<std::uint64_t> counts; // for each palette colour
+	std::uint64_t squaredError;
+	unsigned int maximumError;
+
+	PaletteStatistics()
+		: sums(256u * 4u, 0u)
+		, counts(256u, 0u)
+		, squaredError{ 0u }
+		, maximumError{ 0u }
+	{
+	}
+	void add(const PaletteStatistics& other)
+	{
+		for (std::size_t i{ 0_uz }; i < sums.size(); ++i)
+			sums[i] += other.sums[i];
+		for (std::size_t i{ 0_uz }; i < counts.size(); ++i)
+			counts[i] += other.counts[i];
+		squaredError += other.squaredError;
+		maximumError = std::max(maximumError, other.maximumError);
+	}
+};
+
+inline QuantizationError createQuantizationError(const std::uint64_t squaredError, const unsigned int maximumError, const std::size_t numberOfPixels)
+{
+	QuantizationError error;
+	error.meanSquaredError = (numberOfPixels == 0_uz) ? 0.f : static_cast<float>(static_cast<double>(squaredError) / (numberOfPixels * 4.0));
+	error.peakSignalToNoiseRatio = (error.meanSquaredError > 0.f) ? static_cast<float>(10.0 * std::log10((255.0 * 255.0) / error.meanSquaredError)) : std::numeric_limits<float>::infinity();
+	error.maximumError = maximumError;
+	return error;
+}
+
+inline PaletteStatistics mapToPalette(const std::uint8_t* const pixels, const std::size_t numberOfPixels, const std::vector<sf::Color>& palette, std::uint8_t* const indices, const bool isAccumulating)
+{
+	// indices (if not null) are set to the nearest palette colour of each pixel. the sums and counts are only accumulated if requested. the error is always measured
+	const PaletteTree tree(palette);
+	PaletteStatistics statistics;
+	std::mutex mutex;
+	processInParallel(numberOfPixels, 1_uz, [&](const std::size_t begin, const std::size_t end)
+	{
+		const std::size_t cacheSize{ 1_uz << paletteCacheBits };
+		std::vector<std::uint32_t> cachedColors(cacheSize, 0u);
+		std::vector<std::uint8_t> cachedIndices(cacheSize, tree.findNearest(0u));
+		PaletteStatistics partial;
+		for (std::size_t i{ begin }; i < end; ++i)
+		{
+			const std::uint8_t* const pixel{ pixels + (i * 4_uz) };
+			const std::uint32_t color{ loadPalettePixel(pixel) };
+			const std::size_t slot{ static_cast<std::size_t>((color * 2654435761u) >> (32u - paletteCacheBits)) };
+			if (cachedColors[slot] != color)
+			{
+				cachedColors[slot] = color;
+				cachedIndices[slot] = tree.findNearest(color);
+			}
+			const std::uint8_t index{ cachedIndices[slot] };
+			if (indices != nullptr)
+				indices[i] = index;
+			const sf::Color paletteColor{ palette[index] };
+			const int differences[4]{ pixel[0u] - paletteColor.r, pixel[1u] - paletteColor.g, pixel[2u] - paletteColor.b, pixel[3u] - paletteColor.a };
+			for (std::size_t c{ 0_uz }; c < 4_uz; ++c)
+			{
+				partial.squaredError += static_cast<std::uint64_t>(differences[c] * differences[c]);
+				partial.maximumError = std::max(partial.maximumError, static_cast<unsigned int>(std::abs(differences[c])));
+			}
+			if (isAccumulating)
+			{
+				for (std::size_t c{ 0_uz }; c < 4_uz; ++c)
+					partial.sums[index * 4_uz + c] += pixel[c];
+				++partial.counts[index];
+			}
+		}
+		std::lock_guard<std::mutex> lock(mutex);
+		statistics.add(partial);
+	});
+	return statistics;
+}
+
+inline bool collectExactPalette(const std::uint8_t* const pixels, const std::size_t numberOfPixels, const std::size_t maximumNumberOfColors, std::vector<sf::Color>& palette)
+{
+	// false if the image has more colours than the maximum
+	std::unordered_map<std::uint32_t, std::size_t> colors;
+	std::uint32_t previous{ 0u };
+	bool hasPrevious{ false };
+	for (std::size_t i{ 0_uz }; i < numberOfPixels; ++i)
+	{
+		const std::uint32_t color{ loadPalettePixel(pixels + (i * 4_uz)) };
+		if (hasPrevious && (color == previous))
+			continue;
+		previous = color;
+		hasPrevious = true;
+		if (colors.find(color) != colors.end())
+			continue;
+		if (colors.size() == maximumNumberOfColors)
+			return false;
+		colors.emplace(color, colors.size());
+		const std::uint8_t* const pixel{ pixels + (i * 4_uz) };
+		palette.emplace_back(pixel[0u], pixel[1u], pixel[2u], pixel[3u]);
+	}
+	return true;
+}
+
+struct HistogramEntry
+{
+	int components[4]; // centre of the histogram cell
+	std::uint32_t count;
+	std::uint32_t cell;
+};
+
+struct MedianCutBox
+{
+	std::size_t begin; // range of histogram entries
+	std::size_t end;
+	double error; // sum of squared distances from the mean
+	std::size_t axis; // component with the greatest error
+};
+
+inline MedianCutBox createMedianCutBox(const std::vector<HistogramEntry>& entries, const std::size_t begin, const std::size_t end)
+{
+	MedianCutBox box{ begin, end, 0.0, 0u };
+	double count{ 0.0 };
+	double sums[4]{};
+	double squaredSums[4]{};
+	for (std::size_t i{ begin }; i < end; ++i)
+	{
+		const double weight{ static_cast<double>(entries[i].count) };
+		count += weight;
+		for (std::size_t c{ 0_uz }; c < 4_uz; ++c)
+		{
+			sums[c] += weight * entries[i].components[c];
+			squaredSums[c] += weight * entries[i].components[c] * entries[i].components[c];
+		}
+	}
+	double greatestError{ -1.0 };
+	for (std::size_t c{ 0_uz }; c < 4_uz; ++c)
+	{
+		const double error{ squaredSums[c] - (sums[c] * sums[c]) / count };
+		box.error += error;
+		if (error > greatestError)
+		{
+			greatestError = error;
+			box.axis = c;
+		}
+	}
+	if ((end - begin) < 2_uz)
+		box.error = 0.0;
+	return box;
+}
+
+inline std::vector<sf::Color> createMedianCutPalette(const std::uint8_t* const pixels, const std::size_t numberOfPixels, const std::size_t maximumNumberOfColors)
+{
+	const unsigned int discardedBits{ 8u - paletteHistogramBits };
+	const auto getCell = [&](const std::uint8_t* const pixel)
+	{
+		std::uint32_t cell{ 0u };
+		for (std::size_t c{ 0_uz }; c < 4_uz; ++c)
+			cell = (cell << paletteHistogramBits) | (pixel[c] >> discardedBits);
+		return cell;
+	};
+
+	std::vector<std::uint32_t> histogram(1_uz << (paletteHistogramBits * 4u), 0u);
+	for (std::size_t i{ 0_uz }; i < numberOfPixels; ++i)
+		++histogram[getCell(pixels + (i * 4_uz))];
+	std::vector<HistogramEntry> entries;
+	for (std::uint32_t cell{ 0u }; cell < histogram.size(); ++cell)
+	{
+		if (histogram[cell] == 0u)
+			continue;
+		HistogramEntry entry;
+		for (std::size_t c{ 0_uz }; c < 4_uz; ++c)
+			entry.components[c] = static_cast<int>((((cell >> ((3u - c) * paletteHistogramBits)) & ((1u << paletteHistogramBits) - 1u)) << discardedBits) | (1u << (discardedBits - 1u)));
+		entry.count = histogram[cell];
+		entry.cell = cell;
+		entries.push_back(entry);
+	}
+
+	// split the box with the greatest error at the median (by count) of its component with the greatest error
+	std::vector<MedianCutBox> boxes{ createMedianCutBox(entries, 0_uz, entries.size()) };
+	while (boxes.size() < maximumNumberOfColors)
+	{
+		const auto box = std::max_element(boxes.begin(), boxes.end(), [](const MedianCutBox& a, const MedianCutBox& b) { return a.error < b.error; });
+		if (box->error <= 0.0)
+			break;
+		const std::size_t axis{ box->axis };
+		std::sort(entries.begin() + static_cast<std::ptrdiff_t>(box->begin), entries.begin() + static_cast<std::ptrdiff_t>(box->end), [axis](const HistogramEntry& a, const HistogramEntry& b) { return a.components[axis] < b.components[axis]; });
+		std::uint64_t total{ 0u };
+		for (std::size_t i{ box->begin }; i < box->end; ++i)
+			total += entries[i].count;
+		std::uint64_t count{ 0u };
+		std::size_t split{ box->begin + 1_uz };
+		for (std::size_t i{ box->begin }; i < (box->end - 1_uz); ++i)
+		{
+			count += entries[i].count;
+			split = i + 1_uz;
+			if ((count * 2u) >= total)
+				break;
+		}
+		const MedianCutBox lower{ createMedianCutBox(entries, box->begin, split) };
+		const MedianCutBox higher{ createMedianCutBox(entries, split, box->end) };
+		*box = lower;
+		boxes.push_back(higher);
+	}
+
+	// each palette colour is the mean of the pixels in its box
+	std::vector<std::uint8_t> boxOfCell(histogram.size(), 0u);
+	for (std::size_t b{ 0_uz }; b < boxes.size(); ++b)
+	{
+		for (std::size_t i{ boxes[b].begin }; i < boxes[b].end; ++i)
+			boxOfCell[entries[i].cell] = static_cast<std::uint8_t>(b);
+	}
+	PaletteStatistics statistics;
+	std::mutex mutex;
+	processInParallel(numberOfPixels, 1_uz, [&](const std::size_t begin, const std::size_t end)
+	{
+		PaletteStatistics partial;
+		for (std::size_t i{ begin }; i < end; ++i)
+		{
+			const std::uint8_t* const pixel{ pixels + (i * 4_uz) };
+			const std::size_t b{ boxOfCell[getCell(pixel)] };
+			for (std::size_t c{ 0_uz }; c < 4_uz; ++c)
+				partial.sums[b * 4_uz + c] += pixel[c];
+			++partial.counts[b];
+		}
+		std::lock_guard<std::mutex> lock(mutex);
+		statistics.add(partial);
+	});
+	std::vector<sf::Color> palette(boxes.size());
+	for (std::size_t b{ 0_uz }; b < boxes.size(); ++b)
+	{
+		const std::uint64_t count{ std::max<std::uint64_t>(statistics.counts[b], 1u) };
+		std::uint8_t components[4];
+		for (std::size_t c{ 0_uz }; c < 4_uz; ++c)
+			components[c] = static_cast<std::uint8_t>((statistics.sums[b * 4_uz + c] + count / 2u) / count);
+		palette[b] = sf::Color(components[0u], components[1u], components[2u], components[3u]);
+	}
+	return palette;
+}
+
+inline std::vector<sf::Color> createPalette(const std::uint8_t* const pixels, const std::size_t numberOfPixels, const std::size_t maximumNumberOfColors, const QuantizationType type, const std::size_t numberOfIterations)
+{
+	if ((maximumNumberOfColors == 0_uz) || (maximumNumberOfColors > 256_uz))
+		throw Exception(exceptionPrefix + "Cannot create palette. Number of colors must be from 1 to 256.");
+	std::vector<sf::Color> palette;
+	if (numberOfPixels == 0_uz)
+		return palette;
+	if (collectExactPalette(pixels, numberOfPixels, maximumNumberOfColors, palette))
+		return palette;
+	palette = createMedianCutPalette(pixels, numberOfPixels, maximumNumberOfColors);
+	if (type == QuantizationType::KMeans)
+	{
+		for (std::size_t iteration{ 0_uz }; iteration < numberOfIterations; ++iteration)
+		{
+			const PaletteStatistics statistics{ mapToPalette(pixels, numberOfPixels, palette, nullptr, true) };
+			bool hasChanged{ false };
+			for (std::size_t p{ 0_uz }; p < palette.size(); ++p)
+			{
+				const std::uint64_t count{ statistics.counts[p] };
+				if (count == 0u)
+					continue;
+				std::uint8_t components[4];
+				for (std::size_t c{ 0_uz }; c < 4_uz; ++c)
+					components[c] = static_cast<std::uint8_t>((statistics.sums[p * 4_uz + c] + count / 2u) / count);
+				const sf::Color mean(components[0u], components[1u], components[2u], components[3u]);
+				hasChanged = hasChanged || (mean != palette[p]);
+				palette[p] = mean;
+			}
+			if (!hasChanged)
+				break;
+		}
+	}
+	return palette;
+}
+
+inline IndexedImage createIndexedImage(const std::uint8_t* const pixels, const sf::Vector2u size, const std::vector<sf::Color>& palette)
+{
+	IndexedImage indexedImage;
+	indexedImage.size = size;
+	indexedImage.indices.resize(static_cast<std::size_t>(size.x) * size.y);
+	indexedImage.palette = palette;
+	const PaletteStatistics statistics{ mapToPalette(pixels, indexedImage.indices.size(), palette, indexedImage.indices.data(), false) };
+	indexedImage.error = createQuantizationError(statistics.squaredError, statistics.maximumError, indexedImage.indices.size());
+	return indexedImage;
+}
+
+inline PaletteTree::PaletteTree(const std::vector<sf::Color>& palette)
+	: m_nodes()
+{
+	std::vector<std::size_t> order(std::min(palette.size(), 256_uz));
+	for (std::size_t i{ 0_uz }; i < order.size(); ++i)
+		order[i] = i;
+	m_nodes.reserve(order.size());
+	priv_build(order, 0_uz, order.size(), palette);
+}
+
+inline std::uint8_t PaletteTree::findNearest(const std::uint32_t color) const
+{
+	if (m_nodes.empty())
+		return 0u;
+	const int components[4]{ static_cast<int>(color & 0xFFu), static_cast<int>((color >> 8u) & 0xFFu), static_cast<int>((color >> 16u) & 0xFFu), static_cast<int>(color >> 24u) };
+	int bestDistance{ std::numeric_limits<int>::max() };
+	std::uint8_t bestIndex{ 0u };
+	priv_search(0, components, bestDistance, bestIndex);
+	return bestIndex;
+}
+
+// PRIVATE
+
+inline int PaletteTree::priv_build(std::vector<std::size_t>& order, const std::size_t begin, const std::size_t end, const std::vector<sf::Color>& palette)
+{
+	// the median (on the component with the greatest range) is the node and each half is a child
+	if (begin == end)
+		return -1;
+	const auto getComponent = [&](const std::size_t index, const std::size_t component)
+	{
+		const sf::Color color{ palette[index] };
+		const std::uint8_t components[4]{ color.r, color.g, color.b, color.a };
+		return static_cast<int>(components[component]);
+	};
+	std::size_t axis{ 0_uz };
+	int greatestRange{ -1 };
+	for (std::size_t c{ 0_uz }; c < 4_uz; ++c)
+	{
+		int minimum{ 255 };
+		int maximum{ 0 };
+		for (std::size_t i{ begin }; i < end; ++i)
+		{
+			minimum = std::min(minimum, getComponent(order[i], c));
+			maximum = std::max(maximum, getComponent(order[i], c));
+		}
+		if ((maximum - minimum) > greatestRange)
+		{
+			greatestRange = maximum - minimum;
+			axis = c;
+		}
+	}
+	const std::size_t middle{ begin + (end - begin) / 2_uz };
+	std::nth_element(order.begin() + static_cast<std::ptrdiff_t>(begin), order.begin() + static_cast<std::ptrdiff_t>(middle), order.begin() + static_cast<std::ptrdiff_t>(end), [&](const std::size_t a, const std::size_t b)
+	{
+		return getComponent(a, axis) < getComponent(b, axis);
+	});
+
+	const int node{ static_cast<int>(m_nodes.size()) };
+	m_nodes.emplace_back();
+	for (std::size_t c{ 0_uz }; c < 4_uz; ++c)
+		m_nodes[static_cast<std::size_t>(node)].components[c] = getComponent(order[middle], c);
+	m_nodes[static_cast<std::size_t>(node)].index = static_cast<std::uint8_t>(order[middle]);
+	m_nodes[static_cast<std::size_t>(node)].axis = static_cast<std::uint8_t>(axis);
+	const int lower{ priv_build(order, begin, middle, palette) };
+	const int higher{ priv_build(order, middle + 1_uz, end, palette) };
+	m_nodes[static_cast<std::size_t>(node)].lower = lower;
+	m_nodes[static_cast<std::size_t>(node)].higher = higher;
+	return node;
+}
+
+inline void PaletteTree::priv_search(const int nodeIndex, const int (&components)[4], int& bestDistance, std::uint8_t& bestIndex) const
+{
+	if (nodeIndex < 0)
+		return;
+	const Node& node{ m_nodes[static_cast<std::size_t>(nodeIndex)] };
+	const int distance{ getColorDistance(components, node.components) };
+	if ((distance < bestDistance) || ((distance == bestDistance) && (node.index < bestIndex)))
+	{
+		bestDistance = distance;
+		bestIndex = node.index;
+	}
+	const int difference{ components[node.axis] - node.components[node.axis] };
+	priv_search((difference < 0) ? node.lower : node.higher, components, bestDistance, bestIndex);
+	if ((difference * difference) <= bestDistance)
+		priv_search((difference < 0) ? node.higher : node.lower, components, bestDistance, bestIndex);
+}
+
+		} // namespace impl
+
+inline IndexedImage createIndexedImage(const sf::Image& image, const std::size_t maximumNumberOfColors, const QuantizationType type, const std::size_t numberOfIterations)
+{
+	const std::size_t numberOfPixels{ static_cast<std::size_t>(image.getSize().x) * image.getSize().y };
+	return impl::createIndexedImage(image.getPixelsPtr(), image.getSize(), impl::createPalette(image.getPixelsPtr(), numberOfPixels, maximumNumberOfColors, type, numberOfIterations));
+}
+
+inline IndexedImage createIndexedImage(const sf::Image& image, const std::vector<sf::Color>& palette)
+{
+	if (palette.empty() || (palette.size() > 256_uz))
+		throw Exception(exceptionPrefix + "Cannot create indexed image. Palette must have from 1 to 256 colors.");
+	return impl::createIndexedImage(image.getPixelsPtr(), image.getSize(), palette);
+}
+
+inline std::vector<sf::Color> createPalette(const sf::Image& image, const std::size_t maximumNumberOfColors, const QuantizationType type, const std::size_t numberOfIterations)
+{
+	const std::size_t numberOfPixels{ static_cast<std::size_t>(image.getSize().x) * image.getSize().y };
+	return impl::createPalette(image.getPixelsPtr(), numberOfPixels, maximumNumberOfColors, type, numberOfIterations);
+}
+
+inline sf::Image expandIndexedImage(const IndexedImage& indexedImage)
+{
+	sf::Image image(indexedImage.size);
+	if (!indexedImage.indices.empty())
+		expandIndexedImage(indexedImage, impl::getPixels(image));
+	return image;
+}
+
+inline void expandIndexedImage(const IndexedImage& indexedImage, std::uint8_t* const pixels)
+{
+	// a full table so that any index is valid
+	std::array<std::uint32_t, 256u> table{};
+	for (std::size_t i{ 0_uz }; i < std::min(indexedImage.palette.size(), table.size()); ++i)
+		table[i] = impl::packPaletteColor(indexedImage.palette[i]);
+	const std::size_t numberOfPixels{ std::min(indexedImage.indices.size(), static_cast<std::size_t>(indexedImage.size.x) * indexedImage.size.y) };
+	processInParallel(numberOfPixels, 1_uz, [&](const std::size_t begin, const std::size_t end)
+	{
+		const std::uint8_t* const indices{ indexedImage.indices.data() };
+		for (std::size_t i{ begin }; i < end; ++i)
+		{
+			const std::uint32_t color{ table[indices[i]] };
+			std::memcpy(pixels + (i * 4_uz), &color, 4_uz);
+		}
+	});
+}
+
+inline QuantizationError getQuantizationError(const sf::Image& image, const IndexedImage& indexedImage)
+{
+	const sf::Vector2u size{ image.getSize() };
+	const std::size_t numberOfPixels{ static_cast<std::size_t>(size.x) * size.y };
+	if ((size != indexedImage.size) || (indexedImage.indices.size() != numberOfPixels))
+		throw Exception(exceptionPrefix + "Cannot get quantization error. Sizes do not match.");
+
+	const std::uint8_t* const pixels{ image.getPixelsPtr() };
+	std::uint64_t squaredError{ 0u };
+	unsigned int maximumError{ 0u };
+	std::mutex mutex;
+	processInParallel(numberOfPixels, 1_uz, [&](const std::size_t begin, const std::size_t end)
+	{
+		std::uint64_t partialSquaredError{ 0u };
+		unsigned int partialMaximumError{ 0u };
+		for (std::size_t i{ begin }; i < end; ++i)
+		{
+			const std::uint8_t index{ indexedImage.indices[i] };
+			const sf::Color color{ (index < indexedImage.palette.size()) ? indexedImage.palette[index] : sf::Color(0u, 0u, 0u, 0u) };
+			const std::uint8_t components[4]{ color.r, color.g, color.b, color.a };
+			for (std::size_t c{ 0_uz }; c < 4_uz; ++c)
+			{
+				const int difference{ static_cast<int>(pixels[i * 4_uz + c]) - components[c] };
+				partialSquaredError += static_cast<std::uint64_t>(difference * difference);
+				partialMaximumError = std::max(partialMaximumError, static_cast<unsigned int>(std::abs(difference)));
+			}
+		}
+		std::lock_guard<std::mutex> lock(mutex);
+		squaredError += partialSquaredError;
+		maximumError = std::max(maximumError, partialMaximumError);
+	});
+	return impl::createQuantizationError(squaredError, maximumError, numberOfPixels);
+}
+
+	} // namespace Image
+} // namespace plinth
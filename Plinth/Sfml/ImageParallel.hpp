@@ -0,0 +1,85 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// Plinth
+//
+// Copyright(c) 2014-2025 M.J.Silk
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions :
+//
+// 1. The origin of this software must not be misrepresented; you must not
+// claim that you wrote the original software.If you use this software
+// in a product, an acknowledgment in the product documentation would be
+// appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not be
+// misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+// M.J.Silk
+// MJSilk2@gmail.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+
+// REQUIRES C++11
+
+#pragma once
+
+#include "Common.hpp"
+#include "../ThreadPool.hpp"
+#include <memory>
+#include <mutex>
+
+namespace plinth
+{
+	namespace Image
+	{
+
+// parallel processing (disabled by default): work on images (and channels) with at least the threshold number of pixels is split into bands of rows that are processed concurrently by a shared thread pool
+void setNumberOfThreads(std::size_t numberOfThreads); // zero uses the hardware concurrency. one (default) disables parallel processing; its speedup depends on the machine (see tests/ImageParallelBenchmark.cpp). should not be changed while processing
+std::size_t getNumberOfThreads(); // number of threads used (including the calling thread)
+void setParallelThreshold(std::size_t numberOfPixels); // default is 262144 (e.g. 512x512)
+std::size_t getParallelThreshold();
+
+template <class ProcessT>
+void processInParallel(std::size_t numberOfItems, std::size_t numberOfPixelsPerItem, ProcessT process); // process(std::size_t begin, std::size_t end) is called for consecutive ranges of items (e.g. rows) that cover all items, concurrently if more than one thread is used and the total number of pixels reaches the threshold. returns when all are processed. an exception thrown by process is rethrown
+
+		namespace impl
+		{
+
+struct ParallelSettings
+{
+	std::size_t numberOfThreads;
+	std::size_t threshold;
+	std::unique_ptr<ThreadPool> threadPool; // has one thread fewer than numberOfThreads as the calling thread also processes
+	std::mutex mutex;
+};
+
+ParallelSettings& getParallelSettings();
+ThreadPool& getParallelThreadPool();
+bool& isInParallelTask(); // parallel processing started from within a parallel task is processed sequentially (so pool threads never wait on the pool)
+
+class ParallelTaskScope
+{
+public:
+	ParallelTaskScope();
+	~ParallelTaskScope();
+	ParallelTaskScope(const ParallelTaskScope&) = delete;
+	ParallelTaskScope& operator=(const ParallelTaskScope&) = delete;
+
+private:
+	const bool m_wasInParallelTask;
+};
+
+		} // namespace impl
+
+	} // namespace Image
+} // namespace plinth
+#include "ImageParallel.inl"
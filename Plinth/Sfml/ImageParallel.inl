@@ -0,0 +1,172 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// Plinth
+//
+// Copyright(c) 2014-2025 M.J.Silk
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions :
+//
+// 1. The origin of this software must not be misrepresented; you must not
+// claim that you wrote the original software.If you use this software
+// in a product, an acknowledgment in the product documentation would be
+// appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not be
+// misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+// M.J.Silk
+// MJSilk2@gmail.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once
+
+#include "ImageParallel.hpp"
+
+#include <exception>
+#include <future>
+#include <thread>
+#include <vector>
+
+namespace plinth
+{
+	namespace Image
+	{
+
+inline void setNumberOfThreads(const std::size_t numberOfThreads)
+{
+	impl::ParallelSettings& settings{ impl::getParallelSettings() };
+	std::lock_guard<std::mutex> lock(settings.mutex);
+	settings.numberOfThreads = numberOfThreads;
+	settings.threadPool.reset(); // recreated with the new size when next needed
+}
+
+inline std::size_t getNumberOfThreads()
+{
+	impl::ParallelSettings& settings{ impl::getParallelSettings() };
+	std::lock_guard<std::mutex> lock(settings.mutex);
+	if (settings.numberOfThreads != 0_uz)
+		return settings.numberOfThreads;
+	const std::size_t hardwareConcurrency{ static_cast<std::size_t>(std::thread::hardware_concurrency()) };
+	return (hardwareConcurrency > 0_uz) ? hardwareConcurrency : 1_uz;
+}
+
+inline void setParallelThreshold(const std::size_t numberOfPixels)
+{
+	impl::ParallelSettings& settings{ impl::getParallelSettings() };
+	std::lock_guard<std::mutex> lock(settings.mutex);
+	settings.threshold = numberOfPixels;
+}
+
+inline std::size_t getParallelThreshold()
+{
+	impl::ParallelSettings& settings{ impl::getParallelSettings() };
+	std::lock_guard<std::mutex> lock(settings.mutex);
+	return settings.threshold;
+}
+
+template <class ProcessT>
+inline void processInParallel(const std::size_t numberOfItems, const std::size_t numberOfPixelsPerItem, ProcessT process)
+{
+	const std::size_t numberOfThreads{ getNumberOfThreads() };
+	const std::size_t numberOfBands{ (numberOfItems < numberOfThreads) ? numberOfItems : numberOfThreads };
+	if ((numberOfBands < 2_uz) || impl::isInParallelTask() || ((numberOfItems * numberOfPixelsPerItem) < getParallelThreshold()))
+	{
+		process(0_uz, numberOfItems);
+		return;
+	}
+
+	ThreadPool& threadPool{ impl::getParallelThreadPool() };
+	auto getBandBegin = [numberOfItems, numberOfBands](const std::size_t band)
+	{
+		return (numberOfItems * band) / numberOfBands;
+	};
+	std::vector<std::future<void>> futures;
+	futures.reserve(numberOfBands - 1_uz);
+	for (std::size_t band{ 1_uz }; band < numberOfBands; ++band)
+	{
+		const std::size_t begin{ getBandBegin(band) };
+		const std::size_t end{ getBandBegin(band + 1_uz) };
+		futures.push_back(threadPool.add([&process, begin, end]()
+		{
+			const impl::ParallelTaskScope parallelTaskScope{};
+			process(begin, end);
+		}));
+	}
+
+	// the calling thread processes the first band. all bands must finish before returning (even if one throws) as they use process
+	std::exception_ptr exception{};
+	try
+	{
+		const impl::ParallelTaskScope parallelTaskScope{};
+		process(0_uz, getBandBegin(1_uz));
+	}
+	catch (...)
+	{
+		exception = std::current_exception();
+	}
+	for (auto& future : futures)
+	{
+		try
+		{
+			future.get();
+		}
+		catch (...)
+		{
+			if (!exception)
+				exception = std::current_exception();
+		}
+	}
+	if (exception)
+		std::rethrow_exception(exception);
+}
+
+		namespace impl
+		{
+
+inline ParallelSettings& getParallelSettings()
+{
+	static ParallelSettings settings{ 1_uz, 262144_uz, nullptr, {} };
+	return settings;
+}
+
+inline ThreadPool& getParallelThreadPool()
+{
+	const std::size_t numberOfThreads{ getNumberOfThreads() };
+	ParallelSettings& settings{ getParallelSettings() };
+	std::lock_guard<std::mutex> lock(settings.mutex);
+	if (!settings.threadPool)
+		settings.threadPool.reset(new ThreadPool(numberOfThreads - 1_uz));
+	return *settings.threadPool;
+}
+
+inline bool& isInParallelTask()
+{
+	thread_local bool isInParallelTask{ false };
+	return isInParallelTask;
+}
+
+inline ParallelTaskScope::ParallelTaskScope()
+	: m_wasInParallelTask{ isInParallelTask() }
+{
+	isInParallelTask() = true;
+}
+
+inline ParallelTaskScope::~ParallelTaskScope()
+{
+	isInParallelTask() = m_wasInParallelTask;
+}
+
+		} // namespace impl
+
+	} // namespace Image
+} // namespace plinth
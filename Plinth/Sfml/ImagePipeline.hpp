@@ -0,0 +1,161 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// Plinth
+//
+// Copyright(c) 2014-2025 M.J.Silk
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions :
+//
+// 1. The origin of this software must not be misrepresented; you must not
+// claim that you wrote the original software.If you use this software
+// in a product, an acknowledgment in the product documentation would be
+// appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not be
+// misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+// M.J.Silk
+// MJSilk2@gmail.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+
+// REQUIRES C++11
+
+#pragma once
+
+#include "Common.hpp"
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/Color.hpp>
+#include <SFML/System/Vector2.hpp>
+#include "Image.hpp"
+#include "ImageChannel.hpp"
+#include "ImageParallel.hpp"
+#include <tuple>
+
+namespace plinth
+{
+	namespace Image
+	{
+
+// pipeline: per-pixel stages composed at compile time and applied in a single pass over memory
+// each row is processed in tiles (of tileWidth pixels) and all stages are run on a tile while it is still in cache, so the image is read and written only once however many stages there are
+// a stage is any object callable as stage(sf::Color& pixel, sf::Vector2u location) const. it may also provide:
+//   processSpan(std::uint8_t* pixels, std::size_t numberOfPixels, sf::Vector2u location) const - processes consecutive RGBA pixels of one row starting at location (used instead of calling the stage per pixel; the built-in stages use SIMD here)
+//   validate(sf::Vector2u imageSize) const - called before processing and should throw if the stage cannot be applied to that size
+// rows are processed in bands that may be processed concurrently (see processInParallel) so stages must be safe to call from multiple threads
+template <class... StageTs>
+class Pipeline
+{
+public:
+	explicit Pipeline(const StageTs&... stages);
+	template <class StageT>
+	Pipeline<StageTs..., StageT> then(const StageT& stage) const; // returns a new pipeline with the stage appended
+	void apply(sf::Image& image, bool isParallel = true) const; // in place
+	sf::Image applyTo(const sf::Image& image, bool isParallel = true) const; // returns a new (processed) image. the source image is not modified
+	void applyTo(const sf::Image& source, sf::Image& destination, bool isParallel = true) const; // destination is resized to match source. source and destination must not be the same image (use apply instead)
+	void validate(sf::Vector2u imageSize) const;
+	void operator()(sf::Color& pixel, sf::Vector2u location) const; // a pipeline is also a stage
+	void processSpan(std::uint8_t* pixels, std::size_t numberOfPixels, sf::Vector2u location) const;
+
+	static const std::size_t tileWidth{ 1024u }; // 4KiB of pixels
+
+private:
+	template <class...>
+	friend class Pipeline;
+	struct FromTuple {};
+
+	std::tuple<StageTs...> m_stages;
+
+	Pipeline(FromTuple, const std::tuple<StageTs...>& stages);
+	void priv_processRow(const std::uint8_t* source, std::uint8_t* destination, unsigned int y, unsigned int width) const;
+};
+
+template <class... StageTs>
+Pipeline<StageTs...> makePipeline(const StageTs&... stages);
+
+		namespace stages
+		{
+
+// built-in stages. each matches the equivalent whole-image operation (e.g. Image::invert) exactly
+// channel stages store a reference to the channel so it must outlive the pipeline. its size must match the image
+
+struct Grayscale
+{
+	GrayscaleConversionType conversionType;
+	bool isLinearLight;
+	void operator()(sf::Color& pixel, sf::Vector2u location) const;
+	void processSpan(std::uint8_t* pixels, std::size_t numberOfPixels, sf::Vector2u location) const;
+};
+struct Invert
+{
+	void operator()(sf::Color& pixel, sf::Vector2u location) const;
+	void processSpan(std::uint8_t* pixels, std::size_t numberOfPixels, sf::Vector2u location) const;
+};
+struct CreateMaskFromAlpha
+{
+	void operator()(sf::Color& pixel, sf::Vector2u location) const;
+	void processSpan(std::uint8_t* pixels, std::size_t numberOfPixels, sf::Vector2u location) const;
+};
+struct ClearWithColorButRetainTransparency
+{
+	sf::Color color;
+	void operator()(sf::Color& pixel, sf::Vector2u location) const;
+	void processSpan(std::uint8_t* pixels, std::size_t numberOfPixels, sf::Vector2u location) const;
+};
+struct SetAlpha
+{
+	unsigned char alpha;
+	void operator()(sf::Color& pixel, sf::Vector2u location) const;
+	void processSpan(std::uint8_t* pixels, std::size_t numberOfPixels, sf::Vector2u location) const;
+};
+struct InvertAlpha
+{
+	void operator()(sf::Color& pixel, sf::Vector2u location) const;
+	void processSpan(std::uint8_t* pixels, std::size_t numberOfPixels, sf::Vector2u location) const;
+};
+struct FromChannel
+{
+	const Channel* channel;
+	ColorChannel colorChannel;
+	void operator()(sf::Color& pixel, sf::Vector2u location) const;
+	void processSpan(std::uint8_t* pixels, std::size_t numberOfPixels, sf::Vector2u location) const;
+	void validate(sf::Vector2u imageSize) const;
+};
+template <class ProcessT>
+struct Color
+{
+	ProcessT process;
+	void operator()(sf::Color& pixel, sf::Vector2u location) const;
+};
+
+Grayscale grayscale(GrayscaleConversionType conversionType = GrayscaleConversionType::Luminosity, bool isLinearLight = false);
+Invert invert();
+CreateMaskFromAlpha createMaskFromAlpha();
+ClearWithColorButRetainTransparency clearWithColorButRetainTransparency(sf::Color color = sf::Color(255_uc, 255_uc, 255_uc, 255_uc));
+SetAlpha setAlpha(unsigned char alpha = 255_uc);
+InvertAlpha invertAlpha();
+SetAlpha makeOpaque();
+FromChannel fromChannel(const Channel& channel, ColorChannel colorChannel);
+FromChannel setRedFromChannel(const Channel& channel);
+FromChannel setGreenFromChannel(const Channel& channel);
+FromChannel setBlueFromChannel(const Channel& channel);
+FromChannel setRgbFromChannel(const Channel& channel);
+FromChannel setAlphaFromChannel(const Channel& channel);
+FromChannel setAlphaFromMask(const Channel& mask);
+template <class ProcessT>
+Color<ProcessT> color(ProcessT process); // wraps process(sf::Color& pixel) (e.g. a lambda) as a stage
+
+		} // namespace stages
+
+	} // namespace Image
+} // namespace plinth
+#include "ImagePipeline.inl"
@@ -0,0 +1,470 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// Plinth
+//
+// Copyright(c) 2014-2025 M.J.Silk
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions :
+//
+// 1. The origin of this software must not be misrepresented; you must not
+// claim that you wrote the original software.If you use this software
+// in a product, an acknowledgment in the product documentation would be
+// appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not be
+// misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+// M.J.Silk
+// MJSilk2@gmail.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once
+
+#include "ImagePipeline.hpp"
+
+#include <cstring>
+#include <type_traits>
+
+namespace plinth
+{
+	namespace Image
+	{
+		namespace impl
+		{
+
+template <std::size_t indexT, class TupleT>
+inline typename std::enable_if<(indexT == std::tuple_size<TupleT>::value)>::type runStages(const TupleT&, sf::Color&, sf::Vector2u)
+{
+}
+
+template <std::size_t indexT, class TupleT>
+inline typename std::enable_if<(indexT < std::tuple_size<TupleT>::value)>::type runStages(const TupleT& stages, sf::Color& pixel, const sf::Vector2u location)
+{
+	std::get<indexT>(stages)(pixel, location);
+	runStages<indexT + 1_uz>(stages, pixel, location);
+}
+
+template <class StageT>
+inline auto processStageSpan(const StageT& stage, std::uint8_t* const pixels, const std::size_t numberOfPixels, const sf::Vector2u location, int) -> decltype(stage.processSpan(pixels, numberOfPixels, location), void())
+{
+	stage.processSpan(pixels, numberOfPixels, location);
+}
+
+template <class StageT>
+inline void processStageSpan(const StageT& stage, std::uint8_t* const pixels, const std::size_t numberOfPixels, const sf::Vector2u location, long)
+{
+	// stage does not provide processSpan so is called for each pixel
+	for (std::size_t i{ 0_uz }; i < numberOfPixels; ++i)
+	{
+		sf::Color pixel{ loadPixel(pixels + (i * 4_uz)) };
+		stage(pixel, sf::Vector2u{ location.x + static_cast<unsigned int>(i), location.y });
+		storePixel(pixels + (i * 4_uz), pixel);
+	}
+}
+
+template <std::size_t indexT, class TupleT>
+inline typename std::enable_if<(indexT == std::tuple_size<TupleT>::value)>::type runStagesOnSpan(const TupleT&, std::uint8_t*, std::size_t, sf::Vector2u)
+{
+}
+
+template <std::size_t indexT, class TupleT>
+inline typename std::enable_if<(indexT < std::tuple_size<TupleT>::value)>::type runStagesOnSpan(const TupleT& stages, std::uint8_t* const pixels, const std::size_t numberOfPixels, const sf::Vector2u location)
+{
+	processStageSpan(std::get<indexT>(stages), pixels, numberOfPixels, location, 0);
+	runStagesOnSpan<indexT + 1_uz>(stages, pixels, numberOfPixels, location);
+}
+
+template <class StageT>
+inline void processStageSpanSimd(const StageT& stage, const simd::Operation operation, const simd::Parameters& parameters, std::uint8_t* const pixels, const std::size_t numberOfPixels, const sf::Vector2u location)
+{
+	// stage must give identical results to the SIMD operation. it is used for remaining pixels or if SIMD is not available
+	const std::size_t numberOfProcessedPixels{ simd::process(operation, pixels, numberOfPixels, parameters) };
+	processStageSpan(stage, pixels + (numberOfProcessedPixels * 4_uz), numberOfPixels - numberOfProcessedPixels, sf::Vector2u{ location.x + static_cast<unsigned int>(numberOfProcessedPixels), location.y }, 0L);
+}
+
+inline std::uint32_t packColorRgb(const sf::Color color)
+{
+	return color.r | (static_cast<std::uint32_t>(color.g) << 8u) | (static_cast<std::uint32_t>(color.b) << 16u);
+}
+
+template <class StageT>
+inline auto validateStage(const StageT& stage, const sf::Vector2u imageSize, int) -> decltype(stage.validate(imageSize), void())
+{
+	stage.validate(imageSize);
+}
+
+template <class StageT>
+inline void validateStage(const StageT&, sf::Vector2u, long)
+{
+	// stage does not provide validate
+}
+
+template <std::size_t indexT, class TupleT>
+inline typename std::enable_if<(indexT == std::tuple_size<TupleT>::value)>::type validateStages(const TupleT&, sf::Vector2u)
+{
+}
+
+template <std::size_t indexT, class TupleT>
+inline typename std::enable_if<(indexT < std::tuple_size<TupleT>::value)>::type validateStages(const TupleT& stages, const sf::Vector2u imageSize)
+{
+	validateStage(std::get<indexT>(stages), imageSize, 0);
+	validateStages<indexT + 1_uz>(stages, imageSize);
+}
+
+		} // namespace impl
+
+template <class... StageTs>
+inline Pipeline<StageTs...>::Pipeline(const StageTs&... stages)
+	: m_stages(stages...)
+{
+}
+
+template <class... StageTs>
+template <class StageT>
+inline Pipeline<StageTs..., StageT> Pipeline<StageTs...>::then(const StageT& stage) const
+{
+	return Pipeline<StageTs..., StageT>(typename Pipeline<StageTs..., StageT>::FromTuple{}, std::tuple_cat(m_stages, std::tuple<StageT>(stage)));
+}
+
+template <class... StageTs>
+inline void Pipeline<StageTs...>::apply(sf::Image& image, const bool isParallel) const
+{
+	validate(image.getSize());
+	processAllRows(image, [this](std::uint8_t* const row, const unsigned int y, const unsigned int width)
+	{
+		priv_processRow(row, row, y, width);
+	}, isParallel);
+}
+
+template <class... StageTs>
+inline sf::Image Pipeline<StageTs...>::applyTo(const sf::Image& image, const bool isParallel) const
+{
+	sf::Image result{};
+	applyTo(image, result, isParallel);
+	return result;
+}
+
+template <class... StageTs>
+inline void Pipeline<StageTs...>::applyTo(const sf::Image& source, sf::Image& destination, const bool isParallel) const
+{
+	// the destination is written directly from the source so the source is read only once (no intermediate copy)
+	const sf::Vector2u imageSize{ source.getSize() };
+	validate(imageSize);
+	if (destination.getSize() != imageSize)
+		destination.resize(imageSize);
+	const std::uint8_t* const sourcePixels{ source.getPixelsPtr() };
+	if (sourcePixels == nullptr)
+		return;
+	const std::size_t rowSize{ imageSize.x * 4_uz };
+	processAllRows(destination, [&](std::uint8_t* const row, const unsigned int y, const unsigned int width)
+	{
+		priv_processRow(sourcePixels + (y * rowSize), row, y, width);
+	}, isParallel);
+}
+
+template <class... StageTs>
+inline void Pipeline<StageTs...>::validate(const sf::Vector2u imageSize) const
+{
+	impl::validateStages<0_uz>(m_stages, imageSize);
+}
+
+template <class... StageTs>
+inline void Pipeline<StageTs...>::operator()(sf::Color& pixel, const sf::Vector2u location) const
+{
+	impl::runStages<0_uz>(m_stages, pixel, location);
+}
+
+template <class... StageTs>
+inline void Pipeline<StageTs...>::processSpan(std::uint8_t* const pixels, const std::size_t numberOfPixels, const sf::Vector2u location) const
+{
+	impl::runStagesOnSpan<0_uz>(m_stages, pixels, numberOfPixels, location);
+}
+
+template <class... StageTs>
+inline Pipeline<StageTs...> makePipeline(const StageTs&... stages)
+{
+	return Pipeline<StageTs...>(stages...);
+}
+
+		namespace stages
+		{
+
+inline void Grayscale::operator()(sf::Color& pixel, sf::Vector2u) const
+{
+	if (isLinearLight)
+	{
+		pixel.r = pixel.g = pixel.b = impl::getLinearLightGray(pixel, conversionType);
+		return;
+	}
+	switch (conversionType)
+	{
+	case GrayscaleConversionType::RedChannel:
+		pixel.g = pixel.b = pixel.r;
+		break;
+	case GrayscaleConversionType::GreenChannel:
+		pixel.b = pixel.r = pixel.g;
+		break;
+	case GrayscaleConversionType::BlueChannel:
+		pixel.r = pixel.g = pixel.b;
+		break;
+	case GrayscaleConversionType::Lightness:
+		pixel.r = pixel.g = pixel.b = impl::getLightness(pixel);
+		break;
+	case GrayscaleConversionType::Median:
+		pixel.r = pixel.g = pixel.b = impl::getMedian(pixel);
+		break;
+	case GrayscaleConversionType::Average:
+		pixel.r = pixel.g = pixel.b = impl::getAverage(pixel);
+		break;
+	case GrayscaleConversionType::Luminosity:
+	default:
+		pixel.r = pixel.g = pixel.b = impl::getLuminosity(pixel);
+	}
+}
+
+inline void Invert::operator()(sf::Color& pixel, sf::Vector2u) const
+{
+	// preserves pixel alpha
+	pixel.r = 255_uc - pixel.r;
+	pixel.g = 255_uc - pixel.g;
+	pixel.b = 255_uc - pixel.b;
+}
+
+inline void CreateMaskFromAlpha::operator()(sf::Color& pixel, sf::Vector2u) const
+{
+	pixel.r = pixel.a;
+	pixel.g = pixel.a;
+	pixel.b = pixel.a;
+	pixel.a = 255_uc;
+}
+
+inline void ClearWithColorButRetainTransparency::operator()(sf::Color& pixel, sf::Vector2u) const
+{
+	pixel.r = color.r;
+	pixel.g = color.g;
+	pixel.b = color.b;
+}
+
+inline void SetAlpha::operator()(sf::Color& pixel, sf::Vector2u) const
+{
+	pixel.a = alpha;
+}
+
+inline void InvertAlpha::operator()(sf::Color& pixel, sf::Vector2u) const
+{
+	pixel.a = 255_uc - pixel.a;
+}
+
+inline void Grayscale::processSpan(std::uint8_t* const pixels, const std::size_t numberOfPixels, const sf::Vector2u location) const
+{
+	if (isLinearLight)
+	{
+		impl::processStageSpan(*this, pixels, numberOfPixels, location, 0L);
+		return;
+	}
+	impl::simd::Parameters parameters{ 0xFF000000u, 0u, 0u, 0u };
+	impl::simd::Operation operation{ impl::simd::Operation::ReplicateChannel };
+	switch (conversionType)
+	{
+	case GrayscaleConversionType::RedChannel:
+		break;
+	case GrayscaleConversionType::GreenChannel:
+		parameters.shift = 8u;
+		break;
+	case GrayscaleConversionType::BlueChannel:
+		parameters.shift = 16u;
+		break;
+	case GrayscaleConversionType::Lightness:
+		operation = impl::simd::Operation::Lightness;
+		break;
+	case GrayscaleConversionType::Median:
+		operation = impl::simd::Operation::Median;
+		break;
+	case GrayscaleConversionType::Average:
+		operation = impl::simd::Operation::Average;
+		break;
+	case GrayscaleConversionType::Luminosity:
+	default:
+		operation = impl::simd::Operation::Luminosity;
+	}
+	impl::processStageSpanSimd(*this, operation, parameters, pixels, numberOfPixels, location);
+}
+
+inline void Invert::processSpan(std::uint8_t* const pixels, const std::size_t numberOfPixels, const sf::Vector2u location) const
+{
+	impl::processStageSpanSimd(*this, impl::simd::Operation::Bitwise, { 0xFFFFFFFFu, 0u, 0x00FFFFFFu, 0u }, pixels, numberOfPixels, location);
+}
+
+inline void CreateMaskFromAlpha::processSpan(std::uint8_t* const pixels, const std::size_t numberOfPixels, const sf::Vector2u location) const
+{
+	impl::processStageSpanSimd(*this, impl::simd::Operation::ReplicateChannel, { 0u, 0xFF000000u, 0u, 24u }, pixels, numberOfPixels, location);
+}
+
+inline void ClearWithColorButRetainTransparency::processSpan(std::uint8_t* const pixels, const std::size_t numberOfPixels, const sf::Vector2u location) const
+{
+	impl::processStageSpanSimd(*this, impl::simd::Operation::Bitwise, { 0xFF000000u, impl::packColorRgb(color), 0u, 0u }, pixels, numberOfPixels, location);
+}
+
+inline void SetAlpha::processSpan(std::uint8_t* const pixels, const std::size_t numberOfPixels, const sf::Vector2u location) const
+{
+	impl::processStageSpanSimd(*this, impl::simd::Operation::Bitwise, { 0x00FFFFFFu, static_cast<std::uint32_t>(alpha) << 24u, 0u, 0u }, pixels, numberOfPixels, location);
+}
+
+inline void InvertAlpha::processSpan(std::uint8_t* const pixels, const std::size_t numberOfPixels, const sf::Vector2u location) const
+{
+	impl::processStageSpanSimd(*this, impl::simd::Operation::Bitwise, { 0xFFFFFFFFu, 0u, 0xFF000000u, 0u }, pixels, numberOfPixels, location);
+}
+
+inline void FromChannel::operator()(sf::Color& pixel, const sf::Vector2u location) const
+{
+	const unsigned char value{ channel->getRow(location.y)[location.x] }; // unchecked as the size is validated before processing
+	switch (colorChannel)
+	{
+	case ColorChannel::Red:
+		pixel.r = value;
+		break;
+	case ColorChannel::Green:
+		pixel.g = value;
+		break;
+	case ColorChannel::Blue:
+		pixel.b = value;
+		break;
+	case ColorChannel::Alpha:
+		pixel.a = value;
+		break;
+	default:
+		pixel.r = value;
+		pixel.g = value;
+		pixel.b = value;
+	}
+}
+
+inline void FromChannel::processSpan(std::uint8_t* const pixels, const std::size_t numberOfPixels, const sf::Vector2u location) const
+{
+	impl::insertChannelRow(pixels, channel->getRow(location.y).pixels + location.x, numberOfPixels, colorChannel, false);
+}
+
+inline void FromChannel::validate(const sf::Vector2u imageSize) const
+{
+	if (channel->getSize() != imageSize)
+		throw Exception(exceptionPrefix + "Cannot apply pipeline. Channel size does not match image size.");
+}
+
+template <class ProcessT>
+inline void Color<ProcessT>::operator()(sf::Color& pixel, sf::Vector2u) const
+{
+	process(pixel);
+}
+
+inline Grayscale grayscale(const GrayscaleConversionType conversionType, const bool isLinearLight)
+{
+	return{ conversionType, isLinearLight };
+}
+
+inline Invert invert()
+{
+	return{};
+}
+
+inline CreateMaskFromAlpha createMaskFromAlpha()
+{
+	return{};
+}
+
+inline ClearWithColorButRetainTransparency clearWithColorButRetainTransparency(const sf::Color color)
+{
+	return{ color };
+}
+
+inline SetAlpha setAlpha(const unsigned char alpha)
+{
+	return{ alpha };
+}
+
+inline InvertAlpha invertAlpha()
+{
+	return{};
+}
+
+inline SetAlpha makeOpaque()
+{
+	return{ 255_uc };
+}
+
+inline FromChannel fromChannel(const Channel& channel, const ColorChannel colorChannel)
+{
+	return{ &channel, colorChannel };
+}
+
+inline FromChannel setRedFromChannel(const Channel& channel)
+{
+	return{ &channel, ColorChannel::Red };
+}
+
+inline FromChannel setGreenFromChannel(const Channel& channel)
+{
+	return{ &channel, ColorChannel::Green };
+}
+
+inline FromChannel setBlueFromChannel(const Channel& channel)
+{
+	return{ &channel, ColorChannel::Blue };
+}
+
+inline FromChannel setRgbFromChannel(const Channel& channel)
+{
+	return{ &channel, ColorChannel::Rgb };
+}
+
+inline FromChannel setAlphaFromChannel(const Channel& channel)
+{
+	return{ &channel, ColorChannel::Alpha };
+}
+
+inline FromChannel setAlphaFromMask(const Channel& mask)
+{
+	return{ &mask, ColorChannel::Alpha };
+}
+
+template <class ProcessT>
+inline Color<ProcessT> color(ProcessT process)
+{
+	return{ process };
+}
+
+		} // namespace stages
+
+// PRIVATE
+
+template <class... StageTs>
+inline Pipeline<StageTs...>::Pipeline(FromTuple, const std::tuple<StageTs...>& stages)
+	: m_stages(stages)
+{
+}
+
+template <class... StageTs>
+inline void Pipeline<StageTs...>::priv_processRow(const std::uint8_t* const source, std::uint8_t* const destination, const unsigned int y, const unsigned int width) const
+{
+	// all stages are run on one tile before moving to the next so the tile stays in cache
+	for (std::size_t x{ 0_uz }; x < width; x += tileWidth)
+	{
+		const std::size_t numberOfPixels{ ((width - x) < tileWidth) ? (width - x) : tileWidth };
+		std::uint8_t* const tile{ destination + (x * 4_uz) };
+		if (source != destination)
+			std::memcpy(tile, source + (x * 4_uz), numberOfPixels * 4_uz);
+		processSpan(tile, numberOfPixels, sf::Vector2u{ static_cast<unsigned int>(x), y });
+	}
+}
+
+	} // namespace Image
+} // namespace plinth
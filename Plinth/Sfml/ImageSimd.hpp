@@ -0,0 +1,100 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// Plinth
+//
+// Copyright(c) 2014-2025 M.J.Silk
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions :
+//
+// 1. The origin of this software must not be misrepresented; you must not
+// claim that you wrote the original software.If you use this software
+// in a product, an acknowledgment in the product documentation would be
+// appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not be
+// misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+// M.J.Silk
+// MJSilk2@gmail.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+
+// REQUIRES C++11
+
+#pragma once
+
+#include "Common.hpp"
+#include <cstdint>
+#include <cstddef>
+
+#if (defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)) && !defined(PLINTH_NO_SIMD)
+#define PLINTH_IMAGE_SIMD
+#endif
+
+namespace plinth
+{
+	namespace Image
+	{
+
+enum class InstructionSet
+{
+	Scalar,
+	Sse2,
+	Avx2
+};
+
+// pixel operations use the best instruction set available (detected at runtime) up to the maximum
+// results are identical (bit-exact) whichever instruction set is used. define PLINTH_NO_SIMD to compile out the SIMD paths
+void setMaximumInstructionSet(InstructionSet instructionSet); // default is Avx2. Scalar disables SIMD
+InstructionSet getMaximumInstructionSet();
+InstructionSet getInstructionSet(); // the instruction set in use
+
+		namespace impl
+		{
+			namespace simd
+			{
+
+enum class Operation
+{
+	Bitwise, // ((pixel & andMask) | orMask) ^ xorMask
+	ReplicateChannel, // component at bit shift is copied to red, green and blue. alpha is (pixel & andMask) | orMask
+	Luminosity, // grayscale from relative luminance. alpha is (pixel & andMask) | orMask
+	Average, // grayscale from mean of red, green and blue. alpha is (pixel & andMask) | orMask
+	Lightness, // grayscale from mean of highest and lowest of red, green and blue. alpha is (pixel & andMask) | orMask
+	Median, // grayscale from median of red, green and blue. alpha is (pixel & andMask) | orMask
+	Premultiply, // red, green and blue = (component x alpha) / 255 rounded. masks are not used
+	Unpremultiply // red, green and blue = (component x 255 + alpha / 2) / alpha clamped to 255 (zero if alpha is zero). masks are not used
+};
+
+struct Parameters // masks are of a pixel read as a little-endian 32-bit value (red is the lowest byte)
+{
+	std::uint32_t andMask;
+	std::uint32_t orMask;
+	std::uint32_t xorMask;
+	unsigned int shift;
+};
+
+InstructionSet detectInstructionSet();
+std::size_t process(Operation operation, std::uint8_t* pixels, std::size_t numberOfPixels, const Parameters& parameters); // returns number of pixels processed (from the start). the rest must be processed by scalar code
+std::size_t extract(Operation operation, const std::uint8_t* pixels, std::uint8_t* values, std::size_t numberOfPixels, const Parameters& parameters); // values are the gray that the operation gives each pixel (masks are not used). only ReplicateChannel and Average are supported. returns number of pixels processed (from the start)
+std::size_t insert(std::uint8_t* pixels, const std::uint8_t* values, std::size_t numberOfPixels, const Parameters& parameters, bool isReplicated); // pixel = (pixel & andMask) | orMask | (value << shift). if replicated, value is put in red, green and blue instead. returns number of pixels processed (from the start)
+std::size_t downsampleBox(const std::uint8_t* upperRow, const std::uint8_t* lowerRow, std::uint8_t* destination, std::size_t numberOfDestinationPixels); // each destination pixel is the rounded mean ((sum + 2) / 4) of source pixels 2i and 2i+1 of both rows. returns number of destination pixels processed (from the start)
+std::size_t accumulateWeighted(const std::uint8_t* values, std::int32_t* accumulators, std::size_t numberOfValues, std::int32_t weight); // accumulator += value x weight. weight must be greater than -2^22 and less than 2^22. returns number of values processed (from the start)
+std::size_t narrow(const std::int32_t* accumulators, std::uint8_t* values, std::size_t numberOfValues, unsigned int shift); // value = (accumulator >> shift) clamped to 0-255 (shift is arithmetic). returns number of values processed (from the start)
+std::size_t slideBox(std::uint32_t* sums, const std::uint8_t* entering, const std::uint8_t* leaving, std::uint8_t* values, std::size_t numberOfValues, std::uint32_t half, std::uint32_t reciprocal, unsigned int shift); // value = ((sum + half) x reciprocal) >> shift (64-bit product. shift must be at least 32 and the value less than 256) then sum += entering - leaving. returns number of values processed (from the start)
+
+			} // namespace simd
+		} // namespace impl
+
+	} // namespace Image
+} // namespace plinth
+#include "ImageSimd.inl"
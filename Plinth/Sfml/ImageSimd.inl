@@ -0,0 +1,936 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// Plinth
+//
+// Copyright(c) 2014-2025 M.J.Silk
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions :
+//
+// 1. The origin of this software must not be misrepresented; you must not
+// claim that you wrote the original software.If you use this software
+// in a product, an acknowledgment in the product documentation would be
+// appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not be
+// misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+// M.J.Silk
+// MJSilk2@gmail.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once
+
+#include "ImageSimd.hpp"
+
+#ifdef PLINTH_IMAGE_SIMD
+#include <emmintrin.h>
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#define PLINTH_IMAGE_SIMD_TARGET(instructionSet)
+#else // _MSC_VER
+#define PLINTH_IMAGE_SIMD_TARGET(instructionSet) __attribute__((target(instructionSet)))
+#endif // _MSC_VER
+#endif // PLINTH_IMAGE_SIMD
+
+namespace plinth
+{
+	namespace Image
+	{
+		namespace impl
+		{
+			namespace simd
+			{
+
+inline InstructionSet& maximumInstructionSet()
+{
+	static InstructionSet maximum{ InstructionSet::Avx2 };
+	return maximum;
+}
+
+#ifdef PLINTH_IMAGE_SIMD
+
+// SSE2: 4 pixels per vector
+
+PLINTH_IMAGE_SIMD_TARGET("sse2") inline __m128i sse2GrayWithAlpha(__m128i gray, const __m128i pixels, const __m128i andMask, const __m128i orMask)
+{
+	// gray is in the lowest byte of each pixel (other bytes are zero). it is copied into the next two bytes (green and blue)
+	gray = _mm_or_si128(gray, _mm_slli_epi32(gray, 8));
+	gray = _mm_or_si128(gray, _mm_slli_epi32(gray, 8));
+	return _mm_or_si128(gray, _mm_or_si128(_mm_and_si128(pixels, andMask), orMask));
+}
+
+struct Sse2Bitwise
+{
+	__m128i andMask;
+	__m128i orMask;
+	__m128i xorMask;
+	PLINTH_IMAGE_SIMD_TARGET("sse2") explicit Sse2Bitwise(const Parameters& parameters)
+		: andMask{ _mm_set1_epi32(static_cast<int>(parameters.andMask)) }
+		, orMask{ _mm_set1_epi32(static_cast<int>(parameters.orMask)) }
+		, xorMask{ _mm_set1_epi32(static_cast<int>(parameters.xorMask)) }
+	{
+	}
+	PLINTH_IMAGE_SIMD_TARGET("sse2") __m128i operator()(const __m128i pixels) const
+	{
+		return _mm_xor_si128(_mm_or_si128(_mm_and_si128(pixels, andMask), orMask), xorMask);
+	}
+};
+
+struct Sse2Gray // base for operations that produce gray with alpha from masks
+{
+	__m128i andMask;
+	__m128i orMask;
+	PLINTH_IMAGE_SIMD_TARGET("sse2") explicit Sse2Gray(const Parameters& parameters)
+		: andMask{ _mm_set1_epi32(static_cast<int>(parameters.andMask)) }
+		, orMask{ _mm_set1_epi32(static_cast<int>(parameters.orMask)) }
+	{
+	}
+};
+
+struct Sse2ReplicateChannel : Sse2Gray
+{
+	__m128i shift;
+	PLINTH_IMAGE_SIMD_TARGET("sse2") explicit Sse2ReplicateChannel(const Parameters& parameters)
+		: Sse2Gray(parameters)
+		, shift{ _mm_cvtsi32_si128(static_cast<int>(parameters.shift)) }
+	{
+	}
+	PLINTH_IMAGE_SIMD_TARGET("sse2") __m128i operator()(const __m128i pixels) const
+	{
+		return sse2GrayWithAlpha(_mm_and_si128(_mm_srl_epi32(pixels, shift), _mm_set1_epi32(0xFF)), pixels, andMask, orMask);
+	}
+};
+
+struct Sse2Luminosity : Sse2Gray
+{
+	using Sse2Gray::Sse2Gray;
+	PLINTH_IMAGE_SIMD_TARGET("sse2") __m128i operator()(const __m128i pixels) const
+	{
+		// (13933 * r + 46871 * g + 4732 * b) >> 16 using signed 16-bit multiply-add: red and blue in one lane pair, green (twice) in another with its weight split in two
+		const __m128i redBlue{ _mm_and_si128(pixels, _mm_set1_epi32(0x00FF00FF)) };
+		const __m128i green{ _mm_and_si128(_mm_srli_epi32(pixels, 8), _mm_set1_epi32(0xFF)) };
+		const __m128i greenGreen{ _mm_or_si128(green, _mm_slli_epi32(green, 16)) };
+		const __m128i sum{ _mm_add_epi32(_mm_madd_epi16(redBlue, _mm_set1_epi32(13933 | (4732 << 16))), _mm_madd_epi16(greenGreen, _mm_set1_epi32(23436 | (23435 << 16)))) };
+		return sse2GrayWithAlpha(_mm_srli_epi32(sum, 16), pixels, andMask, orMask);
+	}
+};
+
+struct Sse2Average : Sse2Gray
+{
+	using Sse2Gray::Sse2Gray;
+	PLINTH_IMAGE_SIMD_TARGET("sse2") __m128i operator()(const __m128i pixels) const
+	{
+		// (r + g + b) / 3 as ((r + g + b) * 43691) >> 17, which is exact for sums up to 765. the multiplier is split in two for the signed 16-bit multiply-add
+		const __m128i redBlue{ _mm_and_si128(pixels, _mm_set1_epi32(0x00FF00FF)) };
+		const __m128i green{ _mm_and_si128(_mm_srli_epi32(pixels, 8), _mm_set1_epi32(0xFF)) };
+		const __m128i sum{ _mm_madd_epi16(_mm_add_epi16(redBlue, green), _mm_set1_epi16(1)) };
+		const __m128i sumSum{ _mm_or_si128(sum, _mm_slli_epi32(sum, 16)) };
+		return sse2GrayWithAlpha(_mm_srli_epi32(_mm_madd_epi16(sumSum, _mm_set1_epi32(21846 | (21845 << 16))), 17), pixels, andMask, orMask);
+	}
+};
+
+struct Sse2Lightness : Sse2Gray
+{
+	using Sse2Gray::Sse2Gray;
+	PLINTH_IMAGE_SIMD_TARGET("sse2") __m128i operator()(const __m128i pixels) const
+	{
+		// lowest byte of each pixel is compared with green and blue shifted into it
+		const __m128i green{ _mm_srli_epi32(pixels, 8) };
+		const __m128i blue{ _mm_srli_epi32(pixels, 16) };
+		const __m128i byteMask{ _mm_set1_epi32(0xFF) };
+		const __m128i highest{ _mm_and_si128(_mm_max_epu8(_mm_max_epu8(pixels, green), blue), byteMask) };
+		const __m128i lowest{ _mm_and_si128(_mm_min_epu8(_mm_min_epu8(pixels, green), blue), byteMask) };
+		return sse2GrayWithAlpha(_mm_srli_epi32(_mm_add_epi32(highest, lowest), 1), pixels, andMask, orMask);
+	}
+};
+
+struct Sse2Median : Sse2Gray
+{
+	using Sse2Gray::Sse2Gray;
+	PLINTH_IMAGE_SIMD_TARGET("sse2") __m128i operator()(const __m128i pixels) const
+	{
+		// median = max(min(r, g), min(max(r, g), b))
+		const __m128i green{ _mm_srli_epi32(pixels, 8) };
+		const __m128i blue{ _mm_srli_epi32(pixels, 16) };
+		const __m128i median{ _mm_max_epu8(_mm_min_epu8(pixels, green), _mm_min_epu8(_mm_max_epu8(pixels, green), blue)) };
+		return sse2GrayWithAlpha(_mm_and_si128(median, _mm_set1_epi32(0xFF)), pixels, andMask, orMask);
+	}
+};
+
+struct Sse2Premultiply
+{
+	PLINTH_IMAGE_SIMD_TARGET("sse2") explicit Sse2Premultiply(const Parameters&)
+	{
+	}
+	PLINTH_IMAGE_SIMD_TARGET("sse2") __m128i operator()(const __m128i pixels) const
+	{
+		// (v + (v >> 8)) >> 8 where v = component x alpha + 128 is the exactly rounded division by 255. red and blue share one 16-bit multiply
+		const __m128i alpha{ _mm_srli_epi32(pixels, 24) };
+		const __m128i alphaAlpha{ _mm_or_si128(alpha, _mm_slli_epi32(alpha, 16)) };
+		const __m128i half{ _mm_set1_epi16(128) };
+		__m128i redBlue{ _mm_add_epi16(_mm_mullo_epi16(_mm_and_si128(pixels, _mm_set1_epi32(0x00FF00FF)), alphaAlpha), half) };
+		redBlue = _mm_srli_epi16(_mm_add_epi16(redBlue, _mm_srli_epi16(redBlue, 8)), 8);
+		__m128i green{ _mm_add_epi16(_mm_mullo_epi16(_mm_and_si128(_mm_srli_epi32(pixels, 8), _mm_set1_epi32(0xFF)), alphaAlpha), half) };
+		green = _mm_and_si128(_mm_add_epi16(green, _mm_srli_epi16(green, 8)), _mm_set1_epi32(0xFF00));
+		return _mm_or_si128(_mm_or_si128(redBlue, green), _mm_and_si128(pixels, _mm_set1_epi32(static_cast<int>(0xFF000000u))));
+	}
+};
+
+PLINTH_IMAGE_SIMD_TARGET("sse2") inline __m128i sse2Unpremultiply(const __m128i components, const __m128 rounding, const __m128 alpha)
+{
+	// the float division is exact enough that truncating it gives the integer division
+	const __m128 numerator{ _mm_add_ps(_mm_mul_ps(_mm_cvtepi32_ps(components), _mm_set1_ps(255.f)), rounding) };
+	return _mm_cvttps_epi32(_mm_min_ps(_mm_div_ps(numerator, alpha), _mm_set1_ps(255.f)));
+}
+
+struct Sse2Unpremultiply
+{
+	PLINTH_IMAGE_SIMD_TARGET("sse2") explicit Sse2Unpremultiply(const Parameters&)
+	{
+	}
+	PLINTH_IMAGE_SIMD_TARGET("sse2") __m128i operator()(const __m128i pixels) const
+	{
+		// division by zero alpha gives infinity or NaN, which the minimum turns into 255, and the pixel is then cleared to zero
+		const __m128i byteMask{ _mm_set1_epi32(0xFF) };
+		const __m128i alphaBits{ _mm_srli_epi32(pixels, 24) };
+		const __m128 alpha{ _mm_cvtepi32_ps(alphaBits) };
+		const __m128 rounding{ _mm_cvtepi32_ps(_mm_srli_epi32(alphaBits, 1)) };
+		const __m128i red{ sse2Unpremultiply(_mm_and_si128(pixels, byteMask), rounding, alpha) };
+		const __m128i green{ sse2Unpremultiply(_mm_and_si128(_mm_srli_epi32(pixels, 8), byteMask), rounding, alpha) };
+		const __m128i blue{ sse2Unpremultiply(_mm_and_si128(_mm_srli_epi32(pixels, 16), byteMask), rounding, alpha) };
+		const __m128i result{ _mm_or_si128(_mm_or_si128(red, _mm_slli_epi32(green, 8)), _mm_or_si128(_mm_slli_epi32(blue, 16), _mm_slli_epi32(alphaBits, 24))) };
+		return _mm_andnot_si128(_mm_cmpeq_epi32(alphaBits, _mm_setzero_si128()), result);
+	}
+};
+
+template <class OperationT>
+PLINTH_IMAGE_SIMD_TARGET("sse2") inline std::size_t processSse2(std::uint8_t* const pixels, const std::size_t numberOfPixels, const Parameters& parameters)
+{
+	const OperationT operation{ parameters };
+	std::size_t i{ 0_uz };
+	for (; (i + 4_uz) <= numberOfPixels; i += 4_uz)
+	{
+		__m128i* const block{ reinterpret_cast<__m128i*>(pixels + (i * 4_uz)) };
+		_mm_storeu_si128(block, operation(_mm_loadu_si128(block)));
+	}
+	return i;
+}
+
+template <class OperationT>
+PLINTH_IMAGE_SIMD_TARGET("sse2") inline std::size_t extractSse2(const std::uint8_t* const pixels, std::uint8_t* const values, const std::size_t numberOfPixels, const Parameters& parameters)
+{
+	// 16 pixels to 16 values. the gray operations leave the value in the lowest byte of each pixel
+	const OperationT operation{ parameters };
+	const __m128i lowestByte{ _mm_set1_epi32(0xFF) };
+	std::size_t i{ 0_uz };
+	for (; (i + 16_uz) <= numberOfPixels; i += 16_uz)
+	{
+		const __m128i* const block{ reinterpret_cast<const __m128i*>(pixels + (i * 4_uz)) };
+		const __m128i a{ _mm_and_si128(operation(_mm_loadu_si128(block)), lowestByte) };
+		const __m128i b{ _mm_and_si128(operation(_mm_loadu_si128(block + 1)), lowestByte) };
+		const __m128i c{ _mm_and_si128(operation(_mm_loadu_si128(block + 2)), lowestByte) };
+		const __m128i d{ _mm_and_si128(operation(_mm_loadu_si128(block + 3)), lowestByte) };
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(values + i), _mm_packus_epi16(_mm_packs_epi32(a, b), _mm_packs_epi32(c, d)));
+	}
+	return i;
+}
+
+PLINTH_IMAGE_SIMD_TARGET("sse2") inline __m128i sse2InsertValues(const __m128i pixels, const __m128i values, const __m128i andMask, const __m128i orMask, const __m128i shift, const bool isReplicated)
+{
+	// values are in the lowest byte of each 32-bit lane
+	__m128i spread{ _mm_sll_epi32(values, shift) };
+	if (isReplicated)
+		spread = _mm_or_si128(values, _mm_or_si128(_mm_slli_epi32(values, 8), _mm_slli_epi32(values, 16)));
+	return _mm_or_si128(_mm_or_si128(_mm_and_si128(pixels, andMask), orMask), spread);
+}
+
+PLINTH_IMAGE_SIMD_TARGET("sse2") inline std::size_t insertSse2(std::uint8_t* const pixels, const std::uint8_t* const values, const std::size_t numberOfPixels, const Parameters& parameters, const bool isReplicated)
+{
+	// 16 values to 16 pixels
+	const __m128i andMask{ _mm_set1_epi32(static_cast<int>(parameters.andMask)) };
+	const __m128i orMask{ _mm_set1_epi32(static_cast<int>(parameters.orMask)) };
+	const __m128i shift{ _mm_cvtsi32_si128(static_cast<int>(parameters.shift)) };
+	const __m128i zero{ _mm_setzero_si128() };
+	std::size_t i{ 0_uz };
+	for (; (i + 16_uz) <= numberOfPixels; i += 16_uz)
+	{
+		const __m128i bytes{ _mm_loadu_si128(reinterpret_cast<const __m128i*>(values + i)) };
+		const __m128i low{ _mm_unpacklo_epi8(bytes, zero) };
+		const __m128i high{ _mm_unpackhi_epi8(bytes, zero) };
+		const __m128i words[4u]{ _mm_unpacklo_epi16(low, zero), _mm_unpackhi_epi16(low, zero), _mm_unpacklo_epi16(high, zero), _mm_unpackhi_epi16(high, zero) };
+		__m128i* const block{ reinterpret_cast<__m128i*>(pixels + (i * 4_uz)) };
+		for (std::size_t j{ 0_uz }; j < 4_uz; ++j)
+			_mm_storeu_si128(block + j, sse2InsertValues(_mm_loadu_si128(block + j), words[j], andMask, orMask, shift, isReplicated));
+	}
+	return i;
+}
+
+PLINTH_IMAGE_SIMD_TARGET("sse2") inline __m128i sse2DownsampleBox(const __m128i upper, const __m128i lower)
+{
+	// 4 pixels from each row to 2 pixels as 16-bit sums
+	const __m128i zero{ _mm_setzero_si128() };
+	const __m128i left{ _mm_add_epi16(_mm_unpacklo_epi8(upper, zero), _mm_unpacklo_epi8(lower, zero)) }; // pixels 0 and 1
+	const __m128i right{ _mm_add_epi16(_mm_unpackhi_epi8(upper, zero), _mm_unpackhi_epi8(lower, zero)) }; // pixels 2 and 3
+	return _mm_add_epi16(_mm_unpacklo_epi64(left, right), _mm_unpackhi_epi64(left, right));
+}
+
+PLINTH_IMAGE_SIMD_TARGET("sse2") inline std::size_t downsampleBoxSse2(const std::uint8_t* const upperRow, const std::uint8_t* const lowerRow, std::uint8_t* const destination, const std::size_t numberOfDestinationPixels)
+{
+	const __m128i two{ _mm_set1_epi16(2) };
+	std::size_t i{ 0_uz };
+	for (; (i + 4_uz) <= numberOfDestinationPixels; i += 4_uz)
+	{
+		const std::size_t source{ i * 8_uz };
+		const __m128i first{ sse2DownsampleBox(_mm_loadu_si128(reinterpret_cast<const __m128i*>(upperRow + source)), _mm_loadu_si128(reinterpret_cast<const __m128i*>(lowerRow + source))) };
+		const __m128i second{ sse2DownsampleBox(_mm_loadu_si128(reinterpret_cast<const __m128i*>(upperRow + source + 16_uz)), _mm_loadu_si128(reinterpret_cast<const __m128i*>(lowerRow + source + 16_uz))) };
+		const __m128i result{ _mm_packus_epi16(_mm_srli_epi16(_mm_add_epi16(first, two), 2), _mm_srli_epi16(_mm_add_epi16(second, two), 2)) };
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(destination + (i * 4_uz)), result);
+	}
+	return i;
+}
+
+// filters: a value multiplied by a 32-bit weight is split into value x (weight & 127) + (value << 7) x (weight >> 7) so that both pairs of factors fit in 16 bits for a multiply-add
+
+PLINTH_IMAGE_SIMD_TARGET("sse2") inline __m128i sse2WeightPair(const std::int32_t weight)
+{
+	return _mm_set1_epi32(static_cast<int>((static_cast<std::uint32_t>(weight >> 7) << 16u) | (static_cast<std::uint32_t>(weight) & 127u)));
+}
+
+PLINTH_IMAGE_SIMD_TARGET("sse2") inline __m128i sse2ValuePair(const __m128i values)
+{
+	// 32-bit values (less than 256) to value | (value << 7) << 16
+	return _mm_or_si128(values, _mm_slli_epi32(values, 23));
+}
+
+PLINTH_IMAGE_SIMD_TARGET("sse2") inline std::size_t accumulateWeightedSse2(const std::uint8_t* const values, std::int32_t* const accumulators, const std::size_t numberOfValues, const std::int32_t weight)
+{
+	const __m128i zero{ _mm_setzero_si128() };
+	const __m128i weights{ sse2WeightPair(weight) };
+	std::size_t i{ 0_uz };
+	for (; (i + 16_uz) <= numberOfValues; i += 16_uz)
+	{
+		const __m128i bytes{ _mm_loadu_si128(reinterpret_cast<const __m128i*>(values + i)) };
+		const __m128i low{ _mm_unpacklo_epi8(bytes, zero) };
+		const __m128i high{ _mm_unpackhi_epi8(bytes, zero) };
+		const __m128i words[4]{ _mm_unpacklo_epi16(low, zero), _mm_unpackhi_epi16(low, zero), _mm_unpacklo_epi16(high, zero), _mm_unpackhi_epi16(high, zero) };
+		__m128i* const accumulator{ reinterpret_cast<__m128i*>(accumulators + i) };
+		for (std::size_t w{ 0_uz }; w < 4_uz; ++w)
+			_mm_storeu_si128(accumulator + w, _mm_add_epi32(_mm_loadu_si128(accumulator + w), _mm_madd_epi16(sse2ValuePair(words[w]), weights)));
+	}
+	return i;
+}
+
+PLINTH_IMAGE_SIMD_TARGET("sse2") inline __m128i sse2Narrow(const __m128i first, const __m128i second, const __m128i third, const __m128i fourth)
+{
+	// 32-bit (with values that fit in 16 bits) to 8-bit, clamped
+	return _mm_packus_epi16(_mm_packs_epi32(first, second), _mm_packs_epi32(third, fourth));
+}
+
+PLINTH_IMAGE_SIMD_TARGET("sse2") inline std::size_t narrowSse2(const std::int32_t* const accumulators, std::uint8_t* const values, const std::size_t numberOfValues, const unsigned int shift)
+{
+	const __m128i shiftCount{ _mm_cvtsi32_si128(static_cast<int>(shift)) };
+	std::size_t i{ 0_uz };
+	for (; (i + 16_uz) <= numberOfValues; i += 16_uz)
+	{
+		const __m128i* const accumulator{ reinterpret_cast<const __m128i*>(accumulators + i) };
+		__m128i words[4];
+		for (std::size_t w{ 0_uz }; w < 4_uz; ++w)
+			words[w] = _mm_sra_epi32(_mm_loadu_si128(accumulator + w), shiftCount);
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(values + i), sse2Narrow(words[0], words[1], words[2], words[3]));
+	}
+	return i;
+}
+
+PLINTH_IMAGE_SIMD_TARGET("sse2") inline std::size_t slideBoxSse2(std::uint32_t* const sums, const std::uint8_t* const entering, const std::uint8_t* const leaving, std::uint8_t* const values, const std::size_t numberOfValues, const std::uint32_t half, const std::uint32_t reciprocal, const unsigned int shift)
+{
+	const __m128i zero{ _mm_setzero_si128() };
+	const __m128i halves{ _mm_set1_epi32(static_cast<int>(half)) };
+	const __m128i reciprocals{ _mm_set1_epi32(static_cast<int>(reciprocal)) };
+	const __m128i shiftCount{ _mm_cvtsi32_si128(static_cast<int>(shift)) };
+	std::size_t i{ 0_uz };
+	for (; (i + 16_uz) <= numberOfValues; i += 16_uz)
+	{
+		const __m128i enteringBytes{ _mm_loadu_si128(reinterpret_cast<const __m128i*>(entering + i)) };
+		const __m128i leavingBytes{ _mm_loadu_si128(reinterpret_cast<const __m128i*>(leaving + i)) };
+		const __m128i enteringLow{ _mm_unpacklo_epi8(enteringBytes, zero) };
+		const __m128i enteringHigh{ _mm_unpackhi_epi8(enteringBytes, zero) };
+		const __m128i leavingLow{ _mm_unpacklo_epi8(leavingBytes, zero) };
+		const __m128i leavingHigh{ _mm_unpackhi_epi8(leavingBytes, zero) };
+		const __m128i differences[4]
+		{
+			_mm_sub_epi32(_mm_unpacklo_epi16(enteringLow, zero), _mm_unpacklo_epi16(leavingLow, zero)),
+			_mm_sub_epi32(_mm_unpackhi_epi16(enteringLow, zero), _mm_unpackhi_epi16(leavingLow, zero)),
+			_mm_sub_epi32(_mm_unpacklo_epi16(enteringHigh, zero), _mm_unpacklo_epi16(leavingHigh, zero)),
+			_mm_sub_epi32(_mm_unpackhi_epi16(enteringHigh, zero), _mm_unpackhi_epi16(leavingHigh, zero))
+		};
+		__m128i* const sum{ reinterpret_cast<__m128i*>(sums + i) };
+		__m128i words[4];
+		for (std::size_t w{ 0_uz }; w < 4_uz; ++w)
+		{
+			const __m128i current{ _mm_loadu_si128(sum + w) };
+			const __m128i rounded{ _mm_add_epi32(current, halves) };
+			const __m128i even{ _mm_srl_epi64(_mm_mul_epu32(rounded, reciprocals), shiftCount) };
+			const __m128i odd{ _mm_srl_epi64(_mm_mul_epu32(_mm_srli_epi64(rounded, 32), reciprocals), shiftCount) };
+			words[w] = _mm_or_si128(even, _mm_slli_epi64(odd, 32));
+			_mm_storeu_si128(sum + w, _mm_add_epi32(current, differences[w]));
+		}
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(values + i), sse2Narrow(words[0], words[1], words[2], words[3]));
+	}
+	return i;
+}
+
+// AVX2: 8 pixels per vector. same operations as SSE2 (all are within 32-bit lanes so the 128-bit halves do not interact)
+
+PLINTH_IMAGE_SIMD_TARGET("avx2") inline __m256i avx2GrayWithAlpha(__m256i gray, const __m256i pixels, const __m256i andMask, const __m256i orMask)
+{
+	gray = _mm256_or_si256(gray, _mm256_slli_epi32(gray, 8));
+	gray = _mm256_or_si256(gray, _mm256_slli_epi32(gray, 8));
+	return _mm256_or_si256(gray, _mm256_or_si256(_mm256_and_si256(pixels, andMask), orMask));
+}
+
+struct Avx2Bitwise
+{
+	__m256i andMask;
+	__m256i orMask;
+	__m256i xorMask;
+	PLINTH_IMAGE_SIMD_TARGET("avx2") explicit Avx2Bitwise(const Parameters& parameters)
+		: andMask{ _mm256_set1_epi32(static_cast<int>(parameters.andMask)) }
+		, orMask{ _mm256_set1_epi32(static_cast<int>(parameters.orMask)) }
+		, xorMask{ _mm256_set1_epi32(static_cast<int>(parameters.xorMask)) }
+	{
+	}
+	PLINTH_IMAGE_SIMD_TARGET("avx2") __m256i operator()(const __m256i pixels) const
+	{
+		return _mm256_xor_si256(_mm256_or_si256(_mm256_and_si256(pixels, andMask), orMask), xorMask);
+	}
+};
+
+struct Avx2Gray
+{
+	__m256i andMask;
+	__m256i orMask;
+	PLINTH_IMAGE_SIMD_TARGET("avx2") explicit Avx2Gray(const Parameters& parameters)
+		: andMask{ _mm256_set1_epi32(static_cast<int>(parameters.andMask)) }
+		, orMask{ _mm256_set1_epi32(static_cast<int>(parameters.orMask)) }
+	{
+	}
+};
+
+struct Avx2ReplicateChannel : Avx2Gray
+{
+	__m128i shift;
+	PLINTH_IMAGE_SIMD_TARGET("avx2") explicit Avx2ReplicateChannel(const Parameters& parameters)
+		: Avx2Gray(parameters)
+		, shift{ _mm_cvtsi32_si128(static_cast<int>(parameters.shift)) }
+	{
+	}
+	PLINTH_IMAGE_SIMD_TARGET("avx2") __m256i operator()(const __m256i pixels) const
+	{
+		return avx2GrayWithAlpha(_mm256_and_si256(_mm256_srl_epi32(pixels, shift), _mm256_set1_epi32(0xFF)), pixels, andMask, orMask);
+	}
+};
+
+struct Avx2Luminosity : Avx2Gray
+{
+	using Avx2Gray::Avx2Gray;
+	PLINTH_IMAGE_SIMD_TARGET("avx2") __m256i operator()(const __m256i pixels) const
+	{
+		const __m256i redBlue{ _mm256_and_si256(pixels, _mm256_set1_epi32(0x00FF00FF)) };
+		const __m256i green{ _mm256_and_si256(_mm256_srli_epi32(pixels, 8), _mm256_set1_epi32(0xFF)) };
+		const __m256i greenGreen{ _mm256_or_si256(green, _mm256_slli_epi32(green, 16)) };
+		const __m256i sum{ _mm256_add_epi32(_mm256_madd_epi16(redBlue, _mm256_set1_epi32(13933 | (4732 << 16))), _mm256_madd_epi16(greenGreen, _mm256_set1_epi32(23436 | (23435 << 16)))) };
+		return avx2GrayWithAlpha(_mm256_srli_epi32(sum, 16), pixels, andMask, orMask);
+	}
+};
+
+struct Avx2Average : Avx2Gray
+{
+	using Avx2Gray::Avx2Gray;
+	PLINTH_IMAGE_SIMD_TARGET("avx2") __m256i operator()(const __m256i pixels) const
+	{
+		const __m256i redBlue{ _mm256_and_si256(pixels, _mm256_set1_epi32(0x00FF00FF)) };
+		const __m256i green{ _mm256_and_si256(_mm256_srli_epi32(pixels, 8), _mm256_set1_epi32(0xFF)) };
+		const __m256i sum{ _mm256_madd_epi16(_mm256_add_epi16(redBlue, green), _mm256_set1_epi16(1)) };
+		const __m256i sumSum{ _mm256_or_si256(sum, _mm256_slli_epi32(sum, 16)) };
+		return avx2GrayWithAlpha(_mm256_srli_epi32(_mm256_madd_epi16(sumSum, _mm256_set1_epi32(21846 | (21845 << 16))), 17), pixels, andMask, orMask);
+	}
+};
+
+struct Avx2Lightness : Avx2Gray
+{
+	using Avx2Gray::Avx2Gray;
+	PLINTH_IMAGE_SIMD_TARGET("avx2") __m256i operator()(const __m256i pixels) const
+	{
+		const __m256i green{ _mm256_srli_epi32(pixels, 8) };
+		const __m256i blue{ _mm256_srli_epi32(pixels, 16) };
+		const __m256i byteMask{ _mm256_set1_epi32(0xFF) };
+		const __m256i highest{ _mm256_and_si256(_mm256_max_epu8(_mm256_max_epu8(pixels, green), blue), byteMask) };
+		const __m256i lowest{ _mm256_and_si256(_mm256_min_epu8(_mm256_min_epu8(pixels, green), blue), byteMask) };
+		return avx2GrayWithAlpha(_mm256_srli_epi32(_mm256_add_epi32(highest, lowest), 1), pixels, andMask, orMask);
+	}
+};
+
+struct Avx2Median : Avx2Gray
+{
+	using Avx2Gray::Avx2Gray;
+	PLINTH_IMAGE_SIMD_TARGET("avx2") __m256i operator()(const __m256i pixels) const
+	{
+		const __m256i green{ _mm256_srli_epi32(pixels, 8) };
+		const __m256i blue{ _mm256_srli_epi32(pixels, 16) };
+		const __m256i median{ _mm256_max_epu8(_mm256_min_epu8(pixels, green), _mm256_min_epu8(_mm256_max_epu8(pixels, green), blue)) };
+		return avx2GrayWithAlpha(_mm256_and_si256(median, _mm256_set1_epi32(0xFF)), pixels, andMask, orMask);
+	}
+};
+
+struct Avx2Premultiply
+{
+	PLINTH_IMAGE_SIMD_TARGET("avx2") explicit Avx2Premultiply(const Parameters&)
+	{
+	}
+	PLINTH_IMAGE_SIMD_TARGET("avx2") __m256i operator()(const __m256i pixels) const
+	{
+		const __m256i alpha{ _mm256_srli_epi32(pixels, 24) };
+		const __m256i alphaAlpha{ _mm256_or_si256(alpha, _mm256_slli_epi32(alpha, 16)) };
+		const __m256i half{ _mm256_set1_epi16(128) };
+		__m256i redBlue{ _mm256_add_epi16(_mm256_mullo_epi16(_mm256_and_si256(pixels, _mm256_set1_epi32(0x00FF00FF)), alphaAlpha), half) };
+		redBlue = _mm256_srli_epi16(_mm256_add_epi16(redBlue, _mm256_srli_epi16(redBlue, 8)), 8);
+		__m256i green{ _mm256_add_epi16(_mm256_mullo_epi16(_mm256_and_si256(_mm256_srli_epi32(pixels, 8), _mm256_set1_epi32(0xFF)), alphaAlpha), half) };
+		green = _mm256_and_si256(_mm256_add_epi16(green, _mm256_srli_epi16(green, 8)), _mm256_set1_epi32(0xFF00));
+		return _mm256_or_si256(_mm256_or_si256(redBlue, green), _mm256_and_si256(pixels, _mm256_set1_epi32(static_cast<int>(0xFF000000u))));
+	}
+};
+
+PLINTH_IMAGE_SIMD_TARGET("avx2") inline __m256i avx2Unpremultiply(const __m256i components, const __m256 rounding, const __m256 alpha)
+{
+	const __m256 numerator{ _mm256_add_ps(_mm256_mul_ps(_mm256_cvtepi32_ps(components), _mm256_set1_ps(255.f)), rounding) };
+	return _mm256_cvttps_epi32(_mm256_min_ps(_mm256_div_ps(numerator, alpha), _mm256_set1_ps(255.f)));
+}
+
+struct Avx2Unpremultiply
+{
+	PLINTH_IMAGE_SIMD_TARGET("avx2") explicit Avx2Unpremultiply(const Parameters&)
+	{
+	}
+	PLINTH_IMAGE_SIMD_TARGET("avx2") __m256i operator()(const __m256i pixels) const
+	{
+		const __m256i byteMask{ _mm256_set1_epi32(0xFF) };
+		const __m256i alphaBits{ _mm256_srli_epi32(pixels, 24) };
+		const __m256 alpha{ _mm256_cvtepi32_ps(alphaBits) };
+		const __m256 rounding{ _mm256_cvtepi32_ps(_mm256_srli_epi32(alphaBits, 1)) };
+		const __m256i red{ avx2Unpremultiply(_mm256_and_si256(pixels, byteMask), rounding, alpha) };
+		const __m256i green{ avx2Unpremultiply(_mm256_and_si256(_mm256_srli_epi32(pixels, 8), byteMask), rounding, alpha) };
+		const __m256i blue{ avx2Unpremultiply(_mm256_and_si256(_mm256_srli_epi32(pixels, 16), byteMask), rounding, alpha) };
+		const __m256i result{ _mm256_or_si256(_mm256_or_si256(red, _mm256_slli_epi32(green, 8)), _mm256_or_si256(_mm256_slli_epi32(blue, 16), _mm256_slli_epi32(alphaBits, 24))) };
+		return _mm256_andnot_si256(_mm256_cmpeq_epi32(alphaBits, _mm256_setzero_si256()), result);
+	}
+};
+
+template <class OperationT>
+PLINTH_IMAGE_SIMD_TARGET("avx2") inline std::size_t processAvx2(std::uint8_t* const pixels, const std::size_t numberOfPixels, const Parameters& parameters)
+{
+	const OperationT operation{ parameters };
+	std::size_t i{ 0_uz };
+	for (; (i + 8_uz) <= numberOfPixels; i += 8_uz)
+	{
+		__m256i* const block{ reinterpret_cast<__m256i*>(pixels + (i * 4_uz)) };
+		_mm256_storeu_si256(block, operation(_mm256_loadu_si256(block)));
+	}
+	return i;
+}
+
+template <class OperationT>
+PLINTH_IMAGE_SIMD_TARGET("avx2") inline std::size_t extractAvx2(const std::uint8_t* const pixels, std::uint8_t* const values, const std::size_t numberOfPixels, const Parameters& parameters)
+{
+	// 32 pixels to 32 values
+	const OperationT operation{ parameters };
+	const __m256i lowestByte{ _mm256_set1_epi32(0xFF) };
+	const __m256i order{ _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7) };
+	std::size_t i{ 0_uz };
+	for (; (i + 32_uz) <= numberOfPixels; i += 32_uz)
+	{
+		const __m256i* const block{ reinterpret_cast<const __m256i*>(pixels + (i * 4_uz)) };
+		const __m256i a{ _mm256_and_si256(operation(_mm256_loadu_si256(block)), lowestByte) };
+		const __m256i b{ _mm256_and_si256(operation(_mm256_loadu_si256(block + 1)), lowestByte) };
+		const __m256i c{ _mm256_and_si256(operation(_mm256_loadu_si256(block + 2)), lowestByte) };
+		const __m256i d{ _mm256_and_si256(operation(_mm256_loadu_si256(block + 3)), lowestByte) };
+		// packing is within halves so groups of 4 values are in the order a b c d (low halves) then a b c d (high halves)
+		const __m256i packed{ _mm256_packus_epi16(_mm256_packs_epi32(a, b), _mm256_packs_epi32(c, d)) };
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(values + i), _mm256_permutevar8x32_epi32(packed, order));
+	}
+	return i;
+}
+
+PLINTH_IMAGE_SIMD_TARGET("avx2") inline std::size_t insertAvx2(std::uint8_t* const pixels, const std::uint8_t* const values, const std::size_t numberOfPixels, const Parameters& parameters, const bool isReplicated)
+{
+	// 8 values to 8 pixels
+	const __m256i andMask{ _mm256_set1_epi32(static_cast<int>(parameters.andMask)) };
+	const __m256i orMask{ _mm256_set1_epi32(static_cast<int>(parameters.orMask)) };
+	const __m128i shift{ _mm_cvtsi32_si128(static_cast<int>(parameters.shift)) };
+	std::size_t i{ 0_uz };
+	for (; (i + 8_uz) <= numberOfPixels; i += 8_uz)
+	{
+		const __m256i words{ _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(values + i))) };
+		__m256i spread{ _mm256_sll_epi32(words, shift) };
+		if (isReplicated)
+			spread = _mm256_or_si256(words, _mm256_or_si256(_mm256_slli_epi32(words, 8), _mm256_slli_epi32(words, 16)));
+		__m256i* const block{ reinterpret_cast<__m256i*>(pixels + (i * 4_uz)) };
+		_mm256_storeu_si256(block, _mm256_or_si256(_mm256_or_si256(_mm256_and_si256(_mm256_loadu_si256(block), andMask), orMask), spread));
+	}
+	return i;
+}
+
+PLINTH_IMAGE_SIMD_TARGET("avx2") inline __m256i avx2DownsampleBox(const __m256i upper, const __m256i lower)
+{
+	// same as SSE2 within each 128-bit half so the results are in order within each half
+	const __m256i zero{ _mm256_setzero_si256() };
+	const __m256i left{ _mm256_add_epi16(_mm256_unpacklo_epi8(upper, zero), _mm256_unpacklo_epi8(lower, zero)) };
+	const __m256i right{ _mm256_add_epi16(_mm256_unpackhi_epi8(upper, zero), _mm256_unpackhi_epi8(lower, zero)) };
+	return _mm256_add_epi16(_mm256_unpacklo_epi64(left, right), _mm256_unpackhi_epi64(left, right));
+}
+
+PLINTH_IMAGE_SIMD_TARGET("avx2") inline std::size_t downsampleBoxAvx2(const std::uint8_t* const upperRow, const std::uint8_t* const lowerRow, std::uint8_t* const destination, const std::size_t numberOfDestinationPixels)
+{
+	const __m256i two{ _mm256_set1_epi16(2) };
+	std::size_t i{ 0_uz };
+	for (; (i + 8_uz) <= numberOfDestinationPixels; i += 8_uz)
+	{
+		const std::size_t source{ i * 8_uz };
+		const __m256i first{ avx2DownsampleBox(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(upperRow + source)), _mm256_loadu_si256(reinterpret_cast<const __m256i*>(lowerRow + source))) };
+		const __m256i second{ avx2DownsampleBox(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(upperRow + source + 32_uz)), _mm256_loadu_si256(reinterpret_cast<const __m256i*>(lowerRow + source + 32_uz))) };
+		const __m256i packed{ _mm256_packus_epi16(_mm256_srli_epi16(_mm256_add_epi16(first, two), 2), _mm256_srli_epi16(_mm256_add_epi16(second, two), 2)) };
+		// packing is within halves (0 1 4 5 | 2 3 6 7) so the 64-bit pairs are reordered
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(destination + (i * 4_uz)), _mm256_permute4x64_epi64(packed, 0xD8));
+	}
+	return i;
+}
+
+PLINTH_IMAGE_SIMD_TARGET("avx2") inline std::size_t accumulateWeightedAvx2(const std::uint8_t* const values, std::int32_t* const accumulators, const std::size_t numberOfValues, const std::int32_t weight)
+{
+	// values are widened in order (8 at a time) so no reordering is needed
+	const __m256i weights{ _mm256_set1_epi32(static_cast<int>((static_cast<std::uint32_t>(weight >> 7) << 16u) | (static_cast<std::uint32_t>(weight) & 127u))) };
+	std::size_t i{ 0_uz };
+	for (; (i + 32_uz) <= numberOfValues; i += 32_uz)
+	{
+		__m256i* const accumulator{ reinterpret_cast<__m256i*>(accumulators + i) };
+		for (std::size_t w{ 0_uz }; w < 4_uz; ++w)
+		{
+			const __m256i words{ _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(values + i + (w * 8_uz)))) };
+			const __m256i pairs{ _mm256_or_si256(words, _mm256_slli_epi32(words, 23)) };
+			_mm256_storeu_si256(accumulator + w, _mm256_add_epi32(_mm256_loadu_si256(accumulator + w), _mm256_madd_epi16(pairs, weights)));
+		}
+	}
+	return i;
+}
+
+PLINTH_IMAGE_SIMD_TARGET("avx2") inline __m256i avx2Narrow(const __m256i first, const __m256i second, const __m256i third, const __m256i fourth)
+{
+	// packing is within halves (32-bit groups in order 0 2 4 6 1 3 5 7) so the groups are reordered
+	const __m256i packed{ _mm256_packus_epi16(_mm256_packs_epi32(first, second), _mm256_packs_epi32(third, fourth)) };
+	return _mm256_permutevar8x32_epi32(packed, _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7));
+}
+
+PLINTH_IMAGE_SIMD_TARGET("avx2") inline std::size_t narrowAvx2(const std::int32_t* const accumulators, std::uint8_t* const values, const std::size_t numberOfValues, const unsigned int shift)
+{
+	const __m128i shiftCount{ _mm_cvtsi32_si128(static_cast<int>(shift)) };
+	std::size_t i{ 0_uz };
+	for (; (i + 32_uz) <= numberOfValues; i += 32_uz)
+	{
+		const __m256i* const accumulator{ reinterpret_cast<const __m256i*>(accumulators + i) };
+		__m256i words[4];
+		for (std::size_t w{ 0_uz }; w < 4_uz; ++w)
+			words[w] = _mm256_sra_epi32(_mm256_loadu_si256(accumulator + w), shiftCount);
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(values + i), avx2Narrow(words[0], words[1], words[2], words[3]));
+	}
+	return i;
+}
+
+PLINTH_IMAGE_SIMD_TARGET("avx2") inline std::size_t slideBoxAvx2(std::uint32_t* const sums, const std::uint8_t* const entering, const std::uint8_t* const leaving, std::uint8_t* const values, const std::size_t numberOfValues, const std::uint32_t half, const std::uint32_t reciprocal, const unsigned int shift)
+{
+	const __m256i halves{ _mm256_set1_epi32(static_cast<int>(half)) };
+	const __m256i reciprocals{ _mm256_set1_epi32(static_cast<int>(reciprocal)) };
+	const __m128i shiftCount{ _mm_cvtsi32_si128(static_cast<int>(shift)) };
+	std::size_t i{ 0_uz };
+	for (; (i + 32_uz) <= numberOfValues; i += 32_uz)
+	{
+		__m256i* const sum{ reinterpret_cast<__m256i*>(sums + i) };
+		__m256i words[4];
+		for (std::size_t w{ 0_uz }; w < 4_uz; ++w)
+		{
+			const std::size_t offset{ i + (w * 8_uz) };
+			const __m256i current{ _mm256_loadu_si256(sum + w) };
+			const __m256i rounded{ _mm256_add_epi32(current, halves) };
+			const __m256i even{ _mm256_srl_epi64(_mm256_mul_epu32(rounded, reciprocals), shiftCount) };
+			const __m256i odd{ _mm256_srl_epi64(_mm256_mul_epu32(_mm256_srli_epi64(rounded, 32), reciprocals), shiftCount) };
+			words[w] = _mm256_or_si256(even, _mm256_slli_epi64(odd, 32));
+			const __m256i difference{ _mm256_sub_epi32(_mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(entering + offset))), _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(leaving + offset)))) };
+			_mm256_storeu_si256(sum + w, _mm256_add_epi32(current, difference));
+		}
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(values + i), avx2Narrow(words[0], words[1], words[2], words[3]));
+	}
+	return i;
+}
+
+#endif // PLINTH_IMAGE_SIMD
+
+inline InstructionSet detectInstructionSet()
+{
+#ifdef PLINTH_IMAGE_SIMD
+#ifdef _MSC_VER
+	int info[4];
+	__cpuid(info, 0);
+	const int maximumLeaf{ info[0] };
+	__cpuid(info, 1);
+	const bool hasSse2{ (info[3] & (1 << 26)) != 0 };
+	const bool hasAvxWithOsSupport{ ((info[2] & (1 << 27)) != 0) && ((info[2] & (1 << 28)) != 0) && ((_xgetbv(0) & 6u) == 6u) }; // OSXSAVE and AVX, and the OS saves the vector registers
+	if (hasAvxWithOsSupport && (maximumLeaf >= 7))
+	{
+		__cpuidex(info, 7, 0);
+		if ((info[1] & (1 << 5)) != 0)
+			return InstructionSet::Avx2;
+	}
+	return hasSse2 ? InstructionSet::Sse2 : InstructionSet::Scalar;
+#else // _MSC_VER
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx2"))
+		return InstructionSet::Avx2;
+	if (__builtin_cpu_supports("sse2"))
+		return InstructionSet::Sse2;
+	return InstructionSet::Scalar;
+#endif // _MSC_VER
+#else // PLINTH_IMAGE_SIMD
+	return InstructionSet::Scalar;
+#endif // PLINTH_IMAGE_SIMD
+}
+
+inline std::size_t process(const Operation operation, std::uint8_t* const pixels, const std::size_t numberOfPixels, const Parameters& parameters)
+{
+#ifdef PLINTH_IMAGE_SIMD
+	switch (getInstructionSet())
+	{
+	case InstructionSet::Avx2:
+		switch (operation)
+		{
+		case Operation::Bitwise:
+			return processAvx2<Avx2Bitwise>(pixels, numberOfPixels, parameters);
+		case Operation::ReplicateChannel:
+			return processAvx2<Avx2ReplicateChannel>(pixels, numberOfPixels, parameters);
+		case Operation::Luminosity:
+			return processAvx2<Avx2Luminosity>(pixels, numberOfPixels, parameters);
+		case Operation::Average:
+			return processAvx2<Avx2Average>(pixels, numberOfPixels, parameters);
+		case Operation::Lightness:
+			return processAvx2<Avx2Lightness>(pixels, numberOfPixels, parameters);
+		case Operation::Median:
+			return processAvx2<Avx2Median>(pixels, numberOfPixels, parameters);
+		case Operation::Premultiply:
+			return processAvx2<Avx2Premultiply>(pixels, numberOfPixels, parameters);
+		case Operation::Unpremultiply:
+			return processAvx2<Avx2Unpremultiply>(pixels, numberOfPixels, parameters);
+		}
+		break;
+	case InstructionSet::Sse2:
+		switch (operation)
+		{
+		case Operation::Bitwise:
+			return processSse2<Sse2Bitwise>(pixels, numberOfPixels, parameters);
+		case Operation::ReplicateChannel:
+			return processSse2<Sse2ReplicateChannel>(pixels, numberOfPixels, parameters);
+		case Operation::Luminosity:
+			return processSse2<Sse2Luminosity>(pixels, numberOfPixels, parameters);
+		case Operation::Average:
+			return processSse2<Sse2Average>(pixels, numberOfPixels, parameters);
+		case Operation::Lightness:
+			return processSse2<Sse2Lightness>(pixels, numberOfPixels, parameters);
+		case Operation::Median:
+			return processSse2<Sse2Median>(pixels, numberOfPixels, parameters);
+		case Operation::Premultiply:
+			return processSse2<Sse2Premultiply>(pixels, numberOfPixels, parameters);
+		case Operation::Unpremultiply:
+			return processSse2<Sse2Unpremultiply>(pixels, numberOfPixels, parameters);
+		}
+		break;
+	case InstructionSet::Scalar:
+		break;
+	}
+#else // PLINTH_IMAGE_SIMD
+	static_cast<void>(operation);
+	static_cast<void>(pixels);
+	static_cast<void>(numberOfPixels);
+	static_cast<void>(parameters);
+#endif // PLINTH_IMAGE_SIMD
+	return 0_uz;
+}
+
+inline std::size_t extract(const Operation operation, const std::uint8_t* const pixels, std::uint8_t* const values, const std::size_t numberOfPixels, const Parameters& parameters)
+{
+#ifdef PLINTH_IMAGE_SIMD
+	switch (getInstructionSet())
+	{
+	case InstructionSet::Avx2:
+		if (operation == Operation::ReplicateChannel)
+			return extractAvx2<Avx2ReplicateChannel>(pixels, values, numberOfPixels, parameters);
+		if (operation == Operation::Average)
+			return extractAvx2<Avx2Average>(pixels, values, numberOfPixels, parameters);
+		break;
+	case InstructionSet::Sse2:
+		if (operation == Operation::ReplicateChannel)
+			return extractSse2<Sse2ReplicateChannel>(pixels, values, numberOfPixels, parameters);
+		if (operation == Operation::Average)
+			return extractSse2<Sse2Average>(pixels, values, numberOfPixels, parameters);
+		break;
+	case InstructionSet::Scalar:
+		break;
+	}
+#else // PLINTH_IMAGE_SIMD
+	static_cast<void>(operation);
+	static_cast<void>(pixels);
+	static_cast<void>(values);
+	static_cast<void>(numberOfPixels);
+	static_cast<void>(parameters);
+#endif // PLINTH_IMAGE_SIMD
+	return 0_uz;
+}
+
+inline std::size_t insert(std::uint8_t* const pixels, const std::uint8_t* const values, const std::size_t numberOfPixels, const Parameters& parameters, const bool isReplicated)
+{
+#ifdef PLINTH_IMAGE_SIMD
+	switch (getInstructionSet())
+	{
+	case InstructionSet::Avx2:
+		return insertAvx2(pixels, values, numberOfPixels, parameters, isReplicated);
+	case InstructionSet::Sse2:
+		return insertSse2(pixels, values, numberOfPixels, parameters, isReplicated);
+	case InstructionSet::Scalar:
+		break;
+	}
+#else // PLINTH_IMAGE_SIMD
+	static_cast<void>(pixels);
+	static_cast<void>(values);
+	static_cast<void>(numberOfPixels);
+	static_cast<void>(parameters);
+	static_cast<void>(isReplicated);
+#endif // PLINTH_IMAGE_SIMD
+	return 0_uz;
+}
+
+inline std::size_t downsampleBox(const std::uint8_t* const upperRow, const std::uint8_t* const lowerRow, std::uint8_t* const destination, const std::size_t numberOfDestinationPixels)
+{
+#ifdef PLINTH_IMAGE_SIMD
+	switch (getInstructionSet())
+	{
+	case InstructionSet::Avx2:
+		return downsampleBoxAvx2(upperRow, lowerRow, destination, numberOfDestinationPixels);
+	case InstructionSet::Sse2:
+		return downsampleBoxSse2(upperRow, lowerRow, destination, numberOfDestinationPixels);
+	case InstructionSet::Scalar:
+		break;
+	}
+#else // PLINTH_IMAGE_SIMD
+	static_cast<void>(upperRow);
+	static_cast<void>(lowerRow);
+	static_cast<void>(destination);
+	static_cast<void>(numberOfDestinationPixels);
+#endif // PLINTH_IMAGE_SIMD
+	return 0_uz;
+}
+
+inline std::size_t accumulateWeighted(const std::uint8_t* const values, std::int32_t* const accumulators, const std::size_t numberOfValues, const std::int32_t weight)
+{
+#ifdef PLINTH_IMAGE_SIMD
+	switch (getInstructionSet())
+	{
+	case InstructionSet::Avx2:
+		return accumulateWeightedAvx2(values, accumulators, numberOfValues, weight);
+	case InstructionSet::Sse2:
+		return accumulateWeightedSse2(values, accumulators, numberOfValues, weight);
+	case InstructionSet::Scalar:
+		break;
+	}
+#else // PLINTH_IMAGE_SIMD
+	static_cast<void>(values);
+	static_cast<void>(accumulators);
+	static_cast<void>(numberOfValues);
+	static_cast<void>(weight);
+#endif // PLINTH_IMAGE_SIMD
+	return 0_uz;
+}
+
+inline std::size_t narrow(const std::int32_t* const accumulators, std::uint8_t* const values, const std::size_t numberOfValues, const unsigned int shift)
+{
+#ifdef PLINTH_IMAGE_SIMD
+	switch (getInstructionSet())
+	{
+	case InstructionSet::Avx2:
+		return narrowAvx2(accumulators, values, numberOfValues, shift);
+	case InstructionSet::Sse2:
+		return narrowSse2(accumulators, values, numberOfValues, shift);
+	case InstructionSet::Scalar:
+		break;
+	}
+#else // PLINTH_IMAGE_SIMD
+	static_cast<void>(accumulators);
+	static_cast<void>(values);
+	static_cast<void>(numberOfValues);
+	static_cast<void>(shift);
+#endif // PLINTH_IMAGE_SIMD
+	return 0_uz;
+}
+
+inline std::size_t slideBox(std::uint32_t* const sums, const std::uint8_t* const entering, const std::uint8_t* const leaving, std::uint8_t* const values, const std::size_t numberOfValues, const std::uint32_t half, const std::uint32_t reciprocal, const unsigned int shift)
+{
+#ifdef PLINTH_IMAGE_SIMD
+	switch (getInstructionSet())
+	{
+	case InstructionSet::Avx2:
+		return slideBoxAvx2(sums, entering, leaving, values, numberOfValues, half, reciprocal, shift);
+	case InstructionSet::Sse2:
+		return slideBoxSse2(sums, entering, leaving, values, numberOfValues, half, reciprocal, shift);
+	case InstructionSet::Scalar:
+		break;
+	}
+#else // PLINTH_IMAGE_SIMD
+	static_cast<void>(sums);
+	static_cast<void>(entering);
+	static_cast<void>(leaving);
+	static_cast<void>(values);
+	static_cast<void>(numberOfValues);
+	static_cast<void>(half);
+	static_cast<void>(reciprocal);
+	static_cast<void>(shift);
+#endif // PLINTH_IMAGE_SIMD
+	return 0_uz;
+}
+
+			} // namespace simd
+		} // namespace impl
+
+inline void setMaximumInstructionSet(const InstructionSet instructionSet)
+{
+	impl::simd::maximumInstructionSet() = instructionSet;
+}
+
+inline InstructionSet getMaximumInstructionSet()
+{
+	return impl::simd::maximumInstructionSet();
+}
+
+inline InstructionSet getInstructionSet()
+{
+	static const InstructionSet detected{ impl::simd::detectInstructionSet() };
+	const InstructionSet maximum{ impl::simd::maximumInstructionSet() };
+	return (static_cast<int>(maximum) < static_cast<int>(detected)) ? maximum : detected;
+}
+
+	} // namespace Image
+} // namespace plinth
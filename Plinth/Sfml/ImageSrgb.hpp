@@ -0,0 +1,66 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// Plinth
+//
+// Copyright(c) 2014-2025 M.J.Silk
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions :
+//
+// 1. The origin of this software must not be misrepresented; you must not
+// claim that you wrote the original software.If you use this software
+// in a product, an acknowledgment in the product documentation would be
+// appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not be
+// misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+// M.J.Silk
+// MJSilk2@gmail.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+
+// REQUIRES C++11
+
+#pragma once
+
+#include "Common.hpp"
+#include <SFML/Graphics/Color.hpp>
+#include <array>
+#include <vector>
+#include <cstdint>
+
+namespace plinth
+{
+	namespace Image
+	{
+
+// sRGB transfer: conversion between sRGB-encoded components (as stored in images) and linear light
+// all conversions use lookup tables (built on first use) so there is no pow per component. alpha is never encoded so is not converted
+// linear light is either 16-bit (0 to 65535) or float (0 to 1)
+std::uint16_t srgbToLinear(std::uint8_t value);
+float srgbToLinearFloat(std::uint8_t value);
+std::uint8_t linearToSrgb(std::uint16_t value); // rounded to nearest
+std::uint8_t linearFloatToSrgb(float value); // clamped to 0-1 (NaN is 0). rounded to 16-bit linear then to nearest
+sf::Color colorFromLinear(float red, float green, float blue, std::uint8_t alpha = 255u);
+
+		namespace impl
+		{
+
+const std::array<std::uint16_t, 256u>& getSrgbToLinearTable();
+const std::array<float, 256u>& getSrgbToLinearFloatTable();
+const std::vector<std::uint8_t>& getLinearToSrgbTable(); // 65536 entries (indexed by 16-bit linear)
+
+		} // namespace impl
+
+	} // namespace Image
+} // namespace plinth
+#include "ImageSrgb.inl"
@@ -0,0 +1,117 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// Plinth
+//
+// Copyright(c) 2014-2025 M.J.Silk
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions :
+//
+// 1. The origin of this software must not be misrepresented; you must not
+// claim that you wrote the original software.If you use this software
+// in a product, an acknowledgment in the product documentation would be
+// appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not be
+// misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+// M.J.Silk
+// MJSilk2@gmail.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once
+
+#include "ImageSrgb.hpp"
+
+#include <cmath>
+
+namespace plinth
+{
+	namespace Image
+	{
+		namespace impl
+		{
+
+inline const std::array<std::uint16_t, 256u>& getSrgbToLinearTable()
+{
+	static const std::array<std::uint16_t, 256u> table([]()
+	{
+		std::array<std::uint16_t, 256u> values{};
+		const std::array<float, 256u>& linear{ getSrgbToLinearFloatTable() };
+		for (std::size_t i{ 0_uz }; i < values.size(); ++i)
+			values[i] = static_cast<std::uint16_t>(std::lround(linear[i] * 65535.0));
+		return values;
+	}());
+	return table;
+}
+
+inline const std::array<float, 256u>& getSrgbToLinearFloatTable()
+{
+	static const std::array<float, 256u> table([]()
+	{
+		std::array<float, 256u> values{};
+		for (std::size_t i{ 0_uz }; i < values.size(); ++i)
+		{
+			const double encoded{ i / 255.0 };
+			values[i] = static_cast<float>((encoded <= 0.04045) ? (encoded / 12.92) : std::pow((encoded + 0.055) / 1.055, 2.4));
+		}
+		return values;
+	}());
+	return table;
+}
+
+inline const std::vector<std::uint8_t>& getLinearToSrgbTable()
+{
+	static const std::vector<std::uint8_t> table([]()
+	{
+		std::vector<std::uint8_t> values(65536u);
+		for (std::size_t i{ 0_uz }; i < values.size(); ++i)
+		{
+			const double linear{ i / 65535.0 };
+			const double encoded{ (linear <= 0.0031308) ? (linear * 12.92) : ((1.055 * std::pow(linear, 1.0 / 2.4)) - 0.055) };
+			values[i] = static_cast<std::uint8_t>(std::lround(encoded * 255.0));
+		}
+		return values;
+	}());
+	return table;
+}
+
+		} // namespace impl
+
+inline std::uint16_t srgbToLinear(const std::uint8_t value)
+{
+	return impl::getSrgbToLinearTable()[value];
+}
+
+inline float srgbToLinearFloat(const std::uint8_t value)
+{
+	return impl::getSrgbToLinearFloatTable()[value];
+}
+
+inline std::uint8_t linearToSrgb(const std::uint16_t value)
+{
+	return impl::getLinearToSrgbTable()[value];
+}
+
+inline std::uint8_t linearFloatToSrgb(const float value)
+{
+	const float clamped{ !(value > 0.f) ? 0.f : ((value > 1.f) ? 1.f : value) }; // NaN becomes zero
+	return impl::getLinearToSrgbTable()[static_cast<std::size_t>((clamped * 65535.f) + 0.5f)];
+}
+
+inline sf::Color colorFromLinear(const float red, const float green, const float blue, const std::uint8_t alpha)
+{
+	return{ linearFloatToSrgb(red), linearFloatToSrgb(green), linearFloatToSrgb(blue), alpha };
+}
+
+	} // namespace Image
+} // namespace plinth
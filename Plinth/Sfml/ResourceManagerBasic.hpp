@@ -35,14 +35,52 @@
 #include <SFML/Graphics/Image.hpp>
 #include <SFML/Graphics/Texture.hpp>
 #include <SFML/Audio/SoundBuffer.hpp>
+#include <SFML/System/Time.hpp>
 #include "../IndexedMap.hpp"
+#include "../ThreadPool.hpp"
+#include "../ResourcePack.hpp"
+#include <future>
+#include <memory>
+#include <deque>
+#include <mutex>
+#include <chrono>
+#include <unordered_map>
+#include <cstdint>
 
 namespace plinth
 {
 
 class ResourceManagerBasic
 {
+private:
+	struct ResourceUsage
+	{
+		std::string filename{}; // empty if the resource cannot be reloaded (it is then never evicted)
+		std::size_t memory{ 0_uz }; // approximate number of bytes
+		unsigned long long int lastUsed{ 0ull };
+		bool isUnloaded{ false }; // evicted or lazily added (and not yet accessed). loaded from filename when next accessed
+		bool isPrefetching{ false };
+		std::size_t numberOfSharers{ 0_uz }; // resources sharing this resource's content (see deduplication). it is then never evicted
+		std::shared_ptr<char> referenceAnchor{ std::make_shared<char>() }; // shared (via aliasing) by pointers given out by hold*
+	};
+	template <class T>
+	struct Resource
+	{
+		T resource{};
+		ResourceUsage usage{};
+		Resource<T>* shared{ nullptr }; // if set, the content is shared from this resource (see deduplication) and this resource's own object is empty
+		std::uint64_t contentHash{ 0u };
+		bool hasContentHash{ false };
+	};
+	template <class T>
+	using ContentHashes = std::unordered_map<std::uint64_t, Resource<T>*>; // content hash -> resource that owns the content
+
 public:
+	// handles remain valid when other resources are added or removed and avoid an ID lookup on access
+	using FontHandle = IndexedMap<std::string, Resource<sf::Font>, true>::Handle;
+	using ImageHandle = IndexedMap<std::string, Resource<sf::Image>, true>::Handle;
+	using TextureHandle = IndexedMap<std::string, Resource<sf::Texture>, true>::Handle;
+	using SoundBufferHandle = IndexedMap<std::string, Resource<sf::SoundBuffer>, true>::Handle;
 
 	std::vector<std::string> fontIds;
 	std::vector<std::string> imageIds;
@@ -50,6 +88,7 @@ public:
 	std::vector<std::string> soundBufferIds;
 
 	ResourceManagerBasic();
+	~ResourceManagerBasic();
 
 	std::size_t addFont(const std::string& id, const std::string& filename); // returns index
 	std::size_t addFont(const std::string& id); // returns index
@@ -92,6 +131,19 @@ public:
 	sf::SoundBuffer& getSoundBuffer(const std::string& soundBufferId);
 	sf::SoundBuffer& getSoundBuffer(std::size_t soundBufferIndex);
 
+	FontHandle getFontHandle(const std::string& fontId) const;
+	FontHandle getFontHandle(std::size_t fontIndex) const;
+	ImageHandle getImageHandle(const std::string& imageId) const;
+	ImageHandle getImageHandle(std::size_t imageIndex) const;
+	TextureHandle getTextureHandle(const std::string& textureId) const;
+	TextureHandle getTextureHandle(std::size_t textureIndex) const;
+	SoundBufferHandle getSoundBufferHandle(const std::string& soundBufferId) const;
+	SoundBufferHandle getSoundBufferHandle(std::size_t soundBufferIndex) const;
+	sf::Font& getFont(FontHandle fontHandle);
+	sf::Image& getImage(ImageHandle imageHandle);
+	sf::Texture& getTexture(TextureHandle textureHandle);
+	sf::SoundBuffer& getSoundBuffer(SoundBufferHandle soundBufferHandle);
+
 	void removeFont(const std::string& fontId);
 	void removeFont(std::size_t fontIndex);
 	void removeImage(const std::string& imageId);
@@ -105,13 +157,259 @@ public:
 	void removeAllTextures();
 	void removeAllSoundBuffers();
 
+	// lazy loading: only the ID and filename are stored when added. the file is loaded when the resource is first accessed (or its prefetch has been processed)
+	std::size_t addLazyFont(const std::string& id, const std::string& filename); // returns index
+	std::size_t addLazyImage(const std::string& id, const std::string& filename); // returns index
+	std::size_t addLazyTexture(const std::string& id, const std::string& filename); // returns index
+	std::size_t addLazySoundBuffer(const std::string& id, const std::string& filename); // returns index
+	void prefetchFont(const std::string& fontId); // hint that the font will be needed soon: loads asynchronously (see processAsyncLoads) if not loaded
+	void prefetchFont(std::size_t fontIndex);
+	void prefetchImage(const std::string& imageId); // hint that the image will be needed soon: loads asynchronously (see processAsyncLoads) if not loaded
+	void prefetchImage(std::size_t imageIndex);
+	void prefetchTexture(const std::string& textureId); // hint that the texture will be needed soon: loads asynchronously (see processAsyncLoads) if not loaded
+	void prefetchTexture(std::size_t textureIndex);
+	void prefetchSoundBuffer(const std::string& soundBufferId); // hint that the sound buffer will be needed soon: loads asynchronously (see processAsyncLoads) if not loaded
+	void prefetchSoundBuffer(std::size_t soundBufferIndex);
+	bool isFontLoaded(const std::string& fontId) const; // false if lazily added (and not yet accessed) or evicted
+	bool isImageLoaded(const std::string& imageId) const; // false if lazily added (and not yet accessed) or evicted
+	bool isTextureLoaded(const std::string& textureId) const; // false if lazily added (and not yet accessed) or evicted
+	bool isSoundBufferLoaded(const std::string& soundBufferId) const; // false if lazily added (and not yet accessed) or evicted
+
+	// memory budget: when the approximate memory usage of images, textures and sound buffers exceeds the budget, the least recently used are evicted. they are reloaded from their files when next accessed
+	// resources that are currently held (see hold*) or were not loaded from a file are never evicted. an evicted resource keeps its object (and address); only its data is released
+	void setMemoryBudget(std::size_t memoryBudget); // in bytes. zero is unlimited (default)
+	std::size_t getMemoryBudget() const;
+	std::size_t getMemoryUsage() const; // approximate bytes used by loaded images (pixels), textures (estimated video memory) and sound buffers (samples)
+	void enforceMemoryBudget(); // evicts until within budget. this is done automatically after each load
+	std::shared_ptr<sf::Image> holdImage(const std::string& imageId); // the image cannot be evicted while any copy of the returned pointer exists. the pointer does not own the image
+	std::shared_ptr<sf::Image> holdImage(std::size_t imageIndex);
+	std::shared_ptr<sf::Texture> holdTexture(const std::string& textureId); // the texture cannot be evicted while any copy of the returned pointer exists. the pointer does not own the texture
+	std::shared_ptr<sf::Texture> holdTexture(std::size_t textureIndex);
+	std::shared_ptr<sf::SoundBuffer> holdSoundBuffer(const std::string& soundBufferId); // the sound buffer cannot be evicted while any copy of the returned pointer exists. the pointer does not own the sound buffer
+	std::shared_ptr<sf::SoundBuffer> holdSoundBuffer(std::size_t soundBufferIndex);
+
+	// glyph pre-warming: rasterises glyphs ahead of time (e.g. on a loading screen) so that drawing text later does not stall while the font generates them and grows its page texture
+	// bold and outline thickness are the style parameters of sf::Font::getGlyph (italic, underlined and strike-through text use the same glyphs as regular text)
+	void prewarmFont(const std::string& fontId, const std::vector<unsigned int>& characterSizes, const std::u32string& codePoints, bool bold = false, float outlineThickness = 0.f); // rasterises all glyphs immediately
+	void prewarmFont(std::size_t fontIndex, const std::vector<unsigned int>& characterSizes, const std::u32string& codePoints, bool bold = false, float outlineThickness = 0.f); // rasterises all glyphs immediately
+	void queueFontPrewarm(const std::string& fontId, const std::vector<unsigned int>& characterSizes, const std::u32string& codePoints, bool bold = false, float outlineThickness = 0.f); // glyphs are rasterised by processFontPrewarming
+	void queueFontPrewarm(std::size_t fontIndex, const std::vector<unsigned int>& characterSizes, const std::u32string& codePoints, bool bold = false, float outlineThickness = 0.f); // glyphs are rasterised by processFontPrewarming
+	std::size_t processFontPrewarming(sf::Time timeBudget = sf::Time::Zero); // rasterises queued glyphs until the time budget is spent (zero is unlimited), allowing it to be spread over frames. returns number of glyphs still queued
+	std::size_t getNumberOfQueuedPrewarmGlyphs() const;
+
+	// deduplication: images (and textures) whose pixels are identical (hashed after decoding, then compared in full on a hash match) share one sf::Image (or sf::Texture). getting any of them returns the same object so a change to one is seen by all
+	// only loads made while it is enabled are deduplicated. if the resource that owns shared content is removed or loaded with different content, the content is passed on to a resource sharing it
+	// references obtained from a resource that shares content refer to the owner's object so, as with its own object, they should not be used after either of them is removed
+	// loads are not deduplicated while hot reload is enabled so that a reload only changes its own resource's object. content already shared when hot reload is enabled is not hot reloaded
+	struct DeduplicationStatistics
+	{
+		std::size_t numberOfSharedImages{ 0_uz }; // images using another image's content
+		std::size_t numberOfSharedTextures{ 0_uz }; // textures using another texture's content
+		std::size_t memorySaved{ 0_uz }; // approximate number of bytes not used because of sharing
+	};
+	void setDeduplication(bool deduplication); // disabled by default
+	bool getDeduplication() const;
+	DeduplicationStatistics getDeduplicationStatistics() const;
+
+	// instrumentation: only recorded if PLINTH_RESOURCE_MANAGER_INSTRUMENTATION is defined before including this header. otherwise it is compiled out (no overhead) and statistics are zero (except memory)
+	struct ResourceStatistics
+	{
+		std::size_t numberOfLoads{ 0_uz }; // includes reloads and asynchronous loads
+		std::size_t numberOfFailedLoads{ 0_uz };
+		double decodeTime{ 0.0 }; // total seconds spent reading and decoding files (on worker threads for asynchronous loads). includes uploading for textures loaded directly from files
+		double maximumDecodeTime{ 0.0 }; // seconds
+		double uploadTime{ 0.0 }; // total seconds spent uploading textures from decoded images
+		double maximumUploadTime{ 0.0 }; // seconds
+		std::size_t memory{ 0_uz }; // approximate bytes currently held (see getMemoryUsage). fonts are not measured
+		std::size_t numberOfLookupsById{ 0_uz };
+		std::size_t numberOfLookupsByIndex{ 0_uz };
+		std::size_t numberOfLookupsByHandle{ 0_uz };
+		std::size_t numberOfFailedLookups{ 0_uz }; // included in the counts above
+	};
+	struct Statistics
+	{
+		ResourceStatistics fonts{};
+		ResourceStatistics images{};
+		ResourceStatistics textures{};
+		ResourceStatistics soundBuffers{};
+	};
+	Statistics getStatistics() const;
+	void resetStatistics();
+	std::string getStatisticsAsJson() const;
+	std::string getStatisticsAsCsv() const; // header line then one line per resource type
+	bool saveStatisticsAsJson(const std::string& filename) const;
+	bool saveStatisticsAsCsv(const std::string& filename) const;
+
+	// resource pack: while a pack is mounted, every file load (including reloads and async loads) first looks for the filename in the pack and, if found, loads from the pack's memory-mapped data
+	// filenames are looked up with the mount path removed from their start (e.g. with mount path "assets/", "assets/images/a.png" is looked up as "images/a.png")
+	// fonts read from their data as needed so fonts loaded from a pack must not be used after it is unmounted
+	void mountResourcePack(const std::string& packFilename, const std::string& mountPath = ""); // throws exception if pack cannot be opened
+	void unmountResourcePack();
+	bool isResourcePackMounted() const;
+
+	// hot reload (Linux only, using inotify; does nothing on other platforms): when a file of a loaded resource changes, it is reloaded asynchronously (checked and applied by processAsyncLoads)
+	// resources keep their objects (e.g. sprites using a reloaded texture show the new texture). bursts of changes to a file are combined; it is reloaded once it has not changed for the hot reload delay
+	void setHotReload(bool hotReload);
+	bool getHotReload() const;
+	void setHotReloadDelay(sf::Time hotReloadDelay); // default is 0.1 seconds
+	sf::Time getHotReloadDelay() const;
+
+	// asynchronous loading: files are loaded and decoded on worker threads. resources are only changed (and textures only uploaded) by processAsyncLoads, which should be called from the main thread (e.g. once per frame)
+	// returned futures become ready when the load is applied by processAsyncLoads. they hold an exception if the file loading fails or the resource was removed in the meantime
+	void setNumberOfAsyncLoadingThreads(std::size_t numberOfThreads); // zero uses hardware concurrency. if async loads are pending, takes effect when processAsyncLoads has applied them all
+	std::future<void> openFontAsync(const std::string& id, const std::string& filename);
+	std::future<void> openFontAsync(std::size_t index, const std::string& filename);
+	std::future<void> loadImageAsync(const std::string& id, const std::string& filename);
+	std::future<void> loadImageAsync(std::size_t index, const std::string& filename);
+	std::future<void> loadTextureAsync(const std::string& id, const std::string& filename); // image is decoded asynchronously; texture is uploaded during processAsyncLoads
+	std::future<void> loadTextureAsync(std::size_t index, const std::string& filename); // image is decoded asynchronously; texture is uploaded during processAsyncLoads
+	std::future<void> loadSoundBufferAsync(const std::string& id, const std::string& filename);
+	std::future<void> loadSoundBufferAsync(std::size_t index, const std::string& filename);
+	std::size_t processAsyncLoads(sf::Time timeBudget = sf::Time::Zero); // applies completed loads until the time budget is spent (zero is unlimited). at least one is applied if available. returns number of loads still pending
+	std::size_t getNumberOfPendingAsyncLoads() const;
+
 private:
 	const std::string m_resourceManagerExceptionPrefix;
 
-	IndexedMap<std::string, sf::Font> m_fonts;
-	IndexedMap<std::string, sf::Image> m_images;
-	IndexedMap<std::string, sf::Texture> m_textures;
-	IndexedMap<std::string, sf::SoundBuffer> m_soundBuffers;
+	// stable maps so that references given out (e.g. textures used by sprites) remain valid when other resources are added or removed
+	IndexedMap<std::string, Resource<sf::Font>, true> m_fonts;
+	IndexedMap<std::string, Resource<sf::Image>, true> m_images;
+	IndexedMap<std::string, Resource<sf::Texture>, true> m_textures;
+	IndexedMap<std::string, Resource<sf::SoundBuffer>, true> m_soundBuffers;
+
+	std::size_t m_memoryBudget;
+	std::size_t m_memoryUsage;
+	unsigned long long int m_usageCounter;
+
+	enum class ResourceType
+	{
+		Font,
+		Image,
+		Texture,
+		SoundBuffer,
+	};
+	enum class LookupType
+	{
+		Id,
+		Index,
+		Handle,
+	};
+	class InstrumentationTimer // does nothing unless instrumented
+	{
+	public:
+		InstrumentationTimer();
+		double getSeconds() const;
+
+	private:
+		std::chrono::steady_clock::time_point m_start; // declared regardless of instrumentation so that the layout is the same in every translation unit
+	};
+	struct MountedResourcePack
+	{
+		ResourcePack pack;
+		std::string mountPath;
+	};
+	struct AsyncLoad
+	{
+		ResourceType type;
+		FontHandle fontHandle{}; // the handle for the load's type identifies the resource that the load was queued for (a removed resource's handle stays invalid even if another is added with its ID)
+		ImageHandle imageHandle{};
+		TextureHandle textureHandle{};
+		SoundBufferHandle soundBufferHandle{};
+		std::string filename;
+		bool isPrefetch{ false }; // a prefetch's result is dropped if the resource has since been loaded or its filename has changed
+		bool isLoaded{ false };
+		double decodeTime{ 0.0 }; // recorded if instrumented
+		std::shared_ptr<MountedResourcePack> resourcePack{}; // pack mounted when the load was queued (kept alive by the load so that unmounting or mounting another does not affect it)
+		std::promise<void> promise{};
+		sf::Font font{};
+		sf::Image image{};
+		sf::SoundBuffer soundBuffer{};
+	};
+	struct FontPrewarm
+	{
+		FontHandle font;
+		std::vector<unsigned int> characterSizes;
+		std::u32string codePoints;
+		bool bold;
+		float outlineThickness;
+		std::size_t numberOfGlyphsRasterised{ 0_uz };
+	};
+	std::deque<FontPrewarm> m_fontPrewarms;
+	std::size_t m_numberOfQueuedPrewarmGlyphs;
+
+	Statistics m_statistics; // declared regardless of instrumentation so that the layout is the same in every translation unit. only recorded if instrumented
+
+	bool m_deduplication;
+	ContentHashes<sf::Image> m_imageContentHashes;
+	ContentHashes<sf::Texture> m_textureContentHashes;
+
+	std::shared_ptr<MountedResourcePack> m_resourcePack; // shared with async loads queued while it is mounted
+
+	bool m_hotReload;
+	sf::Time m_hotReloadDelay;
+	int m_hotReloadFileDescriptor; // inotify instance (Linux only)
+	std::unordered_map<int, std::string> m_hotReloadDirectories; // watch descriptor -> directory
+	std::unordered_map<std::string, std::chrono::steady_clock::time_point> m_hotReloadChangedFiles; // normalised filename -> time of latest change
+
+	std::size_t m_numberOfAsyncLoadingThreads;
+	std::size_t m_numberOfPendingAsyncLoads;
+	std::deque<std::shared_ptr<AsyncLoad>> m_completedAsyncLoads;
+	std::mutex m_completedAsyncLoadsMutex;
+	std::unique_ptr<ThreadPool> m_asyncLoadingPool; // must be destroyed before the completed loads queue and its mutex
+
+	std::future<void> priv_addAsyncLoad(ResourceType type, std::size_t index, const std::string& filename, bool isPrefetch = false);
+	void priv_applyAsyncLoad(AsyncLoad& asyncLoad);
+
+	template <class T>
+	T& priv_use(Resource<T>& resource); // marks as used and reloads if evicted
+	template <class T>
+	void priv_updateUsage(Resource<T>& resource, const std::string& filename); // called after each load
+	template <class T>
+	std::shared_ptr<T> priv_hold(Resource<T>& resource);
+	void priv_prefetch(ResourceType type, std::size_t index, ResourceUsage& usage);
+	ResourceUsage* priv_getUsage(const AsyncLoad& asyncLoad); // returns nullptr if the resource that the load was queued for no longer exists
+	void priv_recordLookup(ResourceType type, LookupType lookupType, bool isFound);
+	void priv_recordLoad(ResourceType type, bool isLoaded, double decodeTime);
+	void priv_recordUpload(double uploadTime);
+	static ResourceType priv_getType(const sf::Font&);
+	static ResourceType priv_getType(const sf::Image&);
+	static ResourceType priv_getType(const sf::Texture&);
+	static ResourceType priv_getType(const sf::SoundBuffer&);
+	void priv_queueFontPrewarm(FontHandle fontHandle, const std::vector<unsigned int>& characterSizes, const std::u32string& codePoints, bool bold, float outlineThickness);
+	template <class T>
+	bool priv_load(Resource<T>& resource, const std::string& filename); // fonts and sound buffers are not deduplicated
+	bool priv_load(Resource<sf::Image>& image, const std::string& filename);
+	bool priv_load(Resource<sf::Texture>& texture, const std::string& filename);
+	void priv_setImage(Resource<sf::Image>& image, sf::Image&& newImage); // deduplicates if enabled
+	bool priv_setTexture(Resource<sf::Texture>& texture, const sf::Image& image); // deduplicates if enabled
+	template <class T>
+	bool priv_deduplicate(Resource<T>& resource, const sf::Image& pixels, ContentHashes<T>& contentHashes, IndexedMap<std::string, Resource<T>, true>& resources); // returns true if resource now shares existing content (matching hash and pixels). if false, resource owns the content and its object must be set
+	template <class T>
+	void priv_detach(Resource<T>& resource, ContentHashes<T>& contentHashes, IndexedMap<std::string, Resource<T>, true>& resources, bool isRemoving); // stops sharing and passes on any content shared from it
+	template <class T>
+	void priv_detachAll(const std::string& id, ContentHashes<T>& contentHashes, IndexedMap<std::string, Resource<T>, true>& resources);
+	static std::uint64_t priv_hashPixels(const sf::Image& image);
+	static bool priv_hasPixels(const sf::Image& image, const sf::Image& pixels);
+	static bool priv_hasPixels(const sf::Texture& texture, const sf::Image& pixels); // copies texture to an image if sizes match
+	template <class T>
+	void priv_evict(Resource<T>& resource);
+	void priv_recalculateMemoryUsage();
+	void priv_watchFile(const std::string& filename);
+	void priv_watchAllFiles();
+	void priv_processHotReload();
+	static std::string priv_normaliseFilename(const std::string& filename);
+	template <class T>
+	static void priv_release(T& resource);
+	static void priv_release(sf::Texture& texture);
+	static std::size_t priv_getMemory(const sf::Font& font);
+	static std::size_t priv_getMemory(const sf::Image& image);
+	static std::size_t priv_getMemory(const sf::Texture& texture);
+	static std::size_t priv_getMemory(const sf::SoundBuffer& soundBuffer);
+	static const void* priv_getResourcePackData(MountedResourcePack* resourcePack, const std::string& filename, std::size_t& size); // returns nullptr if there is no pack or the file is not in it
+	static bool priv_loadFromFile(sf::Font& font, const std::string& filename, MountedResourcePack* resourcePack); // uses resource pack if available
+	static bool priv_loadFromFile(sf::Image& image, const std::string& filename, MountedResourcePack* resourcePack); // uses resource pack if available
+	static bool priv_loadFromFile(sf::Texture& texture, const std::string& filename, MountedResourcePack* resourcePack); // uses resource pack if available
+	static bool priv_loadFromFile(sf::SoundBuffer& soundBuffer, const std::string& filename, MountedResourcePack* resourcePack); // uses resource pack if available
 };
 
 } // namespace plinth
@@ -31,6 +31,19 @@
 
 #include "ResourceManagerBasic.hpp"
 
+#include <SFML/System/Clock.hpp>
+#include <filesystem>
+#include <cstring>
+#include <sstream>
+#include <fstream>
+#include <algorithm>
+
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <unistd.h>
+#include <cerrno>
+#endif // __linux__
+
 namespace plinth
 {
 
@@ -40,9 +53,34 @@ inline ResourceManagerBasic::ResourceManagerBasic()
 	, m_images{}
 	, m_textures{}
 	, m_soundBuffers{}
+	, m_memoryBudget{ 0_uz }
+	, m_memoryUsage{ 0_uz }
+	, m_usageCounter{ 0ull }
+	, m_fontPrewarms{}
+	, m_numberOfQueuedPrewarmGlyphs{ 0_uz }
+	, m_statistics{}
+	, m_deduplication{ false }
+	, m_imageContentHashes{}
+	, m_textureContentHashes{}
+	, m_resourcePack{}
+	, m_hotReload{ false }
+	, m_hotReloadDelay{ sf::seconds(0.1f) }
+	, m_hotReloadFileDescriptor{ -1 }
+	, m_hotReloadDirectories{}
+	, m_hotReloadChangedFiles{}
+	, m_numberOfAsyncLoadingThreads{ 0_uz }
+	, m_numberOfPendingAsyncLoads{ 0_uz }
+	, m_completedAsyncLoads{}
+	, m_completedAsyncLoadsMutex{}
+	, m_asyncLoadingPool{}
 {
 }
 
+inline ResourceManagerBasic::~ResourceManagerBasic()
+{
+	setHotReload(false);
+}
+
 inline std::size_t ResourceManagerBasic::addFont(const std::string& id, const std::string& filename)
 {
 	std::size_t index{ addFont(id) };
@@ -52,7 +90,7 @@ inline std::size_t ResourceManagerBasic::addFont(const std::string& id, const st
 
 inline std::size_t ResourceManagerBasic::addFont(const std::string& id)
 {
-	m_fonts.add(id, sf::Font());
+	m_fonts.emplace(id);
 	fontIds.push_back(id);
 	return m_fonts.getSize() - 1_uz;
 }
@@ -68,16 +106,18 @@ inline void ResourceManagerBasic::openFont(const std::string& id, const std::str
 {
 	if (!m_fonts.valid(id))
 		throw Exception(m_resourceManagerExceptionPrefix + "Invalid font ID.");
-	else if (!m_fonts.access(id).openFromFile(filename))
+	else if (!priv_load(m_fonts.access(id), filename))
 		throw Exception(m_resourceManagerExceptionPrefix + "Cannot open font.");
+	priv_updateUsage(m_fonts.access(id), filename);
 }
 
 inline void ResourceManagerBasic::openFont(const std::size_t index, const std::string& filename)
 {
 	if (!m_fonts.valid(index))
 		throw Exception(m_resourceManagerExceptionPrefix + "Invalid font index.");
-	else if (!m_fonts.access(index).openFromFile(filename))
+	else if (!priv_load(m_fonts.access(index), filename))
 		throw Exception(m_resourceManagerExceptionPrefix + "Cannot open font.");
+	priv_updateUsage(m_fonts.access(index), filename);
 }
 
 inline std::string ResourceManagerBasic::openNewFont(const std::string& filename)
@@ -96,7 +136,7 @@ inline std::size_t ResourceManagerBasic::addImage(const std::string& id, const s
 
 inline std::size_t ResourceManagerBasic::addImage(const std::string& id)
 {
-	m_images.add(id, sf::Image());
+	m_images.emplace(id);
 	imageIds.push_back(id);
 	return m_images.getSize() - 1_uz;
 }
@@ -112,16 +152,18 @@ inline void ResourceManagerBasic::loadImage(const std::string& id, const std::st
 {
 	if (!m_images.valid(id))
 		throw Exception(m_resourceManagerExceptionPrefix + "Invalid image ID.");
-	else if (!m_images.access(id).loadFromFile(filename))
+	else if (!priv_load(m_images.access(id), filename))
 		throw Exception(m_resourceManagerExceptionPrefix + "Cannot load image.");
+	priv_updateUsage(m_images.access(id), filename);
 }
 
 inline void ResourceManagerBasic::loadImage(const std::size_t index, const std::string& filename)
 {
 	if (!m_images.valid(index))
 		throw Exception(m_resourceManagerExceptionPrefix + "Invalid image index.");
-	else if (!m_images.access(index).loadFromFile(filename))
+	else if (!priv_load(m_images.access(index), filename))
 		throw Exception(m_resourceManagerExceptionPrefix + "Cannot load image.");
+	priv_updateUsage(m_images.access(index), filename);
 }
 
 inline std::string ResourceManagerBasic::loadNewImage(const std::string& filename)
@@ -140,7 +182,7 @@ inline std::size_t ResourceManagerBasic::addTexture(const std::string& id, const
 
 inline std::size_t ResourceManagerBasic::addTexture(const std::string& id)
 {
-	m_textures.add(id, sf::Texture());
+	m_textures.emplace(id);
 	textureIds.push_back(id);
 	return m_textures.getSize() - 1_uz;
 }
@@ -156,16 +198,18 @@ inline void ResourceManagerBasic::loadTexture(const std::string& id, const std::
 {
 	if (!m_textures.valid(id))
 		throw Exception(m_resourceManagerExceptionPrefix + "Invalid texture ID.");
-	else if (!m_textures.access(id).loadFromFile(filename))
+	else if (!priv_load(m_textures.access(id), filename))
 		throw Exception(m_resourceManagerExceptionPrefix + "Cannot load texture.");
+	priv_updateUsage(m_textures.access(id), filename);
 }
 
 inline void ResourceManagerBasic::loadTexture(const std::size_t index, const std::string& filename)
 {
 	if (!m_textures.valid(index))
 		throw Exception(m_resourceManagerExceptionPrefix + "Invalid texture index.");
-	else if (!m_textures.access(index).loadFromFile(filename))
+	else if (!priv_load(m_textures.access(index), filename))
 		throw Exception(m_resourceManagerExceptionPrefix + "Cannot load texture.");
+	priv_updateUsage(m_textures.access(index), filename);
 }
 
 inline void ResourceManagerBasic::loadTextureFromImage(const std::string& textureId, const std::string& imageId)
@@ -174,8 +218,9 @@ inline void ResourceManagerBasic::loadTextureFromImage(const std::string& textur
 		throw Exception(m_resourceManagerExceptionPrefix + "Invalid image ID.");
 	else if (!m_textures.valid(textureId))
 		throw Exception(m_resourceManagerExceptionPrefix + "Invalid texture ID.");
-	else if (!m_textures.access(textureId).loadFromImage(m_images.access(imageId)))
+	else if (!priv_setTexture(m_textures.access(textureId), priv_use(m_images.access(imageId))))
 		throw Exception(m_resourceManagerExceptionPrefix + "Failed to load texture from image.");
+	priv_updateUsage(m_textures.access(textureId), ""); // no file to reload from so is never evicted
 }
 
 inline void ResourceManagerBasic::loadTextureFromImage(const std::string& textureId, const std::size_t imageIndex)
@@ -184,8 +229,9 @@ inline void ResourceManagerBasic::loadTextureFromImage(const std::string& textur
 		throw Exception(m_resourceManagerExceptionPrefix + "Invalid image idnex.");
 	else if (!m_textures.valid(textureId))
 		throw Exception(m_resourceManagerExceptionPrefix + "Invalid texture ID.");
-	else if (!m_textures.access(textureId).loadFromImage(m_images.access(imageIndex)))
+	else if (!priv_setTexture(m_textures.access(textureId), priv_use(m_images.access(imageIndex))))
 		throw Exception(m_resourceManagerExceptionPrefix + "Failed to load texture from image.");
+	priv_updateUsage(m_textures.access(textureId), ""); // no file to reload from so is never evicted
 }
 
 inline void ResourceManagerBasic::loadTextureFromImage(const std::size_t textureIndex, const std::string& imageId)
@@ -194,8 +240,9 @@ inline void ResourceManagerBasic::loadTextureFromImage(const std::size_t texture
 		throw Exception(m_resourceManagerExceptionPrefix + "Invalid image ID.");
 	else if (!m_textures.valid(textureIndex))
 		throw Exception(m_resourceManagerExceptionPrefix + "Invalid texture index.");
-	else if (!m_textures.access(textureIndex).loadFromImage(m_images.access(imageId)))
+	else if (!priv_setTexture(m_textures.access(textureIndex), priv_use(m_images.access(imageId))))
 		throw Exception(m_resourceManagerExceptionPrefix + "Failed to load texture from image.");
+	priv_updateUsage(m_textures.access(textureIndex), ""); // no file to reload from so is never evicted
 }
 
 inline void ResourceManagerBasic::loadTextureFromImage(const std::size_t textureIndex, const std::size_t imageIndex)
@@ -204,8 +251,9 @@ inline void ResourceManagerBasic::loadTextureFromImage(const std::size_t texture
 		throw Exception(m_resourceManagerExceptionPrefix + "Invalid image index.");
 	else if (!m_textures.valid(textureIndex))
 		throw Exception(m_resourceManagerExceptionPrefix + "Invalid texture index.");
-	else if (!m_textures.access(textureIndex).loadFromImage(m_images.access(imageIndex)))
+	else if (!priv_setTexture(m_textures.access(textureIndex), priv_use(m_images.access(imageIndex))))
 		throw Exception(m_resourceManagerExceptionPrefix + "Failed to load texture from image.");
+	priv_updateUsage(m_textures.access(textureIndex), ""); // no file to reload from so is never evicted
 }
 
 inline std::string ResourceManagerBasic::loadNewTexture(const std::string& filename)
@@ -224,7 +272,7 @@ inline std::size_t ResourceManagerBasic::addSoundBuffer(const std::string& id, c
 
 inline std::size_t ResourceManagerBasic::addSoundBuffer(const std::string& id)
 {
-	m_soundBuffers.add(id, sf::SoundBuffer());
+	m_soundBuffers.emplace(id);
 	soundBufferIds.push_back(id);
 	return m_soundBuffers.getSize() - 1_uz;
 }
@@ -240,16 +288,18 @@ inline void ResourceManagerBasic::loadSoundBuffer(const std::string& id, const s
 {
 	if (!m_soundBuffers.valid(id))
 		throw Exception(m_resourceManagerExceptionPrefix + "Invalid sound buffer ID.");
-	else if (!m_soundBuffers.access(id).loadFromFile(filename))
+	else if (!priv_load(m_soundBuffers.access(id), filename))
 		throw Exception(m_resourceManagerExceptionPrefix + "Cannot load sound buffer.");
+	priv_updateUsage(m_soundBuffers.access(id), filename);
 }
 
 inline void ResourceManagerBasic::loadSoundBuffer(const std::size_t index, const std::string& filename)
 {
 	if (!m_soundBuffers.valid(index))
 		throw Exception(m_resourceManagerExceptionPrefix + "Invalid sound buffer index.");
-	else if (!m_soundBuffers.access(index).loadFromFile(filename))
+	else if (!priv_load(m_soundBuffers.access(index), filename))
 		throw Exception(m_resourceManagerExceptionPrefix + "Cannot load sound buffer.");
+	priv_updateUsage(m_soundBuffers.access(index), filename);
 }
 
 inline std::string ResourceManagerBasic::loadNewSoundBuffer(const std::string& filename)
@@ -261,64 +311,180 @@ inline std::string ResourceManagerBasic::loadNewSoundBuffer(const std::string& f
 
 inline sf::Font& ResourceManagerBasic::getFont(const std::string& fontId)
 {
-	if (m_fonts.valid(fontId))
-		return m_fonts.access(fontId);
+	const std::size_t index{ m_fonts.find(fontId) };
+	priv_recordLookup(ResourceType::Font, LookupType::Id, m_fonts.valid(index));
+	if (m_fonts.valid(index))
+		return priv_use(m_fonts.access(index));
 	else
 		throw Exception(m_resourceManagerExceptionPrefix + "Font not available.");
 }
 
 inline sf::Font& ResourceManagerBasic::getFont(const std::size_t fontIndex)
 {
+	priv_recordLookup(ResourceType::Font, LookupType::Index, m_fonts.valid(fontIndex));
 	if (m_fonts.valid(fontIndex))
-		return m_fonts.access(fontIndex);
+		return priv_use(m_fonts.access(fontIndex));
 	else
 		throw Exception(m_resourceManagerExceptionPrefix + "Font not available.");
 }
 
 inline sf::Image& ResourceManagerBasic::getImage(const std::string& imageId)
 {
-	if (m_images.valid(imageId))
-		return m_images.access(imageId);
+	const std::size_t index{ m_images.find(imageId) };
+	priv_recordLookup(ResourceType::Image, LookupType::Id, m_images.valid(index));
+	if (m_images.valid(index))
+		return priv_use(m_images.access(index));
 	else
 		throw Exception(m_resourceManagerExceptionPrefix + "Image not available.");
 }
 
 inline sf::Image& ResourceManagerBasic::getImage(const std::size_t imageIndex)
 {
+	priv_recordLookup(ResourceType::Image, LookupType::Index, m_images.valid(imageIndex));
 	if (m_images.valid(imageIndex))
-		return m_images.access(imageIndex);
+		return priv_use(m_images.access(imageIndex));
 	else
 		throw Exception(m_resourceManagerExceptionPrefix + "Image not available.");
 }
 
 inline sf::Texture& ResourceManagerBasic::getTexture(const std::string& textureId)
 {
-	if (m_textures.valid(textureId))
-		return m_textures.access(textureId);
+	const std::size_t index{ m_textures.find(textureId) };
+	priv_recordLookup(ResourceType::Texture, LookupType::Id, m_textures.valid(index));
+	if (m_textures.valid(index))
+		return priv_use(m_textures.access(index));
 	else
 		throw Exception(m_resourceManagerExceptionPrefix + "Texture not available.");
 }
 
 inline sf::Texture& ResourceManagerBasic::getTexture(const std::size_t textureIndex)
 {
+	priv_recordLookup(ResourceType::Texture, LookupType::Index, m_textures.valid(textureIndex));
 	if (m_textures.valid(textureIndex))
-		return m_textures.access(textureIndex);
+		return priv_use(m_textures.access(textureIndex));
 	else
 		throw Exception(m_resourceManagerExceptionPrefix + "Texture not available.");
 }
 
 inline sf::SoundBuffer& ResourceManagerBasic::getSoundBuffer(const std::string& soundBufferId)
 {
-	if (m_soundBuffers.valid(soundBufferId))
-		return m_soundBuffers.access(soundBufferId);
+	const std::size_t index{ m_soundBuffers.find(soundBufferId) };
+	priv_recordLookup(ResourceType::SoundBuffer, LookupType::Id, m_soundBuffers.valid(index));
+	if (m_soundBuffers.valid(index))
+		return priv_use(m_soundBuffers.access(index));
 	else
 		throw Exception(m_resourceManagerExceptionPrefix + "SoundBuffer not available.");
 }
 
 inline sf::SoundBuffer& ResourceManagerBasic::getSoundBuffer(const std::size_t soundBufferIndex)
 {
+	priv_recordLookup(ResourceType::SoundBuffer, LookupType::Index, m_soundBuffers.valid(soundBufferIndex));
 	if (m_soundBuffers.valid(soundBufferIndex))
-		return m_soundBuffers.access(soundBufferIndex);
+		return priv_use(m_soundBuffers.access(soundBufferIndex));
+	else
+		throw Exception(m_resourceManagerExceptionPrefix + "SoundBuffer not available.");
+}
+
+inline ResourceManagerBasic::FontHandle ResourceManagerBasic::getFontHandle(const std::string& fontId) const
+{
+	const std::size_t index{ m_fonts.find(fontId) };
+	if (m_fonts.valid(index))
+		return m_fonts.getHandle(index);
+	else
+		throw Exception(m_resourceManagerExceptionPrefix + "Font not available.");
+}
+
+inline ResourceManagerBasic::FontHandle ResourceManagerBasic::getFontHandle(const std::size_t fontIndex) const
+{
+	if (m_fonts.valid(fontIndex))
+		return m_fonts.getHandle(fontIndex);
+	else
+		throw Exception(m_resourceManagerExceptionPrefix + "Font not available.");
+}
+
+inline ResourceManagerBasic::ImageHandle ResourceManagerBasic::getImageHandle(const std::string& imageId) const
+{
+	const std::size_t index{ m_images.find(imageId) };
+	if (m_images.valid(index))
+		return m_images.getHandle(index);
+	else
+		throw Exception(m_resourceManagerExceptionPrefix + "Image not available.");
+}
+
+inline ResourceManagerBasic::ImageHandle ResourceManagerBasic::getImageHandle(const std::size_t imageIndex) const
+{
+	if (m_images.valid(imageIndex))
+		return m_images.getHandle(imageIndex);
+	else
+		throw Exception(m_resourceManagerExceptionPrefix + "Image not available.");
+}
+
+inline ResourceManagerBasic::TextureHandle ResourceManagerBasic::getTextureHandle(const std::string& textureId) const
+{
+	const std::size_t index{ m_textures.find(textureId) };
+	if (m_textures.valid(index))
+		return m_textures.getHandle(index);
+	else
+		throw Exception(m_resourceManagerExceptionPrefix + "Texture not available.");
+}
+
+inline ResourceManagerBasic::TextureHandle ResourceManagerBasic::getTextureHandle(const std::size_t textureIndex) const
+{
+	if (m_textures.valid(textureIndex))
+		return m_textures.getHandle(textureIndex);
+	else
+		throw Exception(m_resourceManagerExceptionPrefix + "Texture not available.");
+}
+
+inline ResourceManagerBasic::SoundBufferHandle ResourceManagerBasic::getSoundBufferHandle(const std::string& soundBufferId) const
+{
+	const std::size_t index{ m_soundBuffers.find(soundBufferId) };
+	if (m_soundBuffers.valid(index))
+		return m_soundBuffers.getHandle(index);
+	else
+		throw Exception(m_resourceManagerExceptionPrefix + "SoundBuffer not available.");
+}
+
+inline ResourceManagerBasic::SoundBufferHandle ResourceManagerBasic::getSoundBufferHandle(const std::size_t soundBufferIndex) const
+{
+	if (m_soundBuffers.valid(soundBufferIndex))
+		return m_soundBuffers.getHandle(soundBufferIndex);
+	else
+		throw Exception(m_resourceManagerExceptionPrefix + "SoundBuffer not available.");
+}
+
+inline sf::Font& ResourceManagerBasic::getFont(const FontHandle fontHandle)
+{
+	priv_recordLookup(ResourceType::Font, LookupType::Handle, m_fonts.valid(fontHandle));
+	if (m_fonts.valid(fontHandle))
+		return priv_use(m_fonts.access(fontHandle));
+	else
+		throw Exception(m_resourceManagerExceptionPrefix + "Font not available.");
+}
+
+inline sf::Image& ResourceManagerBasic::getImage(const ImageHandle imageHandle)
+{
+	priv_recordLookup(ResourceType::Image, LookupType::Handle, m_images.valid(imageHandle));
+	if (m_images.valid(imageHandle))
+		return priv_use(m_images.access(imageHandle));
+	else
+		throw Exception(m_resourceManagerExceptionPrefix + "Image not available.");
+}
+
+inline sf::Texture& ResourceManagerBasic::getTexture(const TextureHandle textureHandle)
+{
+	priv_recordLookup(ResourceType::Texture, LookupType::Handle, m_textures.valid(textureHandle));
+	if (m_textures.valid(textureHandle))
+		return priv_use(m_textures.access(textureHandle));
+	else
+		throw Exception(m_resourceManagerExceptionPrefix + "Texture not available.");
+}
+
+inline sf::SoundBuffer& ResourceManagerBasic::getSoundBuffer(const SoundBufferHandle soundBufferHandle)
+{
+	priv_recordLookup(ResourceType::SoundBuffer, LookupType::Handle, m_soundBuffers.valid(soundBufferHandle));
+	if (m_soundBuffers.valid(soundBufferHandle))
+		return priv_use(m_soundBuffers.access(soundBufferHandle));
 	else
 		throw Exception(m_resourceManagerExceptionPrefix + "SoundBuffer not available.");
 }
@@ -326,61 +492,1362 @@ inline sf::SoundBuffer& ResourceManagerBasic::getSoundBuffer(const std::size_t s
 inline void ResourceManagerBasic::removeFont(const std::string& fontId)
 {
 	m_fonts.remove(fontId);
+	priv_recalculateMemoryUsage();
 }
 
 inline void ResourceManagerBasic::removeFont(const std::size_t fontIndex)
 {
 	m_fonts.remove(fontIndex);
+	priv_recalculateMemoryUsage();
 }
 
 inline void ResourceManagerBasic::removeImage(const std::string& imageId)
 {
+	priv_detachAll(imageId, m_imageContentHashes, m_images);
 	m_images.remove(imageId);
+	priv_recalculateMemoryUsage();
 }
 
 inline void ResourceManagerBasic::removeImage(const std::size_t imageIndex)
 {
+	if (m_images.valid(imageIndex))
+		priv_detach(m_images.access(imageIndex), m_imageContentHashes, m_images, true);
 	m_images.remove(imageIndex);
+	priv_recalculateMemoryUsage();
 }
 
 inline void ResourceManagerBasic::removeTexture(const std::string& textureId)
 {
+	priv_detachAll(textureId, m_textureContentHashes, m_textures);
 	m_textures.remove(textureId);
+	priv_recalculateMemoryUsage();
 }
 
 inline void ResourceManagerBasic::removeTexture(const std::size_t textureIndex)
 {
+	if (m_textures.valid(textureIndex))
+		priv_detach(m_textures.access(textureIndex), m_textureContentHashes, m_textures, true);
 	m_textures.remove(textureIndex);
+	priv_recalculateMemoryUsage();
 }
 
 inline void ResourceManagerBasic::removeSoundBuffer(const std::string& soundBufferId)
 {
 	m_soundBuffers.remove(soundBufferId);
+	priv_recalculateMemoryUsage();
 }
 
 inline void ResourceManagerBasic::removeSoundBuffer(const std::size_t soundBufferIndex)
 {
 	m_soundBuffers.remove(soundBufferIndex);
+	priv_recalculateMemoryUsage();
 }
 
 inline void ResourceManagerBasic::removeAllFonts()
 {
 	m_fonts.clear();
+	priv_recalculateMemoryUsage();
 }
 
 inline void ResourceManagerBasic::removeAllImages()
 {
 	m_images.clear();
+	m_imageContentHashes.clear();
+	priv_recalculateMemoryUsage();
 }
 
 inline void ResourceManagerBasic::removeAllTextures()
 {
 	m_textures.clear();
+	m_textureContentHashes.clear();
+	priv_recalculateMemoryUsage();
 }
 
 inline void ResourceManagerBasic::removeAllSoundBuffers()
 {
 	m_soundBuffers.clear();
+	priv_recalculateMemoryUsage();
+}
+
+inline std::size_t ResourceManagerBasic::addLazyFont(const std::string& id, const std::string& filename)
+{
+	const std::size_t index{ addFont(id) };
+	ResourceUsage& usage{ m_fonts.access(index).usage };
+	usage.filename = filename;
+	usage.isUnloaded = true;
+	return index;
+}
+
+inline std::size_t ResourceManagerBasic::addLazyImage(const std::string& id, const std::string& filename)
+{
+	const std::size_t index{ addImage(id) };
+	ResourceUsage& usage{ m_images.access(index).usage };
+	usage.filename = filename;
+	usage.isUnloaded = true;
+	return index;
+}
+
+inline std::size_t ResourceManagerBasic::addLazyTexture(const std::string& id, const std::string& filename)
+{
+	const std::size_t index{ addTexture(id) };
+	ResourceUsage& usage{ m_textures.access(index).usage };
+	usage.filename = filename;
+	usage.isUnloaded = true;
+	return index;
+}
+
+inline std::size_t ResourceManagerBasic::addLazySoundBuffer(const std::string& id, const std::string& filename)
+{
+	const std::size_t index{ addSoundBuffer(id) };
+	ResourceUsage& usage{ m_soundBuffers.access(index).usage };
+	usage.filename = filename;
+	usage.isUnloaded = true;
+	return index;
+}
+
+inline void ResourceManagerBasic::prefetchFont(const std::string& fontId)
+{
+	const std::size_t index{ m_fonts.find(fontId) };
+	if (!m_fonts.valid(index))
+		throw Exception(m_resourceManagerExceptionPrefix + "Invalid font ID.");
+	priv_prefetch(ResourceType::Font, index, m_fonts.access(index).usage);
+}
+
+inline void ResourceManagerBasic::prefetchFont(const std::size_t fontIndex)
+{
+	if (!m_fonts.valid(fontIndex))
+		throw Exception(m_resourceManagerExceptionPrefix + "Invalid font index.");
+	priv_prefetch(ResourceType::Font, fontIndex, m_fonts.access(fontIndex).usage);
+}
+
+inline void ResourceManagerBasic::prefetchImage(const std::string& imageId)
+{
+	const std::size_t index{ m_images.find(imageId) };
+	if (!m_images.valid(index))
+		throw Exception(m_resourceManagerExceptionPrefix + "Invalid image ID.");
+	priv_prefetch(ResourceType::Image, index, m_images.access(index).usage);
+}
+
+inline void ResourceManagerBasic::prefetchImage(const std::size_t imageIndex)
+{
+	if (!m_images.valid(imageIndex))
+		throw Exception(m_resourceManagerExceptionPrefix + "Invalid image index.");
+	priv_prefetch(ResourceType::Image, imageIndex, m_images.access(imageIndex).usage);
+}
+
+inline void ResourceManagerBasic::prefetchTexture(const std::string& textureId)
+{
+	const std::size_t index{ m_textures.find(textureId) };
+	if (!m_textures.valid(index))
+		throw Exception(m_resourceManagerExceptionPrefix + "Invalid texture ID.");
+	priv_prefetch(ResourceType::Texture, index, m_textures.access(index).usage);
+}
+
+inline void ResourceManagerBasic::prefetchTexture(const std::size_t textureIndex)
+{
+	if (!m_textures.valid(textureIndex))
+		throw Exception(m_resourceManagerExceptionPrefix + "Invalid texture index.");
+	priv_prefetch(ResourceType::Texture, textureIndex, m_textures.access(textureIndex).usage);
+}
+
+inline void ResourceManagerBasic::prefetchSoundBuffer(const std::string& soundBufferId)
+{
+	const std::size_t index{ m_soundBuffers.find(soundBufferId) };
+	if (!m_soundBuffers.valid(index))
+		throw Exception(m_resourceManagerExceptionPrefix + "Invalid sound buffer ID.");
+	priv_prefetch(ResourceType::SoundBuffer, index, m_soundBuffers.access(index).usage);
+}
+
+inline void ResourceManagerBasic::prefetchSoundBuffer(const std::size_t soundBufferIndex)
+{
+	if (!m_soundBuffers.valid(soundBufferIndex))
+		throw Exception(m_resourceManagerExceptionPrefix + "Invalid sound buffer index.");
+	priv_prefetch(ResourceType::SoundBuffer, soundBufferIndex, m_soundBuffers.access(soundBufferIndex).usage);
+}
+
+inline bool ResourceManagerBasic::isFontLoaded(const std::string& fontId) const
+{
+	const std::size_t index{ m_fonts.find(fontId) };
+	return m_fonts.valid(index) && !m_fonts.access(index).usage.isUnloaded;
+}
+
+inline bool ResourceManagerBasic::isImageLoaded(const std::string& imageId) const
+{
+	const std::size_t index{ m_images.find(imageId) };
+	return m_images.valid(index) && !m_images.access(index).usage.isUnloaded;
+}
+
+inline bool ResourceManagerBasic::isTextureLoaded(const std::string& textureId) const
+{
+	const std::size_t index{ m_textures.find(textureId) };
+	return m_textures.valid(index) && !m_textures.access(index).usage.isUnloaded;
+}
+
+inline bool ResourceManagerBasic::isSoundBufferLoaded(const std::string& soundBufferId) const
+{
+	const std::size_t index{ m_soundBuffers.find(soundBufferId) };
+	return m_soundBuffers.valid(index) && !m_soundBuffers.access(index).usage.isUnloaded;
+}
+
+inline void ResourceManagerBasic::setMemoryBudget(const std::size_t memoryBudget)
+{
+	m_memoryBudget = memoryBudget;
+	enforceMemoryBudget();
+}
+
+inline std::size_t ResourceManagerBasic::getMemoryBudget() const
+{
+	return m_memoryBudget;
+}
+
+inline std::size_t ResourceManagerBasic::getMemoryUsage() const
+{
+	return m_memoryUsage;
+}
+
+inline void ResourceManagerBasic::enforceMemoryBudget()
+{
+	if (m_memoryBudget == 0_uz)
+		return;
+
+	// the most recently used resource is never evicted (it is the one being used or loaded)
+	auto isEvictable = [this](const ResourceUsage& usage)
+	{
+		return !usage.isUnloaded && !usage.filename.empty() && (usage.memory > 0_uz) && (usage.referenceAnchor.use_count() == 1l) && (usage.numberOfSharers == 0_uz) && (usage.lastUsed < m_usageCounter);
+	};
+	while (m_memoryUsage > m_memoryBudget)
+	{
+		ResourceUsage* leastRecentlyUsed{ nullptr };
+		Resource<sf::Image>* image{ nullptr };
+		Resource<sf::Texture>* texture{ nullptr };
+		Resource<sf::SoundBuffer>* soundBuffer{ nullptr };
+		auto isLessRecentlyUsed = [&leastRecentlyUsed](const ResourceUsage& usage)
+		{
+			return (leastRecentlyUsed == nullptr) || (usage.lastUsed < leastRecentlyUsed->lastUsed);
+		};
+		for (std::size_t i{ 0_uz }; i < m_images.getSize(); ++i)
+		{
+			Resource<sf::Image>& resource{ m_images.access(i) };
+			if (isEvictable(resource.usage) && isLessRecentlyUsed(resource.usage))
+			{
+				leastRecentlyUsed = &resource.usage;
+				image = &resource;
+			}
+		}
+		for (std::size_t i{ 0_uz }; i < m_textures.getSize(); ++i)
+		{
+			Resource<sf::Texture>& resource{ m_textures.access(i) };
+			if (isEvictable(resource.usage) && isLessRecentlyUsed(resource.usage))
+			{
+				leastRecentlyUsed = &resource.usage;
+				texture = &resource;
+			}
+		}
+		for (std::size_t i{ 0_uz }; i < m_soundBuffers.getSize(); ++i)
+		{
+			Resource<sf::SoundBuffer>& resource{ m_soundBuffers.access(i) };
+			if (isEvictable(resource.usage) && isLessRecentlyUsed(resource.usage))
+			{
+				leastRecentlyUsed = &resource.usage;
+				soundBuffer = &resource;
+			}
+		}
+
+		if (leastRecentlyUsed == nullptr)
+			break;
+		else if ((soundBuffer != nullptr) && (leastRecentlyUsed == &soundBuffer->usage))
+			priv_evict(*soundBuffer);
+		else if ((texture != nullptr) && (leastRecentlyUsed == &texture->usage))
+			priv_evict(*texture);
+		else
+			priv_evict(*image);
+	}
+}
+
+inline std::shared_ptr<sf::Image> ResourceManagerBasic::holdImage(const std::string& imageId)
+{
+	const std::size_t index{ m_images.find(imageId) };
+	if (m_images.valid(index))
+		return priv_hold(m_images.access(index));
+	else
+		throw Exception(m_resourceManagerExceptionPrefix + "Image not available.");
+}
+
+inline std::shared_ptr<sf::Image> ResourceManagerBasic::holdImage(const std::size_t imageIndex)
+{
+	if (m_images.valid(imageIndex))
+		return priv_hold(m_images.access(imageIndex));
+	else
+		throw Exception(m_resourceManagerExceptionPrefix + "Image not available.");
+}
+
+inline std::shared_ptr<sf::Texture> ResourceManagerBasic::holdTexture(const std::string& textureId)
+{
+	const std::size_t index{ m_textures.find(textureId) };
+	if (m_textures.valid(index))
+		return priv_hold(m_textures.access(index));
+	else
+		throw Exception(m_resourceManagerExceptionPrefix + "Texture not available.");
+}
+
+inline std::shared_ptr<sf::Texture> ResourceManagerBasic::holdTexture(const std::size_t textureIndex)
+{
+	if (m_textures.valid(textureIndex))
+		return priv_hold(m_textures.access(textureIndex));
+	else
+		throw Exception(m_resourceManagerExceptionPrefix + "Texture not available.");
+}
+
+inline std::shared_ptr<sf::SoundBuffer> ResourceManagerBasic::holdSoundBuffer(const std::string& soundBufferId)
+{
+	const std::size_t index{ m_soundBuffers.find(soundBufferId) };
+	if (m_soundBuffers.valid(index))
+		return priv_hold(m_soundBuffers.access(index));
+	else
+		throw Exception(m_resourceManagerExceptionPrefix + "SoundBuffer not available.");
+}
+
+inline std::shared_ptr<sf::SoundBuffer> ResourceManagerBasic::holdSoundBuffer(const std::size_t soundBufferIndex)
+{
+	if (m_soundBuffers.valid(soundBufferIndex))
+		return priv_hold(m_soundBuffers.access(soundBufferIndex));
+	else
+		throw Exception(m_resourceManagerExceptionPrefix + "SoundBuffer not available.");
+}
+
+inline void ResourceManagerBasic::prewarmFont(const std::string& fontId, const std::vector<unsigned int>& characterSizes, const std::u32string& codePoints, const bool bold, const float outlineThickness)
+{
+	const sf::Font& font{ getFont(fontId) };
+	for (const unsigned int characterSize : characterSizes)
+	{
+		for (const char32_t codePoint : codePoints)
+			font.getGlyph(codePoint, characterSize, bold, outlineThickness);
+	}
+}
+
+inline void ResourceManagerBasic::prewarmFont(const std::size_t fontIndex, const std::vector<unsigned int>& characterSizes, const std::u32string& codePoints, const bool bold, const float outlineThickness)
+{
+	const sf::Font& font{ getFont(fontIndex) };
+	for (const unsigned int characterSize : characterSizes)
+	{
+		for (const char32_t codePoint : codePoints)
+			font.getGlyph(codePoint, characterSize, bold, outlineThickness);
+	}
+}
+
+inline void ResourceManagerBasic::queueFontPrewarm(const std::string& fontId, const std::vector<unsigned int>& characterSizes, const std::u32string& codePoints, const bool bold, const float outlineThickness)
+{
+	priv_queueFontPrewarm(getFontHandle(fontId), characterSizes, codePoints, bold, outlineThickness);
+}
+
+inline void ResourceManagerBasic::queueFontPrewarm(const std::size_t fontIndex, const std::vector<unsigned int>& characterSizes, const std::u32string& codePoints, const bool bold, const float outlineThickness)
+{
+	priv_queueFontPrewarm(getFontHandle(fontIndex), characterSizes, codePoints, bold, outlineThickness);
+}
+
+inline std::size_t ResourceManagerBasic::processFontPrewarming(const sf::Time timeBudget)
+{
+	const sf::Clock clock{};
+	while (!m_fontPrewarms.empty())
+	{
+		FontPrewarm& fontPrewarm{ m_fontPrewarms.front() };
+		const std::size_t numberOfGlyphs{ fontPrewarm.characterSizes.size() * fontPrewarm.codePoints.size() };
+		if (!m_fonts.valid(fontPrewarm.font))
+		{
+			// font was removed
+			m_numberOfQueuedPrewarmGlyphs -= numberOfGlyphs - fontPrewarm.numberOfGlyphsRasterised;
+			m_fontPrewarms.pop_front();
+			continue;
+		}
+		const sf::Font& font{ getFont(fontPrewarm.font) };
+		while (fontPrewarm.numberOfGlyphsRasterised < numberOfGlyphs)
+		{
+			const std::size_t characterSizeIndex{ fontPrewarm.numberOfGlyphsRasterised / fontPrewarm.codePoints.size() };
+			const std::size_t codePointIndex{ fontPrewarm.numberOfGlyphsRasterised % fontPrewarm.codePoints.size() };
+			font.getGlyph(fontPrewarm.codePoints[codePointIndex], fontPrewarm.characterSizes[characterSizeIndex], fontPrewarm.bold, fontPrewarm.outlineThickness);
+			++fontPrewarm.numberOfGlyphsRasterised;
+			--m_numberOfQueuedPrewarmGlyphs;
+			if ((timeBudget != sf::Time::Zero) && (clock.getElapsedTime() >= timeBudget))
+			{
+				if (fontPrewarm.numberOfGlyphsRasterised == numberOfGlyphs)
+					m_fontPrewarms.pop_front();
+				return m_numberOfQueuedPrewarmGlyphs;
+			}
+		}
+		m_fontPrewarms.pop_front();
+	}
+	return m_numberOfQueuedPrewarmGlyphs;
+}
+
+inline std::size_t ResourceManagerBasic::getNumberOfQueuedPrewarmGlyphs() const
+{
+	return m_numberOfQueuedPrewarmGlyphs;
+}
+
+inline void ResourceManagerBasic::setDeduplication(const bool deduplication)
+{
+	m_deduplication = deduplication;
+}
+
+inline bool ResourceManagerBasic::getDeduplication() const
+{
+	return m_deduplication;
+}
+
+inline ResourceManagerBasic::DeduplicationStatistics ResourceManagerBasic::getDeduplicationStatistics() const
+{
+	DeduplicationStatistics statistics{};
+	for (std::size_t i{ 0_uz }; i < m_images.getSize(); ++i)
+	{
+		const Resource<sf::Image>& image{ m_images.access(i) };
+		if (image.shared == nullptr)
+			continue;
+		++statistics.numberOfSharedImages;
+		statistics.memorySaved += priv_getMemory(image.shared->resource);
+	}
+	for (std::size_t i{ 0_uz }; i < m_textures.getSize(); ++i)
+	{
+		const Resource<sf::Texture>& texture{ m_textures.access(i) };
+		if (texture.shared == nullptr)
+			continue;
+		++statistics.numberOfSharedTextures;
+		statistics.memorySaved += priv_getMemory(texture.shared->resource);
+	}
+	return statistics;
+}
+
+inline ResourceManagerBasic::Statistics ResourceManagerBasic::getStatistics() const
+{
+	Statistics statistics{ m_statistics };
+	auto addMemory = [](ResourceStatistics& resourceStatistics, const ResourceUsage& usage)
+	{
+		if (!usage.isUnloaded)
+			resourceStatistics.memory += usage.memory;
+	};
+	for (std::size_t i{ 0_uz }; i < m_images.getSize(); ++i)
+		addMemory(statistics.images, m_images.access(i).usage);
+	for (std::size_t i{ 0_uz }; i < m_textures.getSize(); ++i)
+		addMemory(statistics.textures, m_textures.access(i).usage);
+	for (std::size_t i{ 0_uz }; i < m_soundBuffers.getSize(); ++i)
+		addMemory(statistics.soundBuffers, m_soundBuffers.access(i).usage);
+	return statistics;
+}
+
+inline void ResourceManagerBasic::resetStatistics()
+{
+	m_statistics = Statistics{};
+}
+
+inline std::string ResourceManagerBasic::getStatisticsAsJson() const
+{
+	const Statistics statistics{ getStatistics() };
+	std::ostringstream json;
+	json << "{\n";
+	auto addResourceStatistics = [&json](const std::string& name, const ResourceStatistics& resourceStatistics, const bool isLast)
+	{
+		json << "\t\"" << name << "\": {\n"
+			<< "\t\t\"numberOfLoads\": " << resourceStatistics.numberOfLoads << ",\n"
+			<< "\t\t\"numberOfFailedLoads\": " << resourceStatistics.numberOfFailedLoads << ",\n"
+			<< "\t\t\"decodeTime\": " << resourceStatistics.decodeTime << ",\n"
+			<< "\t\t\"maximumDecodeTime\": " << resourceStatistics.maximumDecodeTime << ",\n"
+			<< "\t\t\"uploadTime\": " << resourceStatistics.uploadTime << ",\n"
+			<< "\t\t\"maximumUploadTime\": " << resourceStatistics.maximumUploadTime << ",\n"
+			<< "\t\t\"memory\": " << resourceStatistics.memory << ",\n"
+			<< "\t\t\"numberOfLookupsById\": " << resourceStatistics.numberOfLookupsById << ",\n"
+			<< "\t\t\"numberOfLookupsByIndex\": " << resourceStatistics.numberOfLookupsByIndex << ",\n"
+			<< "\t\t\"numberOfLookupsByHandle\": " << resourceStatistics.numberOfLookupsByHandle << ",\n"
+			<< "\t\t\"numberOfFailedLookups\": " << resourceStatistics.numberOfFailedLookups << "\n"
+			<< "\t}" << (isLast ? "\n" : ",\n");
+	};
+	addResourceStatistics("fonts", statistics.fonts, false);
+	addResourceStatistics("images", statistics.images, false);
+	addResourceStatistics("textures", statistics.textures, false);
+	addResourceStatistics("soundBuffers", statistics.soundBuffers, true);
+	json << "}\n";
+	return json.str();
+}
+
+inline std::string ResourceManagerBasic::getStatisticsAsCsv() const
+{
+	const Statistics statistics{ getStatistics() };
+	std::ostringstream csv;
+	csv << "type,numberOfLoads,numberOfFailedLoads,decodeTime,maximumDecodeTime,uploadTime,maximumUploadTime,memory,numberOfLookupsById,numberOfLookupsByIndex,numberOfLookupsByHandle,numberOfFailedLookups\n";
+	auto addResourceStatistics = [&csv](const std::string& name, const ResourceStatistics& resourceStatistics)
+	{
+		csv << name << ","
+			<< resourceStatistics.numberOfLoads << ","
+			<< resourceStatistics.numberOfFailedLoads << ","
+			<< resourceStatistics.decodeTime << ","
+			<< resourceStatistics.maximumDecodeTime << ","
+			<< resourceStatistics.uploadTime << ","
+			<< resourceStatistics.maximumUploadTime << ","
+			<< resourceStatistics.memory << ","
+			<< resourceStatistics.numberOfLookupsById << ","
+			<< resourceStatistics.numberOfLookupsByIndex << ","
+			<< resourceStatistics.numberOfLookupsByHandle << ","
+			<< resourceStatistics.numberOfFailedLookups << "\n";
+	};
+	addResourceStatistics("fonts", statistics.fonts);
+	addResourceStatistics("images", statistics.images);
+	addResourceStatistics("textures", statistics.textures);
+	addResourceStatistics("soundBuffers", statistics.soundBuffers);
+	return csv.str();
+}
+
+inline bool ResourceManagerBasic::saveStatisticsAsJson(const std::string& filename) const
+{
+	std::ofstream file(filename, std::ios::binary);
+	if (!file)
+		return false;
+	file << getStatisticsAsJson();
+	return static_cast<bool>(file);
+}
+
+inline bool ResourceManagerBasic::saveStatisticsAsCsv(const std::string& filename) const
+{
+	std::ofstream file(filename, std::ios::binary);
+	if (!file)
+		return false;
+	file << getStatisticsAsCsv();
+	return static_cast<bool>(file);
+}
+
+inline void ResourceManagerBasic::mountResourcePack(const std::string& packFilename, const std::string& mountPath)
+{
+	// async loads already queued keep using the pack that was mounted when they were queued
+	std::shared_ptr<MountedResourcePack> resourcePack{ std::make_shared<MountedResourcePack>() };
+	if (!resourcePack->pack.open(packFilename))
+		throw Exception(m_resourceManagerExceptionPrefix + "Cannot open resource pack.");
+	resourcePack->mountPath = mountPath;
+	m_resourcePack = std::move(resourcePack);
+}
+
+inline void ResourceManagerBasic::unmountResourcePack()
+{
+	// the pack is closed when no queued async loads are using it
+	m_resourcePack.reset();
+}
+
+inline bool ResourceManagerBasic::isResourcePackMounted() const
+{
+	return static_cast<bool>(m_resourcePack);
+}
+
+inline void ResourceManagerBasic::setHotReload(const bool hotReload)
+{
+	if (hotReload == m_hotReload)
+		return;
+	m_hotReload = hotReload;
+	m_hotReloadDirectories.clear();
+	m_hotReloadChangedFiles.clear();
+#ifdef __linux__
+	if (m_hotReloadFileDescriptor >= 0)
+	{
+		::close(m_hotReloadFileDescriptor); // also removes all of its watches
+		m_hotReloadFileDescriptor = -1;
+	}
+	if (m_hotReload)
+		m_hotReloadFileDescriptor = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+#endif // __linux__
+	if (m_hotReload)
+		priv_watchAllFiles();
+}
+
+inline bool ResourceManagerBasic::getHotReload() const
+{
+	return m_hotReload;
+}
+
+inline void ResourceManagerBasic::setHotReloadDelay(const sf::Time hotReloadDelay)
+{
+	m_hotReloadDelay = hotReloadDelay;
+}
+
+inline sf::Time ResourceManagerBasic::getHotReloadDelay() const
+{
+	return m_hotReloadDelay;
+}
+
+inline void ResourceManagerBasic::setNumberOfAsyncLoadingThreads(const std::size_t numberOfThreads)
+{
+	m_numberOfAsyncLoadingThreads = numberOfThreads;
+	if (m_numberOfPendingAsyncLoads == 0_uz)
+		m_asyncLoadingPool.reset(); // recreated with the new number of threads when next required
+}
+
+inline std::future<void> ResourceManagerBasic::openFontAsync(const std::string& id, const std::string& filename)
+{
+	const std::size_t index{ m_fonts.find(id) };
+	if (!m_fonts.valid(index))
+		throw Exception(m_resourceManagerExceptionPrefix + "Invalid font ID.");
+	return priv_addAsyncLoad(ResourceType::Font, index, filename);
+}
+
+inline std::future<void> ResourceManagerBasic::openFontAsync(const std::size_t index, const std::string& filename)
+{
+	if (!m_fonts.valid(index))
+		throw Exception(m_resourceManagerExceptionPrefix + "Invalid font index.");
+	return priv_addAsyncLoad(ResourceType::Font, index, filename);
+}
+
+inline std::future<void> ResourceManagerBasic::loadImageAsync(const std::string& id, const std::string& filename)
+{
+	const std::size_t index{ m_images.find(id) };
+	if (!m_images.valid(index))
+		throw Exception(m_resourceManagerExceptionPrefix + "Invalid image ID.");
+	return priv_addAsyncLoad(ResourceType::Image, index, filename);
+}
+
+inline std::future<void> ResourceManagerBasic::loadImageAsync(const std::size_t index, const std::string& filename)
+{
+	if (!m_images.valid(index))
+		throw Exception(m_resourceManagerExceptionPrefix + "Invalid image index.");
+	return priv_addAsyncLoad(ResourceType::Image, index, filename);
+}
+
+inline std::future<void> ResourceManagerBasic::loadTextureAsync(const std::string& id, const std::string& filename)
+{
+	const std::size_t index{ m_textures.find(id) };
+	if (!m_textures.valid(index))
+		throw Exception(m_resourceManagerExceptionPrefix + "Invalid texture ID.");
+	return priv_addAsyncLoad(ResourceType::Texture, index, filename);
+}
+
+inline std::future<void> ResourceManagerBasic::loadTextureAsync(const std::size_t index, const std::string& filename)
+{
+	if (!m_textures.valid(index))
+		throw Exception(m_resourceManagerExceptionPrefix + "Invalid texture index.");
+	return priv_addAsyncLoad(ResourceType::Texture, index, filename);
+}
+
+inline std::future<void> ResourceManagerBasic::loadSoundBufferAsync(const std::string& id, const std::string& filename)
+{
+	const std::size_t index{ m_soundBuffers.find(id) };
+	if (!m_soundBuffers.valid(index))
+		throw Exception(m_resourceManagerExceptionPrefix + "Invalid sound buffer ID.");
+	return priv_addAsyncLoad(ResourceType::SoundBuffer, index, filename);
+}
+
+inline std::future<void> ResourceManagerBasic::loadSoundBufferAsync(const std::size_t index, const std::string& filename)
+{
+	if (!m_soundBuffers.valid(index))
+		throw Exception(m_resourceManagerExceptionPrefix + "Invalid sound buffer index.");
+	return priv_addAsyncLoad(ResourceType::SoundBuffer, index, filename);
+}
+
+inline std::size_t ResourceManagerBasic::processAsyncLoads(const sf::Time timeBudget)
+{
+	const sf::Clock clock{};
+	if (m_hotReload)
+		priv_processHotReload();
+	while (true)
+	{
+		std::shared_ptr<AsyncLoad> asyncLoad;
+		{
+			std::lock_guard<std::mutex> lock(m_completedAsyncLoadsMutex);
+			if (m_completedAsyncLoads.empty())
+				break;
+			asyncLoad = m_completedAsyncLoads.front();
+			m_completedAsyncLoads.pop_front();
+		}
+		priv_applyAsyncLoad(*asyncLoad);
+		--m_numberOfPendingAsyncLoads;
+		if ((timeBudget != sf::Time::Zero) && (clock.getElapsedTime() >= timeBudget))
+			break;
+	}
+	if ((m_numberOfPendingAsyncLoads == 0_uz) && m_asyncLoadingPool)
+	{
+		// a number of threads set while loads were pending is applied now (the pool is recreated when next required)
+		std::size_t numberOfThreads{ (m_numberOfAsyncLoadingThreads == 0_uz) ? static_cast<std::size_t>(std::thread::hardware_concurrency()) : m_numberOfAsyncLoadingThreads };
+		if (numberOfThreads == 0_uz)
+			numberOfThreads = 1_uz;
+		if (numberOfThreads != m_asyncLoadingPool->getNumberOfThreads())
+			m_asyncLoadingPool.reset();
+	}
+	return m_numberOfPendingAsyncLoads;
+}
+
+inline std::size_t ResourceManagerBasic::getNumberOfPendingAsyncLoads() const
+{
+	return m_numberOfPendingAsyncLoads;
+}
+
+// PRIVATE
+inline std::future<void> ResourceManagerBasic::priv_addAsyncLoad(const ResourceType type, const std::size_t index, const std::string& filename, const bool isPrefetch)
+{
+	if (!m_asyncLoadingPool)
+		m_asyncLoadingPool.reset(new ThreadPool(m_numberOfAsyncLoadingThreads));
+
+	std::shared_ptr<AsyncLoad> asyncLoad{ std::make_shared<AsyncLoad>() };
+	asyncLoad->type = type;
+	switch (type)
+	{
+	case ResourceType::Font:
+		asyncLoad->fontHandle = m_fonts.getHandle(index);
+		break;
+	case ResourceType::Image:
+		asyncLoad->imageHandle = m_images.getHandle(index);
+		break;
+	case ResourceType::Texture:
+		asyncLoad->textureHandle = m_textures.getHandle(index);
+		break;
+	case ResourceType::SoundBuffer:
+		asyncLoad->soundBufferHandle = m_soundBuffers.getHandle(index);
+		break;
+	}
+	asyncLoad->filename = filename;
+	asyncLoad->isPrefetch = isPrefetch;
+	asyncLoad->resourcePack = m_resourcePack;
+	std::future<void> future{ asyncLoad->promise.get_future() };
+	++m_numberOfPendingAsyncLoads;
+
+	m_asyncLoadingPool->add([this, asyncLoad]()
+	{
+		const InstrumentationTimer timer{};
+		try
+		{
+			switch (asyncLoad->type)
+			{
+			case ResourceType::Font:
+				asyncLoad->isLoaded = priv_loadFromFile(asyncLoad->font, asyncLoad->filename, asyncLoad->resourcePack.get());
+				break;
+			case ResourceType::Image:
+			case ResourceType::Texture:
+				asyncLoad->isLoaded = priv_loadFromFile(asyncLoad->image, asyncLoad->filename, asyncLoad->resourcePack.get());
+				break;
+			case ResourceType::SoundBuffer:
+				asyncLoad->isLoaded = priv_loadFromFile(asyncLoad->soundBuffer, asyncLoad->filename, asyncLoad->resourcePack.get());
+				break;
+			}
+		}
+		catch (...)
+		{
+			// the load must always be queued so that it is counted as completed and its future becomes ready (holding the failure)
+			asyncLoad->isLoaded = false;
+		}
+		asyncLoad->decodeTime = timer.getSeconds();
+		std::lock_guard<std::mutex> lock(m_completedAsyncLoadsMutex);
+		m_completedAsyncLoads.push_back(asyncLoad);
+	});
+	return future;
+}
+
+inline void ResourceManagerBasic::priv_applyAsyncLoad(AsyncLoad& asyncLoad)
+{
+	priv_recordLoad(asyncLoad.type, asyncLoad.isLoaded, asyncLoad.decodeTime);
+	if (asyncLoad.isPrefetch)
+	{
+		// a prefetch only loads what is still waiting for it. if the resource has been loaded (e.g. accessed) or given another file since, its result is dropped rather than overwriting the resource
+		ResourceUsage* const usage{ priv_getUsage(asyncLoad) };
+		if ((usage == nullptr) || !usage->isUnloaded || !usage->isPrefetching || (usage->filename != asyncLoad.filename))
+		{
+			if ((usage != nullptr) && usage->isUnloaded)
+				usage->isPrefetching = false; // allows the resource to be prefetched again
+			asyncLoad.promise.set_value();
+			return;
+		}
+	}
+	try
+	{
+		switch (asyncLoad.type)
+		{
+		case ResourceType::Font:
+			if (!m_fonts.valid(asyncLoad.fontHandle))
+				throw Exception(m_resourceManagerExceptionPrefix + "Invalid font ID.");
+			else if (!asyncLoad.isLoaded)
+				throw Exception(m_resourceManagerExceptionPrefix + "Cannot open font.");
+			m_fonts.access(asyncLoad.fontHandle).resource = std::move(asyncLoad.font);
+			priv_updateUsage(m_fonts.access(asyncLoad.fontHandle), asyncLoad.filename);
+			break;
+		case ResourceType::Image:
+			if (!m_images.valid(asyncLoad.imageHandle))
+				throw Exception(m_resourceManagerExceptionPrefix + "Invalid image ID.");
+			else if (!asyncLoad.isLoaded)
+				throw Exception(m_resourceManagerExceptionPrefix + "Cannot load image.");
+			priv_setImage(m_images.access(asyncLoad.imageHandle), std::move(asyncLoad.image));
+			priv_updateUsage(m_images.access(asyncLoad.imageHandle), asyncLoad.filename);
+			break;
+		case ResourceType::Texture:
+			if (!m_textures.valid(asyncLoad.textureHandle))
+				throw Exception(m_resourceManagerExceptionPrefix + "Invalid texture ID.");
+			else if (!asyncLoad.isLoaded)
+				throw Exception(m_resourceManagerExceptionPrefix + "Cannot load texture.");
+			else if (!priv_setTexture(m_textures.access(asyncLoad.textureHandle), asyncLoad.image))
+				throw Exception(m_resourceManagerExceptionPrefix + "Cannot load texture.");
+			priv_updateUsage(m_textures.access(asyncLoad.textureHandle), asyncLoad.filename);
+			break;
+		case ResourceType::SoundBuffer:
+			if (!m_soundBuffers.valid(asyncLoad.soundBufferHandle))
+				throw Exception(m_resourceManagerExceptionPrefix + "Invalid sound buffer ID.");
+			else if (!asyncLoad.isLoaded)
+				throw Exception(m_resourceManagerExceptionPrefix + "Cannot load sound buffer.");
+			m_soundBuffers.access(asyncLoad.soundBufferHandle).resource = std::move(asyncLoad.soundBuffer);
+			priv_updateUsage(m_soundBuffers.access(asyncLoad.soundBufferHandle), asyncLoad.filename);
+			break;
+		}
+	}
+	catch (...)
+	{
+		ResourceUsage* const usage{ asyncLoad.isPrefetch ? priv_getUsage(asyncLoad) : nullptr };
+		if (usage != nullptr)
+			usage->isPrefetching = false; // allows the failed prefetch to be requested again
+		asyncLoad.promise.set_exception(std::current_exception());
+		return;
+	}
+	asyncLoad.promise.set_value();
+}
+
+template <class T>
+inline T& ResourceManagerBasic::priv_use(Resource<T>& resource)
+{
+	resource.usage.lastUsed = ++m_usageCounter;
+	if (resource.usage.isUnloaded)
+	{
+		if (!priv_load(resource, resource.usage.filename))
+			throw Exception(m_resourceManagerExceptionPrefix + "Cannot load resource from file.");
+		priv_updateUsage(resource, resource.usage.filename);
+	}
+	if (resource.shared != nullptr)
+		return priv_use(*resource.shared);
+	return resource.resource;
+}
+
+template <class T>
+inline void ResourceManagerBasic::priv_updateUsage(Resource<T>& resource, const std::string& filename)
+{
+	const std::size_t memory{ priv_getMemory(resource.resource) };
+	m_memoryUsage -= resource.usage.isUnloaded ? 0_uz : resource.usage.memory;
+	m_memoryUsage += memory;
+	resource.usage.filename = filename;
+	resource.usage.memory = memory;
+	resource.usage.isUnloaded = false;
+	resource.usage.isPrefetching = false;
+	resource.usage.lastUsed = ++m_usageCounter;
+	if (m_hotReload)
+		priv_watchFile(filename);
+	enforceMemoryBudget();
+}
+
+template <class T>
+inline std::shared_ptr<T> ResourceManagerBasic::priv_hold(Resource<T>& resource)
+{
+	T& heldResource{ priv_use(resource) };
+	const Resource<T>& owner{ (resource.shared != nullptr) ? *resource.shared : resource }; // holding shared content holds the resource that owns it
+	return std::shared_ptr<T>(owner.usage.referenceAnchor, &heldResource);
+}
+
+inline void ResourceManagerBasic::priv_prefetch(const ResourceType type, const std::size_t index, ResourceUsage& usage)
+{
+	if (!usage.isUnloaded || usage.isPrefetching || usage.filename.empty())
+		return;
+	usage.isPrefetching = true;
+	priv_addAsyncLoad(type, index, usage.filename, true);
+}
+
+inline ResourceManagerBasic::ResourceUsage* ResourceManagerBasic::priv_getUsage(const AsyncLoad& asyncLoad)
+{
+	switch (asyncLoad.type)
+	{
+	case ResourceType::Font:
+		return m_fonts.valid(asyncLoad.fontHandle) ? &m_fonts.access(asyncLoad.fontHandle).usage : nullptr;
+	case ResourceType::Image:
+		return m_images.valid(asyncLoad.imageHandle) ? &m_images.access(asyncLoad.imageHandle).usage : nullptr;
+	case ResourceType::Texture:
+		return m_textures.valid(asyncLoad.textureHandle) ? &m_textures.access(asyncLoad.textureHandle).usage : nullptr;
+	case ResourceType::SoundBuffer:
+		return m_soundBuffers.valid(asyncLoad.soundBufferHandle) ? &m_soundBuffers.access(asyncLoad.soundBufferHandle).usage : nullptr;
+	}
+	return nullptr;
+}
+
+inline ResourceManagerBasic::InstrumentationTimer::InstrumentationTimer()
+#ifdef PLINTH_RESOURCE_MANAGER_INSTRUMENTATION
+	: m_start{ std::chrono::steady_clock::now() }
+#else // PLINTH_RESOURCE_MANAGER_INSTRUMENTATION
+	: m_start{}
+#endif // PLINTH_RESOURCE_MANAGER_INSTRUMENTATION
+{
+}
+
+inline double ResourceManagerBasic::InstrumentationTimer::getSeconds() const
+{
+#ifdef PLINTH_RESOURCE_MANAGER_INSTRUMENTATION
+	return std::chrono::duration<double>(std::chrono::steady_clock::now() - m_start).count();
+#else // PLINTH_RESOURCE_MANAGER_INSTRUMENTATION
+	return 0.0;
+#endif // PLINTH_RESOURCE_MANAGER_INSTRUMENTATION
+}
+
+inline void ResourceManagerBasic::priv_recordLookup(const ResourceType type, const LookupType lookupType, const bool isFound)
+{
+#ifdef PLINTH_RESOURCE_MANAGER_INSTRUMENTATION
+	ResourceStatistics& resourceStatistics{ (type == ResourceType::Font) ? m_statistics.fonts : (type == ResourceType::Image) ? m_statistics.images : (type == ResourceType::Texture) ? m_statistics.textures : m_statistics.soundBuffers };
+	switch (lookupType)
+	{
+	case LookupType::Id:
+		++resourceStatistics.numberOfLookupsById;
+		break;
+	case LookupType::Index:
+		++resourceStatistics.numberOfLookupsByIndex;
+		break;
+	case LookupType::Handle:
+		++resourceStatistics.numberOfLookupsByHandle;
+		break;
+	}
+	if (!isFound)
+		++resourceStatistics.numberOfFailedLookups;
+#else // PLINTH_RESOURCE_MANAGER_INSTRUMENTATION
+	static_cast<void>(type);
+	static_cast<void>(lookupType);
+	static_cast<void>(isFound);
+#endif // PLINTH_RESOURCE_MANAGER_INSTRUMENTATION
+}
+
+inline void ResourceManagerBasic::priv_recordLoad(const ResourceType type, const bool isLoaded, const double decodeTime)
+{
+#ifdef PLINTH_RESOURCE_MANAGER_INSTRUMENTATION
+	ResourceStatistics& resourceStatistics{ (type == ResourceType::Font) ? m_statistics.fonts : (type == ResourceType::Image) ? m_statistics.images : (type == ResourceType::Texture) ? m_statistics.textures : m_statistics.soundBuffers };
+	++resourceStatistics.numberOfLoads;
+	if (!isLoaded)
+		++resourceStatistics.numberOfFailedLoads;
+	resourceStatistics.decodeTime += decodeTime;
+	resourceStatistics.maximumDecodeTime = std::max(resourceStatistics.maximumDecodeTime, decodeTime);
+#else // PLINTH_RESOURCE_MANAGER_INSTRUMENTATION
+	static_cast<void>(type);
+	static_cast<void>(isLoaded);
+	static_cast<void>(decodeTime);
+#endif // PLINTH_RESOURCE_MANAGER_INSTRUMENTATION
+}
+
+inline void ResourceManagerBasic::priv_recordUpload(const double uploadTime)
+{
+#ifdef PLINTH_RESOURCE_MANAGER_INSTRUMENTATION
+	m_statistics.textures.uploadTime += uploadTime;
+	m_statistics.textures.maximumUploadTime = std::max(m_statistics.textures.maximumUploadTime, uploadTime);
+#else // PLINTH_RESOURCE_MANAGER_INSTRUMENTATION
+	static_cast<void>(uploadTime);
+#endif // PLINTH_RESOURCE_MANAGER_INSTRUMENTATION
+}
+
+inline ResourceManagerBasic::ResourceType ResourceManagerBasic::priv_getType(const sf::Font&)
+{
+	return ResourceType::Font;
+}
+
+inline ResourceManagerBasic::ResourceType ResourceManagerBasic::priv_getType(const sf::Image&)
+{
+	return ResourceType::Image;
+}
+
+inline ResourceManagerBasic::ResourceType ResourceManagerBasic::priv_getType(const sf::Texture&)
+{
+	return ResourceType::Texture;
+}
+
+inline ResourceManagerBasic::ResourceType ResourceManagerBasic::priv_getType(const sf::SoundBuffer&)
+{
+	return ResourceType::SoundBuffer;
+}
+
+inline void ResourceManagerBasic::priv_queueFontPrewarm(const FontHandle fontHandle, const std::vector<unsigned int>& characterSizes, const std::u32string& codePoints, const bool bold, const float outlineThickness)
+{
+	const std::size_t numberOfGlyphs{ characterSizes.size() * codePoints.size() };
+	if (numberOfGlyphs == 0_uz)
+		return;
+	FontPrewarm fontPrewarm{ fontHandle, characterSizes, codePoints, bold, outlineThickness };
+	m_fontPrewarms.push_back(std::move(fontPrewarm));
+	m_numberOfQueuedPrewarmGlyphs += numberOfGlyphs;
+}
+
+template <class T>
+inline bool ResourceManagerBasic::priv_load(Resource<T>& resource, const std::string& filename)
+{
+	const InstrumentationTimer timer{};
+	const bool isLoaded{ priv_loadFromFile(resource.resource, filename, m_resourcePack.get()) };
+	priv_recordLoad(priv_getType(resource.resource), isLoaded, timer.getSeconds());
+	return isLoaded;
+}
+
+inline bool ResourceManagerBasic::priv_load(Resource<sf::Image>& image, const std::string& filename)
+{
+	const InstrumentationTimer timer{};
+	sf::Image newImage{};
+	const bool isLoaded{ priv_loadFromFile(newImage, filename, m_resourcePack.get()) };
+	priv_recordLoad(ResourceType::Image, isLoaded, timer.getSeconds());
+	if (!isLoaded)
+		return false;
+	priv_setImage(image, std::move(newImage));
+	return true;
+}
+
+inline bool ResourceManagerBasic::priv_load(Resource<sf::Texture>& texture, const std::string& filename)
+{
+	const InstrumentationTimer timer{};
+	if (!m_deduplication || m_hotReload)
+	{
+		priv_detach(texture, m_textureContentHashes, m_textures, false);
+		const bool isLoaded{ priv_loadFromFile(texture.resource, filename, m_resourcePack.get()) };
+		priv_recordLoad(ResourceType::Texture, isLoaded, timer.getSeconds());
+		return isLoaded;
+	}
+	sf::Image image{}; // decoded first so that its pixels can be compared before uploading
+	const bool isLoaded{ priv_loadFromFile(image, filename, m_resourcePack.get()) };
+	priv_recordLoad(ResourceType::Texture, isLoaded, timer.getSeconds());
+	return isLoaded && priv_setTexture(texture, image);
+}
+
+inline void ResourceManagerBasic::priv_setImage(Resource<sf::Image>& image, sf::Image&& newImage)
+{
+	if (!m_deduplication || m_hotReload)
+		priv_detach(image, m_imageContentHashes, m_images, false);
+	else if (priv_deduplicate(image, newImage, m_imageContentHashes, m_images))
+		return;
+	image.resource = std::move(newImage);
+}
+
+inline bool ResourceManagerBasic::priv_setTexture(Resource<sf::Texture>& texture, const sf::Image& image)
+{
+	if (!m_deduplication || m_hotReload)
+		priv_detach(texture, m_textureContentHashes, m_textures, false);
+	else if (priv_deduplicate(texture, image, m_textureContentHashes, m_textures))
+		return true;
+	const InstrumentationTimer timer{};
+	const bool isUploaded{ texture.resource.loadFromImage(image) };
+	priv_recordUpload(timer.getSeconds());
+	if (isUploaded)
+		return true;
+	priv_detach(texture, m_textureContentHashes, m_textures, false);
+	return false;
+}
+
+template <class T>
+inline bool ResourceManagerBasic::priv_deduplicate(Resource<T>& resource, const sf::Image& pixels, ContentHashes<T>& contentHashes, IndexedMap<std::string, Resource<T>, true>& resources)
+{
+	// a matching hash is only a candidate; content is shared only if the pixels are also identical
+	const std::uint64_t contentHash{ priv_hashPixels(pixels) };
+	if ((resource.shared != nullptr) && (resource.shared->contentHash == contentHash) && priv_hasPixels(resource.shared->resource, pixels))
+		return true; // already sharing this content
+	const auto owner = contentHashes.find(contentHash);
+	if ((owner != contentHashes.end()) && (owner->second == &resource))
+		return false; // already owns this content (e.g. reloaded after eviction) so anything sharing it is unaffected
+
+	priv_detach(resource, contentHashes, resources, false);
+	if ((owner != contentHashes.end()) && !owner->second->usage.isUnloaded)
+	{
+		if (!priv_hasPixels(owner->second->resource, pixels))
+			return false; // hash collision: kept as a separate resource that is not registered for sharing
+		resource.shared = owner->second;
+		++resource.shared->usage.numberOfSharers;
+		priv_release(resource.resource);
+		return true;
+	}
+	resource.contentHash = contentHash;
+	resource.hasContentHash = true;
+	contentHashes[contentHash] = &resource; // an evicted owner shares this content if it is reloaded
+	return false;
+}
+
+template <class T>
+inline void ResourceManagerBasic::priv_detach(Resource<T>& resource, ContentHashes<T>& contentHashes, IndexedMap<std::string, Resource<T>, true>& resources, const bool isRemoving)
+{
+	if (resource.shared != nullptr)
+	{
+		--resource.shared->usage.numberOfSharers;
+		resource.shared = nullptr;
+	}
+	if (!resource.hasContentHash)
+		return;
+	resource.hasContentHash = false;
+	const auto owner = contentHashes.find(resource.contentHash);
+	if ((owner == contentHashes.end()) || (owner->second != &resource))
+		return;
+	contentHashes.erase(owner);
+	if (resource.usage.numberOfSharers == 0_uz)
+		return;
+
+	// the first resource sharing the content becomes its owner (taking the content if this resource is being removed, otherwise copying it) and the others share from that one
+	Resource<T>* newOwner{ nullptr };
+	for (std::size_t i{ 0_uz }; i < resources.getSize(); ++i)
+	{
+		Resource<T>& sharer{ resources.access(i) };
+		if (sharer.shared != &resource)
+			continue;
+		if (newOwner == nullptr)
+		{
+			newOwner = &sharer;
+			sharer.shared = nullptr;
+			if (isRemoving)
+				sharer.resource = std::move(resource.resource);
+			else
+				sharer.resource = resource.resource;
+			sharer.contentHash = resource.contentHash;
+			sharer.hasContentHash = true;
+			sharer.usage.memory = priv_getMemory(sharer.resource);
+			contentHashes[sharer.contentHash] = &sharer;
+		}
+		else
+		{
+			sharer.shared = newOwner;
+			++newOwner->usage.numberOfSharers;
+		}
+	}
+	resource.usage.numberOfSharers = 0_uz;
+	priv_recalculateMemoryUsage();
+}
+
+template <class T>
+inline void ResourceManagerBasic::priv_detachAll(const std::string& id, ContentHashes<T>& contentHashes, IndexedMap<std::string, Resource<T>, true>& resources)
+{
+	// repeated as content can be passed on to another resource with the same ID
+	bool isDetached{ false };
+	while (!isDetached)
+	{
+		isDetached = true;
+		for (std::size_t i{ 0_uz }; i < resources.getSize(); ++i)
+		{
+			Resource<T>& resource{ resources.access(i) };
+			if ((resource.shared == nullptr) && !resource.hasContentHash)
+				continue;
+			if (resources.getKey(i) != id)
+				continue;
+			priv_detach(resource, contentHashes, resources, true);
+			isDetached = false;
+		}
+	}
+}
+
+inline bool ResourceManagerBasic::priv_hasPixels(const sf::Image& image, const sf::Image& pixels)
+{
+	const sf::Vector2u size{ image.getSize() };
+	if (size != pixels.getSize())
+		return false;
+	const std::size_t numberOfBytes{ static_cast<std::size_t>(size.x) * size.y * 4_uz };
+	return (numberOfBytes == 0_uz) || (std::memcmp(image.getPixelsPtr(), pixels.getPixelsPtr(), numberOfBytes) == 0);
+}
+
+inline bool ResourceManagerBasic::priv_hasPixels(const sf::Texture& texture, const sf::Image& pixels)
+{
+	return (texture.getSize() == pixels.getSize()) && priv_hasPixels(texture.copyToImage(), pixels);
+}
+
+inline std::uint64_t ResourceManagerBasic::priv_hashPixels(const sf::Image& image)
+{
+	// fast non-cryptographic hash of the size and pixels: four independent multiply-rotate lanes over 32-byte blocks, then a final mix
+	constexpr std::uint64_t prime1{ 0x9E3779B185EBCA87ull };
+	constexpr std::uint64_t prime2{ 0xC2B2AE3D27D4EB4Full };
+	auto rotate = [](const std::uint64_t value, const unsigned int amount)
+	{
+		return (value << amount) | (value >> (64u - amount));
+	};
+	auto round = [&rotate](const std::uint64_t lane, const std::uint64_t value)
+	{
+		return rotate(lane + value * prime2, 31u) * prime1;
+	};
+
+	const sf::Vector2u size{ image.getSize() };
+	const std::size_t numberOfBytes{ static_cast<std::size_t>(size.x) * size.y * 4_uz };
+	const std::uint8_t* const pixels{ image.getPixelsPtr() };
+	std::uint64_t lanes[4]{ prime1 + prime2, prime2, 0u, 0u - prime1 };
+	std::size_t offset{ 0_uz };
+	for (; offset + 32_uz <= numberOfBytes; offset += 32_uz)
+	{
+		std::uint64_t values[4];
+		std::memcpy(values, pixels + offset, 32_uz);
+		for (std::size_t l{ 0_uz }; l < 4_uz; ++l)
+			lanes[l] = round(lanes[l], values[l]);
+	}
+	std::uint64_t hash{ rotate(lanes[0], 1u) + rotate(lanes[1], 7u) + rotate(lanes[2], 12u) + rotate(lanes[3], 18u) };
+	hash = round(hash, (static_cast<std::uint64_t>(size.x) << 32u) | size.y);
+	for (; offset < numberOfBytes; offset += 4_uz) // pixels are four bytes
+	{
+		std::uint32_t value;
+		std::memcpy(&value, pixels + offset, 4_uz);
+		hash = round(hash, value);
+	}
+	hash ^= hash >> 33u;
+	hash *= prime2;
+	hash ^= hash >> 29u;
+	hash *= prime1;
+	hash ^= hash >> 32u;
+	return hash;
+}
+
+template <class T>
+inline void ResourceManagerBasic::priv_evict(Resource<T>& resource)
+{
+	priv_release(resource.resource);
+	m_memoryUsage -= resource.usage.memory;
+	resource.usage.isUnloaded = true;
+}
+
+inline void ResourceManagerBasic::priv_recalculateMemoryUsage()
+{
+	m_memoryUsage = 0_uz;
+	auto addMemory = [this](const ResourceUsage& usage)
+	{
+		if (!usage.isUnloaded)
+			m_memoryUsage += usage.memory;
+	};
+	for (std::size_t i{ 0_uz }; i < m_images.getSize(); ++i)
+		addMemory(m_images.access(i).usage);
+	for (std::size_t i{ 0_uz }; i < m_textures.getSize(); ++i)
+		addMemory(m_textures.access(i).usage);
+	for (std::size_t i{ 0_uz }; i < m_soundBuffers.getSize(); ++i)
+		addMemory(m_soundBuffers.access(i).usage);
+}
+
+template <class T>
+inline void ResourceManagerBasic::priv_release(T& resource)
+{
+	resource = T{};
+}
+
+inline void ResourceManagerBasic::priv_release(sf::Texture& texture)
+{
+	// keep texture settings so they are the same after reloading
+	sf::Texture emptyTexture{};
+	emptyTexture.setSmooth(texture.isSmooth());
+	emptyTexture.setRepeated(texture.isRepeated());
+	texture = std::move(emptyTexture);
+}
+
+inline void ResourceManagerBasic::priv_watchFile(const std::string& filename)
+{
+#ifdef __linux__
+	if ((m_hotReloadFileDescriptor < 0) || filename.empty())
+		return;
+	std::string directory{ std::filesystem::path(priv_normaliseFilename(filename)).parent_path().generic_string() };
+	if (directory.empty())
+		directory = ".";
+	const int watchDescriptor{ inotify_add_watch(m_hotReloadFileDescriptor, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE) }; // directory is watched as files are often replaced rather than modified
+	if (watchDescriptor >= 0)
+		m_hotReloadDirectories[watchDescriptor] = directory; // adding the same directory again returns the same watch descriptor
+#else
+	static_cast<void>(filename);
+#endif // __linux__
+}
+
+inline void ResourceManagerBasic::priv_watchAllFiles()
+{
+	for (std::size_t i{ 0_uz }; i < m_fonts.getSize(); ++i)
+		priv_watchFile(m_fonts.access(i).usage.filename);
+	for (std::size_t i{ 0_uz }; i < m_images.getSize(); ++i)
+		priv_watchFile(m_images.access(i).usage.filename);
+	for (std::size_t i{ 0_uz }; i < m_textures.getSize(); ++i)
+		priv_watchFile(m_textures.access(i).usage.filename);
+	for (std::size_t i{ 0_uz }; i < m_soundBuffers.getSize(); ++i)
+		priv_watchFile(m_soundBuffers.access(i).usage.filename);
+}
+
+inline void ResourceManagerBasic::priv_processHotReload()
+{
+	const std::chrono::steady_clock::time_point now{ std::chrono::steady_clock::now() };
+#ifdef __linux__
+	if (m_hotReloadFileDescriptor < 0)
+		return;
+	alignas(inotify_event) char buffer[4096];
+	while (true)
+	{
+		const ssize_t length{ ::read(m_hotReloadFileDescriptor, buffer, sizeof(buffer)) };
+		if (length <= 0)
+			break; // no more events (EAGAIN) or error
+		for (ssize_t offset{ 0 }; offset < length;)
+		{
+			const inotify_event* event{ reinterpret_cast<const inotify_event*>(buffer + offset) };
+			offset += static_cast<ssize_t>(sizeof(inotify_event) + event->len);
+			const auto directory = m_hotReloadDirectories.find(event->wd);
+			if ((directory == m_hotReloadDirectories.end()) || (event->len == 0u))
+				continue;
+			m_hotReloadChangedFiles[priv_normaliseFilename(directory->second + "/" + event->name)] = now; // later changes restart the delay
+		}
+	}
+#endif // __linux__
+
+	const std::chrono::microseconds delay{ m_hotReloadDelay.asMicroseconds() };
+	for (auto changedFile = m_hotReloadChangedFiles.begin(); changedFile != m_hotReloadChangedFiles.end();)
+	{
+		if (now - changedFile->second < delay)
+		{
+			++changedFile;
+			continue;
+		}
+		// reload every loaded resource that uses this file. unloaded resources will load the new file when accessed
+		// resources sharing content (deduplicated before hot reload was enabled) are skipped as a reload would change the object used by the other resources' references
+		auto reloadIfChanged = [&](const ResourceType type, const std::size_t index, const ResourceUsage& usage, const bool isSharedContent)
+		{
+			if (!usage.isUnloaded && !usage.filename.empty() && !isSharedContent && (usage.numberOfSharers == 0_uz) && (priv_normaliseFilename(usage.filename) == changedFile->first))
+				priv_addAsyncLoad(type, index, usage.filename);
+		};
+		for (std::size_t i{ 0_uz }; i < m_fonts.getSize(); ++i)
+			reloadIfChanged(ResourceType::Font, i, m_fonts.access(i).usage, false);
+		for (std::size_t i{ 0_uz }; i < m_images.getSize(); ++i)
+			reloadIfChanged(ResourceType::Image, i, m_images.access(i).usage, m_images.access(i).shared != nullptr);
+		for (std::size_t i{ 0_uz }; i < m_textures.getSize(); ++i)
+			reloadIfChanged(ResourceType::Texture, i, m_textures.access(i).usage, m_textures.access(i).shared != nullptr);
+		for (std::size_t i{ 0_uz }; i < m_soundBuffers.getSize(); ++i)
+			reloadIfChanged(ResourceType::SoundBuffer, i, m_soundBuffers.access(i).usage, false);
+		changedFile = m_hotReloadChangedFiles.erase(changedFile);
+	}
+}
+
+inline std::string ResourceManagerBasic::priv_normaliseFilename(const std::string& filename)
+{
+	return std::filesystem::path(filename).lexically_normal().generic_string();
+}
+
+inline std::size_t ResourceManagerBasic::priv_getMemory(const sf::Font&)
+{
+	return 0_uz; // fonts are not included in the memory budget
+}
+
+inline std::size_t ResourceManagerBasic::priv_getMemory(const sf::Image& image)
+{
+	return static_cast<std::size_t>(image.getSize().x) * image.getSize().y * 4_uz;
+}
+
+inline std::size_t ResourceManagerBasic::priv_getMemory(const sf::Texture& texture)
+{
+	return static_cast<std::size_t>(texture.getSize().x) * texture.getSize().y * 4_uz;
+}
+
+inline std::size_t ResourceManagerBasic::priv_getMemory(const sf::SoundBuffer& soundBuffer)
+{
+	return static_cast<std::size_t>(soundBuffer.getSampleCount()) * sizeof(std::int16_t);
+}
+
+inline const void* ResourceManagerBasic::priv_getResourcePackData(MountedResourcePack* const resourcePack, const std::string& filename, std::size_t& size)
+{
+	if ((resourcePack == nullptr) || (filename.compare(0_uz, resourcePack->mountPath.size(), resourcePack->mountPath) != 0))
+		return nullptr;
+	return resourcePack->pack.getData(filename.substr(resourcePack->mountPath.size()), size);
+}
+
+inline bool ResourceManagerBasic::priv_loadFromFile(sf::Font& font, const std::string& filename, MountedResourcePack* const resourcePack)
+{
+	std::size_t size{ 0_uz };
+	const void* data{ priv_getResourcePackData(resourcePack, filename, size) };
+	return (data != nullptr) ? font.openFromMemory(data, size) : font.openFromFile(filename);
+}
+
+inline bool ResourceManagerBasic::priv_loadFromFile(sf::Image& image, const std::string& filename, MountedResourcePack* const resourcePack)
+{
+	std::size_t size{ 0_uz };
+	const void* data{ priv_getResourcePackData(resourcePack, filename, size) };
+	return (data != nullptr) ? image.loadFromMemory(data, size) : image.loadFromFile(filename);
+}
+
+inline bool ResourceManagerBasic::priv_loadFromFile(sf::Texture& texture, const std::string& filename, MountedResourcePack* const resourcePack)
+{
+	std::size_t size{ 0_uz };
+	const void* data{ priv_getResourcePackData(resourcePack, filename, size) };
+	return (data != nullptr) ? texture.loadFromMemory(data, size) : texture.loadFromFile(filename);
+}
+
+inline bool ResourceManagerBasic::priv_loadFromFile(sf::SoundBuffer& soundBuffer, const std::string& filename, MountedResourcePack* const resourcePack)
+{
+	std::size_t size{ 0_uz };
+	const void* data{ priv_getResourcePackData(resourcePack, filename, size) };
+	return (data != nullptr) ? soundBuffer.loadFromMemory(data, size) : soundBuffer.loadFromFile(filename);
 }
 
 } // namespace plinth
@@ -0,0 +1,75 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// Plinth
+//
+// Copyright(c) 2014-2025 M.J.Silk
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions :
+//
+// 1. The origin of this software must not be misrepresented; you must not
+// claim that you wrote the original software.If you use this software
+// in a product, an acknowledgment in the product documentation would be
+// appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not be
+// misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+// M.J.Silk
+// MJSilk2@gmail.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once
+
+#include "Common.hpp"
+#include "TextureAtlas.hpp"
+#include <SFML/System/Vector2.hpp>
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+
+namespace plinth
+{
+
+// creates (and caches) a tight convex triangle mesh around the opaque pixels of each texture atlas frame.
+// drawing this mesh (as sf::PrimitiveType::Triangles) instead of the frame's full quad reduces overdraw of transparent areas.
+// vertex positions match those of a quad covering the frame's rectangle with its top-left at the frame's origin offset (position = pixel - rect.position - origin).
+// texture co-ordinates are in pixels (as used by SFML). the frame's rotateFlip is not applied; the mesh is of the frame as stored in the texture.
+class TextureAtlasMesh
+{
+public:
+	TextureAtlasMesh();
+	void setAlphaThreshold(unsigned char alphaThreshold); // pixels with alpha greater than this are considered opaque. clears cache
+	unsigned char getAlphaThreshold() const;
+	void setMaximumNumberOfVertices(std::size_t maximumNumberOfVertices); // maximum number of outline vertices (minimum of 3). clears cache
+	std::size_t getMaximumNumberOfVertices() const;
+
+	const std::vector<sf::Vertex>& get(std::size_t frameIndex, const TextureAtlas::Frame& frame, const sf::Image& image); // creates if not cached. frame index is the cache key. the reference is only valid until the next call to get, clear or a setter
+	std::vector<sf::Vertex> create(const TextureAtlas::Frame& frame, const sf::Image& image) const; // always creates; does not cache
+	std::vector<sf::Vector2f> createOutline(const TextureAtlas::Frame& frame, const sf::Image& image) const; // convex outline (relative to rect's top-left) from which the mesh is triangulated
+	bool isCached(std::size_t frameIndex) const;
+	void clear(std::size_t frameIndex);
+	void clear();
+
+private:
+	struct CachedMesh
+	{
+		bool isCached{ false };
+		std::vector<sf::Vertex> vertices{};
+	};
+
+	unsigned char m_alphaThreshold;
+	std::size_t m_maximumNumberOfVertices;
+	std::vector<CachedMesh> m_meshes;
+};
+
+} // namespace plinth
+#include "TextureAtlasMesh.inl"
@@ -0,0 +1,242 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// Plinth
+//
+// Copyright(c) 2014-2025 M.J.Silk
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions :
+//
+// 1. The origin of this software must not be misrepresented; you must not
+// claim that you wrote the original software.If you use this software
+// in a product, an acknowledgment in the product documentation would be
+// appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not be
+// misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+// M.J.Silk
+// MJSilk2@gmail.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once
+
+#include "TextureAtlasMesh.hpp"
+
+#include <algorithm> // for sort, unique, max, min
+#include <limits>
+#include <cmath>
+
+namespace plinth
+{
+
+inline TextureAtlasMesh::TextureAtlasMesh()
+	: m_alphaThreshold{ 0_uc }
+	, m_maximumNumberOfVertices{ 8_uz }
+	, m_meshes{}
+{
+}
+
+inline void TextureAtlasMesh::setAlphaThreshold(const unsigned char alphaThreshold)
+{
+	m_alphaThreshold = alphaThreshold;
+	clear();
+}
+
+inline unsigned char TextureAtlasMesh::getAlphaThreshold() const
+{
+	return m_alphaThreshold;
+}
+
+inline void TextureAtlasMesh::setMaximumNumberOfVertices(const std::size_t maximumNumberOfVertices)
+{
+	m_maximumNumberOfVertices = std::max(maximumNumberOfVertices, 3_uz);
+	clear();
+}
+
+inline std::size_t TextureAtlasMesh::getMaximumNumberOfVertices() const
+{
+	return m_maximumNumberOfVertices;
+}
+
+inline const std::vector<sf::Vertex>& TextureAtlasMesh::get(const std::size_t frameIndex, const TextureAtlas::Frame& frame, const sf::Image& image)
+{
+	if (frameIndex >= m_meshes.size())
+		m_meshes.resize(frameIndex + 1_uz);
+	CachedMesh& mesh{ m_meshes[frameIndex] };
+	if (!mesh.isCached)
+	{
+		mesh.vertices = create(frame, image);
+		mesh.isCached = true;
+	}
+	return mesh.vertices;
+}
+
+inline std::vector<sf::Vertex> TextureAtlasMesh::create(const TextureAtlas::Frame& frame, const sf::Image& image) const
+{
+	const std::vector<sf::Vector2f> outline{ createOutline(frame, image) };
+	std::vector<sf::Vertex> vertices;
+	if (outline.size() < 3_uz)
+		return vertices;
+
+	const sf::Vector2f rectPosition{ frame.rect.position };
+	const sf::Vector2f origin{ frame.origin };
+	auto vertex = [&](const sf::Vector2f point)
+	{
+		sf::Vertex result{};
+		result.position = point - origin;
+		result.texCoords = point + rectPosition;
+		return result;
+	};
+
+	// outline is convex so a triangle fan (as separate triangles) covers it
+	vertices.reserve((outline.size() - 2_uz) * 3_uz);
+	for (std::size_t i{ 1_uz }; i < outline.size() - 1_uz; ++i)
+	{
+		vertices.push_back(vertex(outline[0_uz]));
+		vertices.push_back(vertex(outline[i]));
+		vertices.push_back(vertex(outline[i + 1_uz]));
+	}
+	return vertices;
+}
+
+inline std::vector<sf::Vector2f> TextureAtlasMesh::createOutline(const TextureAtlas::Frame& frame, const sf::Image& image) const
+{
+	using Point = sf::Vector2<double>;
+	auto cross = [](const Point a, const Point b) { return (a.x * b.y) - (a.y * b.x); };
+
+	std::vector<sf::Vector2f> outline;
+	const sf::Vector2u imageSize{ image.getSize() };
+	const std::uint8_t* pixels{ image.getPixelsPtr() };
+	if (pixels == nullptr)
+		return outline;
+
+	// only the part of the frame's rectangle that is inside the image is considered
+	const long long int rectLeft{ frame.rect.position.x };
+	const long long int rectTop{ frame.rect.position.y };
+	const long long int left{ std::max(rectLeft, 0ll) };
+	const long long int top{ std::max(rectTop, 0ll) };
+	const long long int right{ std::min(rectLeft + frame.rect.size.x, static_cast<long long int>(imageSize.x)) };
+	const long long int bottom{ std::min(rectTop + frame.rect.size.y, static_cast<long long int>(imageSize.y)) };
+	if ((left >= right) || (top >= bottom))
+		return outline;
+
+	// the leftmost and rightmost opaque pixel of each row provide all points needed for the convex hull (pixel corners)
+	std::vector<Point> points;
+	for (long long int y{ top }; y < bottom; ++y)
+	{
+		const std::uint8_t* row{ pixels + ((static_cast<std::size_t>(y) * imageSize.x) * 4_uz) + 3_uz };
+		long long int first{ left };
+		while ((first < right) && (row[first * 4ll] <= m_alphaThreshold))
+			++first;
+		if (first == right)
+			continue;
+		long long int last{ right - 1ll };
+		while (row[last * 4ll] <= m_alphaThreshold)
+			--last;
+		const double x0{ static_cast<double>(first - rectLeft) };
+		const double x1{ static_cast<double>(last + 1ll - rectLeft) };
+		const double y0{ static_cast<double>(y - rectTop) };
+		const double y1{ y0 + 1.0 };
+		points.push_back({ x0, y0 });
+		points.push_back({ x0, y1 });
+		points.push_back({ x1, y0 });
+		points.push_back({ x1, y1 });
+	}
+	if (points.empty())
+		return outline;
+
+	// convex hull (monotone chain). collinear points are removed
+	std::sort(points.begin(), points.end(), [](const Point a, const Point b) { return (a.x < b.x) || ((a.x == b.x) && (a.y < b.y)); });
+	points.erase(std::unique(points.begin(), points.end()), points.end());
+	std::vector<Point> hull(points.size() * 2_uz);
+	std::size_t hullSize{ 0_uz };
+	for (std::size_t i{ 0_uz }; i < points.size(); ++i)
+	{
+		while ((hullSize >= 2_uz) && (cross(hull[hullSize - 1_uz] - hull[hullSize - 2_uz], points[i] - hull[hullSize - 2_uz]) <= 0.0))
+			--hullSize;
+		hull[hullSize++] = points[i];
+	}
+	for (std::size_t i{ points.size() - 1_uz }, lowerSize{ hullSize + 1_uz }; i > 0_uz; --i)
+	{
+		while ((hullSize >= lowerSize) && (cross(hull[hullSize - 1_uz] - hull[hullSize - 2_uz], points[i - 1_uz] - hull[hullSize - 2_uz]) <= 0.0))
+			--hullSize;
+		hull[hullSize++] = points[i - 1_uz];
+	}
+	hull.resize(hullSize - 1_uz); // last point is the same as the first
+
+	// reduce number of vertices by removing edges. an edge is removed by extending both of its neighbouring edges to their intersection.
+	// this only ever grows the hull (so no opaque pixels are lost) and the edge that adds the smallest area is removed each time.
+	// intersections outside of the frame's rectangle are not allowed to avoid sampling neighbouring frames
+	const double width{ static_cast<double>(frame.rect.size.x) };
+	const double height{ static_cast<double>(frame.rect.size.y) };
+	while (hull.size() > m_maximumNumberOfVertices)
+	{
+		const std::size_t n{ hull.size() };
+		std::size_t bestIndex{ n };
+		double bestArea{ std::numeric_limits<double>::max() };
+		Point bestPoint{};
+		for (std::size_t i{ 0_uz }; i < n; ++i)
+		{
+			const Point a{ hull[(i + n - 1_uz) % n] };
+			const Point b{ hull[i] };
+			const Point c{ hull[(i + 1_uz) % n] };
+			const Point d{ hull[(i + 2_uz) % n] };
+			const Point u{ b - a };
+			const Point v{ c - d };
+			const double denominator{ cross(u, v) };
+			if (std::abs(denominator) < 1e-12)
+				continue;
+			const double t{ cross(c - b, v) / denominator };
+			const double s{ cross(c - b, u) / denominator };
+			if ((t <= 0.0) || (s <= 0.0))
+				continue;
+			const Point p{ b + u * t };
+			if ((p.x < 0.0) || (p.y < 0.0) || (p.x > width) || (p.y > height))
+				continue;
+			const double area{ std::abs(cross(c - b, p - b)) / 2.0 };
+			if (area < bestArea)
+			{
+				bestArea = area;
+				bestIndex = i;
+				bestPoint = p;
+			}
+		}
+		if (bestIndex == n)
+			break;
+		hull[bestIndex] = bestPoint;
+		hull.erase(hull.begin() + ((bestIndex + 1_uz) % n));
+	}
+
+	outline.reserve(hull.size());
+	for (const auto& point : hull)
+		outline.push_back(sf::Vector2f(point));
+	return outline;
+}
+
+inline bool TextureAtlasMesh::isCached(const std::size_t frameIndex) const
+{
+	return (frameIndex < m_meshes.size()) && m_meshes[frameIndex].isCached;
+}
+
+inline void TextureAtlasMesh::clear(const std::size_t frameIndex)
+{
+	if (frameIndex < m_meshes.size())
+		m_meshes[frameIndex] = CachedMesh{};
+}
+
+inline void TextureAtlasMesh::clear()
+{
+	m_meshes.clear();
+}
+
+} // namespace plinth
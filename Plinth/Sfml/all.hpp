@@ -38,6 +38,16 @@
 #include "Generic.hpp"
 #include "Image.hpp"
 #include "ImageChannel.hpp"
+#include "ImageDistanceField.hpp"
+#include "ImageFilter.hpp"
+#include "ImageHistogram.hpp"
+#include "ImageMipmap.hpp"
+#include "ImageNoise.hpp"
+#include "ImagePalette.hpp"
+#include "ImageParallel.hpp"
+#include "ImagePipeline.hpp"
+#include "ImageSimd.hpp"
+#include "ImageSrgb.hpp"
 #include "KeyMap.hpp"
 #include "ResourceManagerBasic.hpp"
 #include "Strings.hpp"
@@ -0,0 +1,72 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// Plinth
+//
+// Copyright(c) 2014-2025 M.J.Silk
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions :
+//
+// 1. The origin of this software must not be misrepresented; you must not
+// claim that you wrote the original software.If you use this software
+// in a product, an acknowledgment in the product documentation would be
+// appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not be
+// misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+// M.J.Silk
+// MJSilk2@gmail.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+
+// REQUIRES C++11
+
+#pragma once
+
+#include "Common.hpp"
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <future>
+#include <functional>
+#include <deque>
+#include <memory>
+
+namespace plinth
+{
+
+// simple fixed-size pool of worker threads that process tasks in the order they are added
+class ThreadPool
+{
+public:
+	ThreadPool(std::size_t numberOfThreads = 0_uz); // zero uses the hardware concurrency (minimum of 1)
+	~ThreadPool(); // waits for all queued tasks to finish
+	ThreadPool(const ThreadPool&) = delete;
+	ThreadPool& operator=(const ThreadPool&) = delete;
+
+	template <class TaskT>
+	auto add(TaskT&& task) -> std::future<decltype(task())>; // exceptions thrown by task are stored in the returned future
+	std::size_t getNumberOfThreads() const;
+	std::size_t getNumberOfQueuedTasks() const;
+
+private:
+	std::vector<std::thread> m_threads;
+	std::deque<std::function<void()>> m_tasks;
+	mutable std::mutex m_mutex;
+	std::condition_variable m_condition;
+	bool m_isStopping;
+
+	void priv_work();
+};
+
+} // namespace plinth
+#include "ThreadPool.inl"
@@ -0,0 +1,108 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// Plinth
+//
+// Copyright(c) 2014-2025 M.J.Silk
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions :
+//
+// 1. The origin of this software must not be misrepresented; you must not
+// claim that you wrote the original software.If you use this software
+// in a product, an acknowledgment in the product documentation would be
+// appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not be
+// misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+// M.J.Silk
+// MJSilk2@gmail.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once
+
+#include "ThreadPool.hpp"
+
+namespace plinth
+{
+
+inline ThreadPool::ThreadPool(std::size_t numberOfThreads)
+	: m_threads{}
+	, m_tasks{}
+	, m_mutex{}
+	, m_condition{}
+	, m_isStopping{ false }
+{
+	if (numberOfThreads == 0_uz)
+		numberOfThreads = static_cast<std::size_t>(std::thread::hardware_concurrency());
+	if (numberOfThreads == 0_uz)
+		numberOfThreads = 1_uz;
+	m_threads.reserve(numberOfThreads);
+	for (std::size_t i{ 0_uz }; i < numberOfThreads; ++i)
+		m_threads.emplace_back([this]() { priv_work(); });
+}
+
+inline ThreadPool::~ThreadPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_isStopping = true;
+	}
+	m_condition.notify_all();
+	for (auto& thread : m_threads)
+		thread.join();
+}
+
+template <class TaskT>
+inline auto ThreadPool::add(TaskT&& task) -> std::future<decltype(task())>
+{
+	using ResultT = decltype(task());
+	auto packagedTask = std::make_shared<std::packaged_task<ResultT()>>(std::forward<TaskT>(task));
+	std::future<ResultT> future{ packagedTask->get_future() };
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_tasks.emplace_back([packagedTask]() { (*packagedTask)(); });
+	}
+	m_condition.notify_one();
+	return future;
+}
+
+inline std::size_t ThreadPool::getNumberOfThreads() const
+{
+	return m_threads.size();
+}
+
+inline std::size_t ThreadPool::getNumberOfQueuedTasks() const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_tasks.size();
+}
+
+// PRIVATE
+inline void ThreadPool::priv_work()
+{
+	while (true)
+	{
+		std::function<void()> task;
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_condition.wait(lock, [this]() { return m_isStopping || !m_tasks.empty(); });
+			if (m_tasks.empty())
+				return; // only stops once all tasks are complete
+			task = std::move(m_tasks.front());
+			m_tasks.pop_front();
+		}
+		task();
+	}
+}
+
+} // namespace plinth
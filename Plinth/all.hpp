@@ -43,6 +43,7 @@
 #include "Ranges.hpp"
 #include "Sizes.hpp"
 #include "Strings.hpp"
+#include "ThreadPool.hpp"
 #include "Tween.hpp"
 #include "TweenPiecewise.hpp"
 #include "TweenTracks.hpp"
@@ -0,0 +1,108 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// Plinth
+//
+// Copyright(c) 2014-2025 M.J.Silk
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions :
+//
+// 1. The origin of this software must not be misrepresented; you must not
+// claim that you wrote the original software.If you use this software
+// in a product, an acknowledgment in the product documentation would be
+// appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not be
+// misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+// M.J.Silk
+// MJSilk2@gmail.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+// measures how parallel image processing scales with the number of threads (see Image::setNumberOfThreads)
+// prints the median time of each operation for 1, 2, 4 and 8 threads on 4K and 8K images and the speedup over 1 thread
+
+#include <Plinth/Sfml/ErrBlocker.hpp> // used by Image (Draw resize types)
+#include <Plinth/Sfml/Image.hpp>
+#include <Plinth/Sfml/ImageChannel.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+constexpr std::size_t numberOfRuns{ 5u };
+
+double measureMilliseconds(const std::function<void()>& operation)
+{
+	std::vector<double> times;
+	for (std::size_t run{ 0u }; run < numberOfRuns; ++run)
+	{
+		const std::chrono::steady_clock::time_point start{ std::chrono::steady_clock::now() };
+		operation();
+		times.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+	}
+	std::sort(times.begin(), times.end());
+	return times[numberOfRuns / 2u];
+}
+
+sf::Image createNoiseImage(const sf::Vector2u size)
+{
+	std::mt19937 randomGenerator{ 12345u };
+	std::vector<std::uint8_t> pixels(static_cast<std::size_t>(size.x) * size.y * 4u);
+	for (std::uint8_t& component : pixels)
+		component = static_cast<std::uint8_t>(randomGenerator());
+	return sf::Image(size, pixels.data());
+}
+
+} // namespace
+
+int main()
+{
+	const std::size_t threadCounts[]{ 1u, 2u, 4u, 8u };
+	const struct { const char* name; sf::Vector2u size; } imageSizes[]{ { "4K", { 3840u, 2160u } }, { "8K", { 7680u, 4320u } } };
+
+	std::printf("hardware concurrency: %u\n", std::thread::hardware_concurrency());
+	std::printf("%-28s %-3s %8s %8s\n", "operation", "", "threads", "ms");
+	for (const auto& imageSize : imageSizes)
+	{
+		const sf::Image source{ createNoiseImage(imageSize.size) };
+		const sf::Vector2u halfSize{ imageSize.size.x / 2u, imageSize.size.y / 2u };
+		sf::Image grayscale{ source }; // converted in place on every run (converting gray is the same work)
+		sf::Image image;
+		plinth::Image::Channel channel;
+		const struct { const char* name; std::function<void()> operation; } operations[]
+		{
+			{ "convertToGrayscale", [&]() { plinth::Image::convertToGrayscale(grayscale); } },
+			{ "resize Bilinear (half)", [&]() { image = plinth::Image::resize(plinth::Image::ResizeType::Bilinear, source, halfSize); } },
+			{ "resize Bicubic (half)", [&]() { image = plinth::Image::resize(plinth::Image::ResizeType::Bicubic, source, halfSize); } },
+			{ "Channel::copyFromImage", [&]() { channel.copyFromImage(source); } }
+		};
+		for (const auto& operation : operations)
+		{
+			double singleThreadTime{ 0.0 };
+			for (const std::size_t numberOfThreads : threadCounts)
+			{
+				plinth::Image::setNumberOfThreads(numberOfThreads);
+				const double time{ measureMilliseconds(operation.operation) };
+				if (numberOfThreads == 1u)
+					singleThreadTime = time;
+				std::printf("%-28s %-3s %8zu %8.1f (x%.2f)\n", operation.name, imageSize.name, numberOfThreads, time, singleThreadTime / time);
+			}
+		}
+	}
+	return 0;
+}
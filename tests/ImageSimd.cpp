@@ -0,0 +1,351 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// Plinth
+//
+// Copyright(c) 2014-2025 M.J.Silk
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions :
+//
+// 1. The origin of this software must not be misrepresented; you must not
+// claim that you wrote the original software.If you use this software
+// in a product, an acknowledgment in the product documentation would be
+// appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not be
+// misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+// M.J.Silk
+// MJSilk2@gmail.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+// checks that every SIMD operation (completed by scalar code for the pixels it does not process) is bit-exact against the scalar version for every instruction set available
+
+#include <Plinth/Sfml/ImageSimd.hpp>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+namespace simd = plinth::Image::impl::simd;
+using plinth::Image::InstructionSet;
+
+using Bytes = std::vector<std::uint8_t>;
+
+const std::size_t widths[]{ 1u, 3u, 7u, 9u, 17u, 1000u };
+std::mt19937 randomGenerator{ 12345u };
+
+Bytes randomBytes(const std::size_t size)
+{
+	Bytes bytes(size);
+	for (std::uint8_t& byte : bytes)
+		byte = static_cast<std::uint8_t>(randomGenerator());
+	return bytes;
+}
+
+template <class T>
+Bytes toBytes(const std::vector<T>& values)
+{
+	Bytes bytes(values.size() * sizeof(T));
+	if (!bytes.empty())
+		std::memcpy(bytes.data(), values.data(), bytes.size());
+	return bytes;
+}
+
+// scalar versions
+
+std::uint32_t loadPixel(const std::uint8_t* const pixel)
+{
+	return pixel[0u] | (static_cast<std::uint32_t>(pixel[1u]) << 8u) | (static_cast<std::uint32_t>(pixel[2u]) << 16u) | (static_cast<std::uint32_t>(pixel[3u]) << 24u);
+}
+
+void storePixel(std::uint8_t* const pixel, const std::uint32_t value)
+{
+	for (unsigned int i{ 0u }; i < 4u; ++i)
+		pixel[i] = static_cast<std::uint8_t>(value >> (i * 8u));
+}
+
+std::uint32_t getGray(const simd::Operation operation, const std::uint8_t* const pixel, const simd::Parameters& parameters)
+{
+	const unsigned int r{ pixel[0u] };
+	const unsigned int g{ pixel[1u] };
+	const unsigned int b{ pixel[2u] };
+	switch (operation)
+	{
+	case simd::Operation::ReplicateChannel:
+		return (loadPixel(pixel) >> parameters.shift) & 0xFFu;
+	case simd::Operation::Luminosity:
+		return ((13933u * r) + (46871u * g) + (4732u * b)) >> 16u;
+	case simd::Operation::Average:
+		return (r + g + b) / 3u;
+	case simd::Operation::Lightness:
+		return (std::max(r, std::max(g, b)) + std::min(r, std::min(g, b))) / 2u;
+	case simd::Operation::Median:
+		return std::max(std::min(r, g), std::min(std::max(r, g), b));
+	default:
+		return 0u;
+	}
+}
+
+void processPixel(const simd::Operation operation, std::uint8_t* const pixel, const simd::Parameters& parameters)
+{
+	const std::uint32_t value{ loadPixel(pixel) };
+	const unsigned int alpha{ pixel[3u] };
+	switch (operation)
+	{
+	case simd::Operation::Bitwise:
+		storePixel(pixel, ((value & parameters.andMask) | parameters.orMask) ^ parameters.xorMask);
+		break;
+	case simd::Operation::Premultiply:
+		for (unsigned int i{ 0u }; i < 3u; ++i)
+		{
+			const unsigned int product{ (pixel[i] * alpha) + 128u };
+			pixel[i] = static_cast<std::uint8_t>((product + (product >> 8u)) >> 8u);
+		}
+		break;
+	case simd::Operation::Unpremultiply:
+		if (alpha == 0u)
+		{
+			storePixel(pixel, 0u);
+			break;
+		}
+		for (unsigned int i{ 0u }; i < 3u; ++i)
+			pixel[i] = static_cast<std::uint8_t>(std::min((pixel[i] * 255u + (alpha / 2u)) / alpha, 255u));
+		break;
+	default:
+	{
+		const std::uint32_t gray{ getGray(operation, pixel, parameters) };
+		storePixel(pixel, gray | (gray << 8u) | (gray << 16u) | (value & parameters.andMask) | parameters.orMask);
+	}
+	}
+}
+
+// each check returns the complete output (SIMD then scalar for the rest)
+
+Bytes checkProcess(const simd::Operation operation, const simd::Parameters& parameters, Bytes pixels)
+{
+	const std::size_t numberOfPixels{ pixels.size() / 4u };
+	for (std::size_t i{ simd::process(operation, pixels.data(), numberOfPixels, parameters) }; i < numberOfPixels; ++i)
+		processPixel(operation, pixels.data() + (i * 4u), parameters);
+	return pixels;
+}
+
+Bytes checkExtract(const simd::Operation operation, const simd::Parameters& parameters, const Bytes& pixels)
+{
+	const std::size_t numberOfPixels{ pixels.size() / 4u };
+	Bytes values(numberOfPixels);
+	for (std::size_t i{ simd::extract(operation, pixels.data(), values.data(), numberOfPixels, parameters) }; i < numberOfPixels; ++i)
+		values[i] = static_cast<std::uint8_t>(getGray(operation, pixels.data() + (i * 4u), parameters));
+	return values;
+}
+
+Bytes checkInsert(const simd::Parameters& parameters, const bool isReplicated, Bytes pixels, const Bytes& values)
+{
+	const std::size_t numberOfPixels{ values.size() };
+	for (std::size_t i{ simd::insert(pixels.data(), values.data(), numberOfPixels, parameters, isReplicated) }; i < numberOfPixels; ++i)
+	{
+		const std::uint32_t value{ values[i] };
+		const std::uint32_t inserted{ isReplicated ? (value | (value << 8u) | (value << 16u)) : (value << parameters.shift) };
+		storePixel(pixels.data() + (i * 4u), (loadPixel(pixels.data() + (i * 4u)) & parameters.andMask) | parameters.orMask | inserted);
+	}
+	return pixels;
+}
+
+Bytes checkDownsampleBox(const Bytes& upperRow, const Bytes& lowerRow)
+{
+	const std::size_t numberOfDestinationPixels{ upperRow.size() / 8u };
+	Bytes destination(numberOfDestinationPixels * 4u);
+	for (std::size_t i{ simd::downsampleBox(upperRow.data(), lowerRow.data(), destination.data(), numberOfDestinationPixels) * 4u }; i < destination.size(); ++i)
+	{
+		const std::size_t left{ ((i / 4u) * 8u) + (i % 4u) };
+		destination[i] = static_cast<std::uint8_t>((upperRow[left] + upperRow[left + 4u] + lowerRow[left] + lowerRow[left + 4u] + 2u) / 4u);
+	}
+	return destination;
+}
+
+Bytes checkAccumulateWeighted(const Bytes& values, std::vector<std::int32_t> accumulators, const std::int32_t weight)
+{
+	for (std::size_t i{ simd::accumulateWeighted(values.data(), accumulators.data(), values.size(), weight) }; i < values.size(); ++i)
+		accumulators[i] += values[i] * weight;
+	return toBytes(accumulators);
+}
+
+Bytes checkNarrow(const std::vector<std::int32_t>& accumulators, const unsigned int shift)
+{
+	Bytes values(accumulators.size());
+	for (std::size_t i{ simd::narrow(accumulators.data(), values.data(), values.size(), shift) }; i < values.size(); ++i)
+	{
+		const std::int32_t value{ accumulators[i] >> shift };
+		values[i] = static_cast<std::uint8_t>((value <= 0) ? 0 : ((value >= 255) ? 255 : value));
+	}
+	return values;
+}
+
+Bytes checkSlideBox(std::vector<std::uint32_t> sums, const Bytes& entering, const Bytes& leaving, const std::uint32_t boxSize)
+{
+	// divisor as used by box blur (see ImageFilter)
+	unsigned int shift{ 32u };
+	for (std::uint32_t size{ boxSize }; size > 1u; size >>= 1u)
+		++shift;
+	const std::uint32_t half{ boxSize / 2u };
+	const std::uint32_t reciprocal{ static_cast<std::uint32_t>(((1ull << shift) + boxSize - 1ull) / boxSize) };
+
+	Bytes values(sums.size());
+	for (std::size_t i{ simd::slideBox(sums.data(), entering.data(), leaving.data(), values.data(), values.size(), half, reciprocal, shift) }; i < values.size(); ++i)
+	{
+		values[i] = static_cast<std::uint8_t>((static_cast<std::uint64_t>(sums[i] + half) * reciprocal) >> shift);
+		sums[i] += static_cast<std::uint32_t>(entering[i]) - leaving[i];
+	}
+	Bytes result{ toBytes(sums) };
+	result.insert(result.end(), values.begin(), values.end());
+	return result;
+}
+
+struct Check
+{
+	std::string name;
+	std::function<Bytes()> run; // inputs are captured so that every instruction set is given the same data
+};
+
+std::vector<Check> createChecks()
+{
+	std::vector<Check> checks;
+	const std::pair<const char*, simd::Operation> operations[]
+	{
+		{ "Bitwise", simd::Operation::Bitwise },
+		{ "ReplicateChannel", simd::Operation::ReplicateChannel },
+		{ "Luminosity", simd::Operation::Luminosity },
+		{ "Average", simd::Operation::Average },
+		{ "Lightness", simd::Operation::Lightness },
+		{ "Median", simd::Operation::Median },
+		{ "Premultiply", simd::Operation::Premultiply },
+		{ "Unpremultiply", simd::Operation::Unpremultiply }
+	};
+	for (const std::size_t width : widths)
+	{
+		const std::string suffix{ " (width " + std::to_string(width) + ")" };
+		Bytes pixels{ randomBytes(width * 4u) };
+		for (std::size_t i{ 0u }; i < width; i += 5u)
+			pixels[i * 4u + 3u] = (i % 2u == 0u) ? 0u : 255u; // zero and full alpha for unpremultiply
+
+		for (const auto& operation : operations)
+		{
+			const simd::Operation type{ operation.second };
+			if (type == simd::Operation::ReplicateChannel)
+			{
+				for (const unsigned int shift : { 0u, 8u, 16u, 24u })
+					checks.push_back({ std::string("process ") + operation.first + " shift " + std::to_string(shift) + suffix, [=]() { return checkProcess(type, { 0xFF000000u, 0u, 0u, shift }, pixels); } });
+			}
+			else if (type == simd::Operation::Bitwise)
+			{
+				checks.push_back({ std::string("process ") + operation.first + suffix, [=]() { return checkProcess(type, { 0xFFFFFFFFu, 0u, 0x00FFFFFFu, 0u }, pixels); } });
+				checks.push_back({ std::string("process ") + operation.first + " masks" + suffix, [=]() { return checkProcess(type, { 0xF0F0FF0Fu, 0x01200000u, 0x80000081u, 0u }, pixels); } });
+			}
+			else
+				checks.push_back({ std::string("process ") + operation.first + suffix, [=]() { return checkProcess(type, { 0xFF000000u, 0x00000000u, 0u, 0u }, pixels); } });
+		}
+
+		checks.push_back({ "extract Average" + suffix, [=]() { return checkExtract(simd::Operation::Average, { 0u, 0u, 0u, 0u }, pixels); } });
+		for (const unsigned int shift : { 0u, 8u, 16u, 24u })
+			checks.push_back({ "extract ReplicateChannel shift " + std::to_string(shift) + suffix, [=]() { return checkExtract(simd::Operation::ReplicateChannel, { 0u, 0u, 0u, shift }, pixels); } });
+
+		const Bytes values{ randomBytes(width) };
+		for (const unsigned int shift : { 0u, 8u, 16u, 24u })
+			checks.push_back({ "insert shift " + std::to_string(shift) + suffix, [=]() { return checkInsert({ ~(0xFFu << shift), 0u, 0u, shift }, false, pixels, values); } });
+		checks.push_back({ "insert replicated" + suffix, [=]() { return checkInsert({ 0xFF000000u, 0u, 0u, 0u }, true, pixels, values); } });
+		checks.push_back({ "insert replicated opaque" + suffix, [=]() { return checkInsert({ 0u, 0xFF000000u, 0u, 0u }, true, pixels, values); } });
+
+		const Bytes upperRow{ randomBytes(width * 8u) };
+		const Bytes lowerRow{ randomBytes(width * 8u) };
+		checks.push_back({ "downsampleBox" + suffix, [=]() { return checkDownsampleBox(upperRow, lowerRow); } });
+
+		std::vector<std::int32_t> accumulators(width);
+		for (std::int32_t& accumulator : accumulators)
+			accumulator = static_cast<std::int32_t>(randomGenerator() % (1u << 30u)) - (1 << 29);
+		for (const std::int32_t weight : { -4194303, -1, 12345, 4194303 })
+			checks.push_back({ "accumulateWeighted weight " + std::to_string(weight) + suffix, [=]() { return checkAccumulateWeighted(values, accumulators, weight); } });
+		for (const unsigned int shift : { 14u, 22u })
+			checks.push_back({ "narrow shift " + std::to_string(shift) + suffix, [=]() { return checkNarrow(accumulators, shift); } });
+
+		for (const std::uint32_t boxSize : { 1u, 3u, 5u, 16u, 255u })
+		{
+			// a column of boxSize + 1 values for each index: the sum is of all but the last, which enters as the first leaves
+			std::vector<std::uint32_t> sums(width, 0u);
+			Bytes leaving(width);
+			Bytes entering{ randomBytes(width) };
+			for (std::uint32_t row{ 0u }; row < boxSize; ++row)
+			{
+				const Bytes rowValues{ randomBytes(width) };
+				for (std::size_t i{ 0u }; i < width; ++i)
+					sums[i] += rowValues[i];
+				if (row == 0u)
+					leaving = rowValues;
+			}
+			checks.push_back({ "slideBox size " + std::to_string(boxSize) + suffix, [=]() { return checkSlideBox(sums, entering, leaving, boxSize); } });
+		}
+	}
+	return checks;
+}
+
+const char* getName(const InstructionSet instructionSet)
+{
+	switch (instructionSet)
+	{
+	case InstructionSet::Sse2:
+		return "SSE2";
+	case InstructionSet::Avx2:
+		return "AVX2";
+	case InstructionSet::Scalar:
+	default:
+		return "Scalar";
+	}
+}
+
+} // namespace
+
+int main()
+{
+	const std::vector<Check> checks{ createChecks() };
+
+	plinth::Image::setMaximumInstructionSet(InstructionSet::Scalar);
+	std::vector<Bytes> expected;
+	for (const Check& check : checks)
+		expected.push_back(check.run());
+
+	std::size_t numberOfFailures{ 0u };
+	for (const InstructionSet instructionSet : { InstructionSet::Sse2, InstructionSet::Avx2 })
+	{
+		plinth::Image::setMaximumInstructionSet(instructionSet);
+		if (plinth::Image::getInstructionSet() != instructionSet)
+		{
+			std::printf("%s: not available (skipped)\n", getName(instructionSet));
+			continue;
+		}
+		std::size_t numberOfSetFailures{ 0u };
+		for (std::size_t i{ 0u }; i < checks.size(); ++i)
+		{
+			const Bytes result{ checks[i].run() };
+			if ((result.size() == expected[i].size()) && (result.empty() || (std::memcmp(result.data(), expected[i].data(), result.size()) == 0)))
+				continue;
+			std::printf("%s: %s differs from scalar\n", getName(instructionSet), checks[i].name.c_str());
+			++numberOfSetFailures;
+		}
+		std::printf("%s: %zu of %zu checks bit-exact\n", getName(instructionSet), checks.size() - numberOfSetFailures, checks.size());
+		numberOfFailures += numberOfSetFailures;
+	}
+	return (numberOfFailures == 0u) ? 0 : 1;
+}